@@ -37,6 +37,7 @@ ENGINE_CORE_SOURCES = \
 	$(ENGINE_SRC_DIR)/Navigation/TaskProjection.cpp \
 	$(ENGINE_SRC_DIR)/Navigation/ConvexHull/GrahamScan.cpp \
 	$(ENGINE_SRC_DIR)/Navigation/ConvexHull/PolygonInterior.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/ConvexHull/PolygonSlabs.cpp \
 	$(ENGINE_SRC_DIR)/Navigation/Memento/DistanceMemento.cpp \
 	$(ENGINE_SRC_DIR)/Navigation/Memento/GeoVectorMemento.cpp \
 	$(ENGINE_SRC_DIR)/Navigation/Geometry/GeoVector.cpp \
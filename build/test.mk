@@ -64,23 +64,30 @@ TEST_NAMES = \
 	test_pressure \
 	test_task \
 	TestOverwritingRingBuffer \
+	TestTripleBuffer \
 	TestDateTime \
 	TestMathTables \
+	TestRasterBuffer \
 	TestAngle TestUnits TestEarth TestSunEphemeris \
 	TestValidity TestUTM TestProfile \
 	TestRadixTree TestGeoBounds TestGeoClip \
 	TestLogger TestDriver TestClimbAvCalc \
-	TestWaypointReader TestThermalBase \
+	TestWaypointReader TestWaypointCache TestThermalBase \
 	test_load_task TestFlarmNet \
 	TestColorRamp TestGeoPoint TestDiffFilter \
-	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
+	TestFileUtil TestPolars TestCSVLine TestNMEAChecksum TestNMEASentence TestMD5 TestNMEACapture TestNMEACaptureWriter TestJobGraph TestWorkerThread TestTimeWarpFeeder TestIGCFileWriter TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
+	TestFlatRTree \
+	TestShapeIndex \
+	TestPolygonSlabs \
 	TestMacCready TestOrderedTask \
 	TestPlanes \
 	TestTaskPoint \
 	TestTaskWaypoint \
 	TestZeroFinder \
 	TestAirspaceParser \
+	TestAirspaceCache \
+	TestBinaryCache \
 	TestMETARParser \
 	TestIGCParser \
 	TestByteOrder \
@@ -102,6 +109,12 @@ TEST_OVERWRITING_RING_BUFFER_SOURCES = \
 TEST_OVERWRITING_RING_BUFFER_DEPENDS = MATH
 $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFER))
 
+TEST_TRIPLE_BUFFER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTripleBuffer.cpp
+TEST_TRIPLE_BUFFER_DEPENDS = MATH
+$(eval $(call link-program,TestTripleBuffer,TEST_TRIPLE_BUFFER))
+
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/Replay/IGCParser.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -145,6 +158,28 @@ TEST_AIRSPACE_PARSER_LDADD = $(FAKE_LIBS)
 TEST_AIRSPACE_PARSER_DEPENDS = ENGINE IO ZZIP MATH UTIL
 $(eval $(call link-program,TestAirspaceParser,TEST_AIRSPACE_PARSER))
 
+TEST_AIRSPACE_CACHE_SOURCES = \
+	$(SRC)/Airspace/AirspaceCache.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/FakeDialogs.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAirspaceCache.cpp
+TEST_AIRSPACE_CACHE_LDADD = $(FAKE_LIBS)
+TEST_AIRSPACE_CACHE_DEPENDS = ENGINE IO ZZIP MATH UTIL
+$(eval $(call link-program,TestAirspaceCache,TEST_AIRSPACE_CACHE))
+
+TEST_BINARY_CACHE_SOURCES = \
+	$(SRC)/IO/BinaryCache.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestBinaryCache.cpp
+$(eval $(call link-program,TestBinaryCache,TEST_BINARY_CACHE))
+
 TEST_DATE_TIME_SOURCES = \
 	$(SRC)/DateTime.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -229,6 +264,7 @@ TEST_TROUTE_SOURCES = \
 	$(SRC)/Terrain/RasterProjection.cpp \
 	$(SRC)/Geo/GeoClip.cpp \
 	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/FileMapping.cpp \
 	$(SRC)/OS/PathName.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(TEST_SRC_DIR)/test_troute.cpp
@@ -244,6 +280,7 @@ TEST_REACH_SOURCES = \
 	$(SRC)/Terrain/RasterProjection.cpp \
 	$(SRC)/Geo/GeoClip.cpp \
 	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/FileMapping.cpp \
 	$(SRC)/OS/PathName.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(TEST_SRC_DIR)/test_reach.cpp
@@ -260,6 +297,7 @@ TEST_ROUTE_SOURCES = \
 	$(SRC)/Terrain/RasterProjection.cpp \
 	$(SRC)/Geo/GeoClip.cpp \
 	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/FileMapping.cpp \
 	$(SRC)/OS/PathName.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
@@ -281,6 +319,13 @@ TEST_MATH_TABLES_SOURCES = \
 TEST_MATH_TABLES_DEPENDS = MATH
 $(eval $(call link-program,TestMathTables,TEST_MATH_TABLES))
 
+TEST_RASTER_BUFFER_SOURCES = \
+	$(SRC)/Terrain/RasterBuffer.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestRasterBuffer.cpp
+TEST_RASTER_BUFFER_DEPENDS = MATH
+$(eval $(call link-program,TestRasterBuffer,TEST_RASTER_BUFFER))
+
 TEST_LOAD_TASK_SOURCES = \
 	$(SRC)/XML/xmlParser.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
@@ -302,6 +347,82 @@ TEST_CSV_LINE_SOURCES = \
 TEST_CSV_LINE_DEPENDS = MATH
 $(eval $(call link-program,TestCSVLine,TEST_CSV_LINE))
 
+TEST_NMEA_CHECKSUM_SOURCES = \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestNMEAChecksum.cpp
+TEST_NMEA_CHECKSUM_DEPENDS = MATH
+$(eval $(call link-program,TestNMEAChecksum,TEST_NMEA_CHECKSUM))
+
+TEST_NMEA_SENTENCE_SOURCES = \
+	$(SRC)/IO/CSVLine.cpp \
+	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Sentence.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestNMEASentence.cpp
+TEST_NMEA_SENTENCE_DEPENDS = MATH
+$(eval $(call link-program,TestNMEASentence,TEST_NMEA_SENTENCE))
+
+TEST_MD5_SOURCES = \
+	$(SRC)/Logger/MD5.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestMD5.cpp
+TEST_MD5_DEPENDS = MATH
+$(eval $(call link-program,TestMD5,TEST_MD5))
+
+TEST_NMEA_CAPTURE_SOURCES = \
+	$(SRC)/Logger/NMEACapture.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestNMEACapture.cpp
+TEST_NMEA_CAPTURE_DEPENDS = MATH
+$(eval $(call link-program,TestNMEACapture,TEST_NMEA_CAPTURE))
+
+TEST_NMEA_CAPTURE_WRITER_SOURCES = \
+	$(SRC)/Logger/NMEACaptureWriter.cpp \
+	$(SRC)/Logger/NMEACapture.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Thread/StandbyThread.cpp \
+	$(SRC)/Thread/Mutex.cpp \
+	$(SRC)/OS/Clock.cpp \
+	$(SRC)/OS/FileUtil.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestNMEACaptureWriter.cpp
+TEST_NMEA_CAPTURE_WRITER_DEPENDS = IO MATH
+$(eval $(call link-program,TestNMEACaptureWriter,TEST_NMEA_CAPTURE_WRITER))
+
+TEST_JOB_GRAPH_SOURCES = \
+	$(SRC)/Thread/JobGraph.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Thread/Mutex.cpp \
+	$(SRC)/Thread/Debug.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/OS/Clock.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestJobGraph.cpp
+TEST_JOB_GRAPH_DEPENDS = UTIL
+$(eval $(call link-program,TestJobGraph,TEST_JOB_GRAPH))
+
+TEST_WORKER_THREAD_SOURCES = \
+	$(SRC)/Thread/WorkerThread.cpp \
+	$(SRC)/Thread/SuspensibleThread.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Thread/Mutex.cpp \
+	$(SRC)/Thread/Debug.cpp \
+	$(SRC)/OS/Clock.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWorkerThread.cpp
+TEST_WORKER_THREAD_DEPENDS = UTIL
+$(eval $(call link-program,TestWorkerThread,TEST_WORKER_THREAD))
+
+TEST_TIME_WARP_FEEDER_SOURCES = \
+	$(SRC)/Replay/TimeWarpFeeder.cpp \
+	$(SRC)/OS/Clock.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTimeWarpFeeder.cpp
+TEST_TIME_WARP_FEEDER_DEPENDS = UTIL
+$(eval $(call link-program,TestTimeWarpFeeder,TEST_TIME_WARP_FEEDER))
+
 TEST_GEO_BOUNDS_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoBounds.cpp
@@ -486,6 +607,33 @@ TEST_FLAT_LINE_SOURCES = \
 TEST_FLAT_LINE_DEPENDS = MATH
 $(eval $(call link-program,TestFlatLine,TEST_FLAT_LINE))
 
+TEST_FLAT_RTREE_SOURCES = \
+	$(ENGINE_SRC_DIR)/Navigation/Flat/FlatGeoPoint.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/Flat/FlatBoundingBox.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlatRTree.cpp
+TEST_FLAT_RTREE_DEPENDS = MATH
+$(eval $(call link-program,TestFlatRTree,TEST_FLAT_RTREE))
+
+TEST_SHAPE_INDEX_SOURCES = \
+	$(SRC)/Topography/ShapeIndex.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestShapeIndex.cpp
+$(eval $(call link-program,TestShapeIndex,TEST_SHAPE_INDEX))
+
+TEST_POLYGON_SLABS_SOURCES = \
+	$(ENGINE_SRC_DIR)/Math/Earth.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/GeoPoint.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/SearchPoint.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/Flat/FlatGeoPoint.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/TaskProjection.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/ConvexHull/PolygonInterior.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/ConvexHull/PolygonSlabs.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestPolygonSlabs.cpp
+TEST_POLYGON_SLABS_DEPENDS = MATH
+$(eval $(call link-program,TestPolygonSlabs,TEST_POLYGON_SLABS))
+
 TEST_THERMALBASE_SOURCES = \
 	$(SRC)/Computer/ThermalBase.cpp \
 	$(SRC)/Poco/RWLock.cpp \
@@ -538,6 +686,11 @@ $(eval $(call link-program,TestRadixTree,TEST_RADIX_TREE))
 
 TEST_LOGGER_SOURCES = \
 	$(SRC)/Logger/IGCWriter.cpp \
+	$(SRC)/Logger/IGCFileWriter.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Thread/StandbyThread.cpp \
+	$(SRC)/Thread/Mutex.cpp \
+	$(SRC)/OS/Clock.cpp \
 	$(SRC)/Logger/LoggerFRecord.cpp \
 	$(SRC)/Logger/LoggerGRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
@@ -553,6 +706,22 @@ TEST_LOGGER_SOURCES = \
 TEST_LOGGER_DEPENDS = IO MATH
 $(eval $(call link-program,TestLogger,TEST_LOGGER))
 
+TEST_IGC_FILE_WRITER_SOURCES = \
+	$(SRC)/Logger/IGCFileWriter.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Thread/StandbyThread.cpp \
+	$(SRC)/Thread/Mutex.cpp \
+	$(SRC)/OS/Clock.cpp \
+	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/Logger/LoggerGRecord.cpp \
+	$(SRC)/Logger/MD5.cpp \
+	$(SRC)/Version.cpp \
+	$(SRC)/Util/UTF8.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestIGCFileWriter.cpp
+TEST_IGC_FILE_WRITER_DEPENDS = IO MATH
+$(eval $(call link-program,TestIGCFileWriter,TEST_IGC_FILE_WRITER))
+
 TEST_DRIVER_SOURCES = \
 	$(SRC)/Thread/Mutex.cpp \
 	$(SRC)/Device/Port/NullPort.cpp \
@@ -568,6 +737,7 @@ TEST_DRIVER_SOURCES = \
 	$(SRC)/NMEA/Acceleration.cpp \
 	$(SRC)/NMEA/ExternalSettings.cpp \
 	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Sentence.cpp \
 	$(SRC)/NMEA/Checksum.cpp \
 	$(SRC)/FLARM/State.cpp \
 	$(SRC)/Units/Descriptor.cpp \
@@ -625,9 +795,43 @@ TEST_WAY_POINT_FILE_SOURCES = \
 TEST_WAY_POINT_FILE_DEPENDS = MATH IO UTIL ZZIP
 $(eval $(call link-program,TestWaypointReader,TEST_WAY_POINT_FILE))
 
+TEST_WAYPOINT_CACHE_SOURCES = \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/PathName.cpp \
+	$(SRC)/Poco/RWLock.cpp \
+	$(SRC)/Thread/Debug.cpp \
+	$(SRC)/Thread/Mutex.cpp \
+	$(SRC)/Geo/UTM.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReader.cpp \
+	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/WaypointReaderZander.cpp \
+	$(SRC)/Waypoint/WaypointReaderFS.cpp \
+	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
+	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/WaypointWriter.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(ENGINE_SRC_DIR)/Math/Earth.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/GeoPoint.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/TaskProjection.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/Flat/FlatGeoPoint.cpp \
+	$(ENGINE_SRC_DIR)/Waypoint/Waypoint.cpp \
+	$(ENGINE_SRC_DIR)/Waypoint/Waypoints.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWaypointCache.cpp
+TEST_WAYPOINT_CACHE_DEPENDS = MATH IO UTIL ZZIP
+$(eval $(call link-program,TestWaypointCache,TEST_WAYPOINT_CACHE))
+
 TEST_TRACE_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(SRC)/Replay/IGCParser.cpp \
+	$(SRC)/OS/Clock.cpp \
 	$(TEST_SRC_DIR)/FakeTerrain.cpp \
 	$(TEST_SRC_DIR)/Printing.cpp \
 	$(TEST_SRC_DIR)/TestTrace.cpp 
@@ -657,7 +861,10 @@ DEBUG_PROGRAM_NAMES = \
 	FlightTable \
 	RunTrace \
 	RunOLCAnalysis \
+	RunBatchAnalysis \
+	LatencyReport \
 	BenchmarkProjection \
+	BenchmarkNMEAParser \
 	DumpTextFile DumpTextZip WriteTextFile RunTextWriter \
 	RunXMLParser \
 	ReadMO \
@@ -666,7 +873,7 @@ DEBUG_PROGRAM_NAMES = \
 	ReadGRecord VerifyGRecord AppendGRecord \
 	AddChecksum \
 	KeyCodeDumper \
-	LoadTopography LoadTerrain \
+	LoadTopography LoadTerrain GenerateRawTerrain \
 	RunHeightMatrix \
 	RunInputParser \
 	RunWaypointParser RunAirspaceParser \
@@ -738,6 +945,7 @@ DEBUG_REPLAY_SOURCES = \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceWarningConfig.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Sentence.cpp \
 	$(SRC)/NMEA/Info.cpp \
 	$(SRC)/NMEA/MoreData.cpp \
 	$(SRC)/NMEA/Attitude.cpp \
@@ -973,10 +1181,14 @@ $(eval $(call link-program,KeyCodeDumper,KEY_CODE_DUMPER))
 LOAD_TOPOGRAPHY_SOURCES = \
 	$(SRC)/Topography/TopographyStore.cpp \
 	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/ShapeIndex.cpp \
 	$(SRC)/Topography/XShape.cpp \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Projection/WindowProjection.cpp \
 	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/PathName.cpp \
+	$(SRC)/Poco/RWLock.cpp \
 	$(TEST_SRC_DIR)/LoadTopography.cpp
 LOAD_TOPOGRAPHY_DEPENDS = MATH IO UTIL SHAPELIB ZZIP
 LOAD_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
@@ -988,6 +1200,7 @@ LOAD_TERRAIN_SOURCES = \
 	$(SRC)/Terrain/RasterBuffer.cpp \
 	$(SRC)/Terrain/RasterProjection.cpp \
 	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/FileMapping.cpp \
 	$(SRC)/OS/PathName.cpp \
 	$(SRC)/Engine/Math/Earth.cpp \
 	$(SRC)/Engine/Navigation/GeoPoint.cpp \
@@ -998,6 +1211,23 @@ LOAD_TERRAIN_CPPFLAGS = $(SCREEN_CPPFLAGS)
 LOAD_TERRAIN_DEPENDS = MATH IO JASPER ZZIP
 $(eval $(call link-program,LoadTerrain,LOAD_TERRAIN))
 
+GENERATE_RAW_TERRAIN_SOURCES = \
+	$(SRC)/Terrain/RasterTile.cpp \
+	$(SRC)/Terrain/RasterTileCache.cpp \
+	$(SRC)/Terrain/RasterBuffer.cpp \
+	$(SRC)/Terrain/RasterProjection.cpp \
+	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/FileMapping.cpp \
+	$(SRC)/OS/PathName.cpp \
+	$(SRC)/Engine/Math/Earth.cpp \
+	$(SRC)/Engine/Navigation/GeoPoint.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/Util/UTF8.cpp \
+	$(TEST_SRC_DIR)/GenerateRawTerrain.cpp
+GENERATE_RAW_TERRAIN_CPPFLAGS = $(SCREEN_CPPFLAGS)
+GENERATE_RAW_TERRAIN_DEPENDS = MATH IO JASPER ZZIP
+$(eval $(call link-program,GenerateRawTerrain,GENERATE_RAW_TERRAIN))
+
 RUN_HEIGHT_MATRIX_SOURCES = \
 	$(SRC)/Terrain/RasterTile.cpp \
 	$(SRC)/Terrain/RasterTileCache.cpp \
@@ -1006,10 +1236,17 @@ RUN_HEIGHT_MATRIX_SOURCES = \
 	$(SRC)/Terrain/RasterMap.cpp \
 	$(SRC)/Terrain/HeightMatrix.cpp \
 	$(SRC)/Geo/GeoClip.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Thread/StandbyThread.cpp \
+	$(SRC)/Thread/ThreadPool.cpp \
+	$(SRC)/Thread/Debug.cpp \
+	$(SRC)/Thread/Mutex.cpp \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Projection/WindowProjection.cpp \
 	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/FileMapping.cpp \
 	$(SRC)/OS/PathName.cpp \
+	$(SRC)/OS/Clock.cpp \
 	$(SRC)/Engine/Math/Earth.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(SRC)/Util/UTF8.cpp \
@@ -1125,6 +1362,7 @@ RUN_DEVICE_DRIVER_SOURCES = \
 	$(SRC)/NMEA/Attitude.cpp \
 	$(SRC)/NMEA/ExternalSettings.cpp \
 	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Sentence.cpp \
 	$(SRC)/NMEA/Checksum.cpp \
 	$(SRC)/Replay/IGCParser.cpp \
 	$(SRC)/FLARM/FlarmCalculations.cpp \
@@ -1142,6 +1380,43 @@ RUN_DEVICE_DRIVER_SOURCES = \
 RUN_DEVICE_DRIVER_DEPENDS = DRIVER MATH UTIL IO
 $(eval $(call link-program,RunDeviceDriver,RUN_DEVICE_DRIVER))
 
+BENCHMARK_NMEA_PARSER_SOURCES = \
+	$(SRC)/Thread/Mutex.cpp \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Device/Port/Port.cpp \
+	$(SRC)/Device/Port/NullPort.cpp \
+	$(SRC)/Device/Port/LineHandler.cpp \
+	$(SRC)/Device/Driver.cpp \
+	$(SRC)/Device/Register.cpp \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/Device/Internal.cpp \
+	$(SRC)/FLARM/State.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Sentence.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(SRC)/Replay/IGCParser.cpp \
+	$(SRC)/FLARM/FlarmCalculations.cpp \
+	$(SRC)/ClimbAverageCalculator.cpp \
+	$(SRC)/OS/Clock.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/Operation/ProxyOperationEnvironment.cpp \
+	$(SRC)/Operation/NoCancelOperationEnvironment.cpp \
+	$(ENGINE_SRC_DIR)/Math/Earth.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/FakeMessage.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/FakeVega.cpp \
+	$(TEST_SRC_DIR)/BenchmarkNMEAParser.cpp
+BENCHMARK_NMEA_PARSER_DEPENDS = DRIVER MATH UTIL IO
+$(eval $(call link-program,BenchmarkNMEAParser,BENCHMARK_NMEA_PARSER))
+
 RUN_DECLARE_SOURCES = \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
@@ -1150,6 +1425,7 @@ RUN_DECLARE_SOURCES = \
 	$(SRC)/Device/Internal.cpp \
 	$(SRC)/Device/Declaration.cpp \
 	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Sentence.cpp \
 	$(SRC)/NMEA/Checksum.cpp \
 	$(SRC)/NMEA/ExternalSettings.cpp \
 	$(SRC)/Replay/IGCParser.cpp \
@@ -1176,6 +1452,8 @@ RUN_VEGA_SETTINGS_SOURCES = \
 	$(SRC)/Device/Driver.cpp \
 	$(SRC)/Device/Internal.cpp \
 	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Sentence.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
 	$(SRC)/NMEA/ExternalSettings.cpp \
 	$(SRC)/OS/Clock.cpp \
 	$(SRC)/Thread/Thread.cpp \
@@ -1208,6 +1486,7 @@ RUN_FLIGHT_LIST_SOURCES = \
 	$(SRC)/Device/Internal.cpp \
 	$(SRC)/Device/Declaration.cpp \
 	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Sentence.cpp \
 	$(SRC)/NMEA/Checksum.cpp \
 	$(SRC)/NMEA/ExternalSettings.cpp \
 	$(SRC)/Replay/IGCParser.cpp \
@@ -1236,6 +1515,7 @@ RUN_DOWNLOAD_FLIGHT_SOURCES = \
 	$(SRC)/Device/Internal.cpp \
 	$(SRC)/Device/Declaration.cpp \
 	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Sentence.cpp \
 	$(SRC)/NMEA/Checksum.cpp \
 	$(SRC)/NMEA/ExternalSettings.cpp \
 	$(SRC)/Replay/IGCParser.cpp \
@@ -1261,6 +1541,7 @@ CAI302_TOOL_SOURCES = \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
 	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Sentence.cpp \
 	$(SRC)/NMEA/Checksum.cpp \
 	$(SRC)/NMEA/ExternalSettings.cpp \
 	$(SRC)/Device/Driver.cpp \
@@ -1295,10 +1576,13 @@ RUN_IGC_WRITER_SOURCES = \
 	$(SRC)/FLARM/FlarmCalculations.cpp \
 	$(SRC)/ClimbAverageCalculator.cpp \
 	$(SRC)/Logger/IGCWriter.cpp \
+	$(SRC)/Logger/IGCFileWriter.cpp \
 	$(SRC)/Logger/LoggerFRecord.cpp \
 	$(SRC)/Logger/LoggerGRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
 	$(SRC)/Logger/MD5.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Thread/StandbyThread.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(SRC)/NMEA/FlyingState.cpp \
 	$(TEST_SRC_DIR)/RunIGCWriter.cpp
@@ -1371,6 +1655,7 @@ RUN_OLC_SOURCES = \
 	$(ENGINE_SRC_DIR)/Navigation/SearchPointVector.cpp \
 	$(ENGINE_SRC_DIR)/Navigation/Flat/FlatGeoPoint.cpp \
 	$(ENGINE_SRC_DIR)/Navigation/Flat/FlatRay.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/Flat/FlatBoundingBox.cpp \
 	$(ENGINE_SRC_DIR)/Navigation/TaskProjection.cpp \
 	$(ENGINE_SRC_DIR)/Navigation/ConvexHull/GrahamScan.cpp \
 	$(ENGINE_SRC_DIR)/Navigation/ConvexHull/PolygonInterior.cpp \
@@ -1397,6 +1682,51 @@ RUN_OLC_LDADD = $(DEBUG_REPLAY_LDADD)
 RUN_OLC_DEPENDS = UTIL MATH
 $(eval $(call link-program,RunOLCAnalysis,RUN_OLC))
 
+RUN_BATCH_ANALYSIS_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Replay/IGCParser.cpp \
+	$(SRC)/OS/FileMapping.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Thread/StandbyThread.cpp \
+	$(SRC)/Thread/ThreadPool.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/NMEA/FlyingState.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/SearchPoint.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/SearchPointVector.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/Flat/FlatGeoPoint.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/Flat/FlatRay.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/Flat/FlatBoundingBox.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/TaskProjection.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/ConvexHull/GrahamScan.cpp \
+	$(ENGINE_SRC_DIR)/Navigation/ConvexHull/PolygonInterior.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Point.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Trace.cpp \
+	$(ENGINE_SRC_DIR)/Contest/ContestManager.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/Contests.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/AbstractContest.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/ContestDijkstra.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/OLCLeague.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/OLCSprint.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/OLCClassic.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/OLCTriangle.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/OLCFAI.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/OLCPlus.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/XContestFree.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/XContestTriangle.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/OLCSISAT.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/RunBatchAnalysis.cpp
+RUN_BATCH_ANALYSIS_LDADD = $(DEBUG_REPLAY_LDADD)
+RUN_BATCH_ANALYSIS_DEPENDS = UTIL MATH
+$(eval $(call link-program,RunBatchAnalysis,RUN_BATCH_ANALYSIS))
+
+LATENCY_REPORT_SOURCES = \
+	$(SRC)/LatencyTrace.cpp \
+	$(SRC)/OS/Clock.cpp \
+	$(TEST_SRC_DIR)/LatencyReport.cpp
+LATENCY_REPORT_DEPENDS = IO UTIL
+$(eval $(call link-program,LatencyReport,LATENCY_REPORT))
+
 RUN_CANVAS_SOURCES = \
 	$(SRC)/Hardware/Display.cpp \
 	$(SRC)/Screen/Layout.cpp \
@@ -1438,6 +1768,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Renderer/BackgroundRenderer.cpp \
 	$(SRC)/LocalPath.cpp \
 	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/FileMapping.cpp \
 	$(SRC)/OS/PathName.cpp \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Projection/WindowProjection.cpp \
@@ -1482,6 +1813,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Terrain/RasterTileCache.cpp \
 	$(SRC)/Terrain/RasterMap.cpp \
 	$(SRC)/Terrain/RasterTerrain.cpp \
+	$(SRC)/Terrain/TerrainLoader.cpp \
 	$(SRC)/Terrain/RasterWeather.cpp \
 	$(SRC)/Terrain/HeightMatrix.cpp \
 	$(SRC)/Terrain/RasterRenderer.cpp \
@@ -1516,11 +1848,16 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Task/ProtectedTaskManager.cpp \
 	$(SRC)/Task/ProtectedRoutePlanner.cpp \
 	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Thread/StandbyThread.cpp \
+	$(SRC)/Thread/ThreadPool.cpp \
 	$(SRC)/Thread/Debug.cpp \
 	$(SRC)/Thread/Mutex.cpp \
 	$(SRC)/Thread/Notify.cpp \
 	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/ShapeIndex.cpp \
 	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyLoader.cpp \
 	$(SRC)/Topography/TopographyFileRenderer.cpp \
 	$(SRC)/Topography/TopographyRenderer.cpp \
 	$(SRC)/Topography/TopographyGlue.cpp \
@@ -1536,6 +1873,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Profile/Earth.cpp \
 	$(SRC)/Geo/UTM.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
@@ -1829,6 +2167,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/FLARM/State.cpp \
 	$(SRC)/OS/PathName.cpp \
 	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/FileMapping.cpp \
 	$(SRC)/OS/Clock.cpp \
 	$(SRC)/GestureManager.cpp \
 	$(SRC)/Task/ProtectedTaskManager.cpp \
@@ -1889,6 +2228,9 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Look/TrailLook.cpp \
 	$(SRC)/Look/FinalGlideBarLook.cpp \
 	$(SRC)/Gauge/FlarmTrafficLook.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Thread/StandbyThread.cpp \
+	$(SRC)/Thread/ThreadPool.cpp \
 	$(SRC)/Thread/Debug.cpp \
 	$(SRC)/Thread/Mutex.cpp \
 	$(SRC)/Thread/Notify.cpp \
@@ -1954,6 +2296,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Airspace/AirspaceGlue.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
@@ -1969,6 +2312,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Device/Internal.cpp \
 	$(SRC)/Device/Parser.cpp \
 	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Sentence.cpp \
 	$(SRC)/NMEA/Checksum.cpp \
 	$(SRC)/FLARM/FlarmId.cpp \
 	$(SRC)/FLARM/Traffic.cpp \
@@ -2075,6 +2419,7 @@ RUN_TASK_EDITOR_DIALOG_SOURCES = \
 	$(SRC)/Formatter/Units.cpp \
 	$(SRC)/Geo/UTM.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
@@ -2111,7 +2456,9 @@ TEST_NOTIFY_DEPENDS = SCREEN TEST1
 $(eval $(call link-program,TestNotify,TEST_NOTIFY))
 
 FEED_NMEA_SOURCES = \
+	$(SRC)/Logger/NMEACapture.cpp \
 	$(TEST_SRC_DIR)/FeedNMEA.cpp
+FEED_NMEA_DEPENDS = IO
 $(eval $(call link-program,FeedNMEA,FEED_NMEA))
 
 FEED_VEGA_SOURCES = \
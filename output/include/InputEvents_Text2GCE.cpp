@@ -0,0 +1,28 @@
+_T("AIRSPACE_ENTER"),
+_T("AIRSPACE_LEAVE"),
+_T("COMMPORT_RESTART"),
+_T("FLARM_NOTRAFFIC"),
+_T("FLARM_TRAFFIC"),
+_T("FLARM_NEWTRAFFIC"),
+_T("FLIGHTMODE_CLIMB"),
+_T("FLIGHTMODE_CRUISE"),
+_T("FLIGHTMODE_FINALGLIDE"),
+_T("FLIGHTMODE_FINALGLIDE_TERRAIN"),
+_T("FLIGHTMODE_FINALGLIDE_ABOVE"),
+_T("FLIGHTMODE_FINALGLIDE_BELOW"),
+_T("GPS_CONNECTION_WAIT"),
+_T("GPS_FIX_WAIT"),
+_T("HEIGHT_MAX"),
+_T("LANDING"),
+_T("STARTUP_REAL"),
+_T("STARTUP_SIMULATOR"),
+_T("TAKEOFF"),
+_T("TASK_NEXTWAYPOINT"),
+_T("TASK_START"),
+_T("TASK_FINISH"),
+_T("TEAM_POS_REACHED"),
+_T("ARM_READY"),
+_T("POLAR_CHANGED"),
+_T("ALTERNATE_CHANGED"),
+_T("LANDABLE_UNREACHABLE"),
+_T("COUNT"),
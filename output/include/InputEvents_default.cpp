@@ -0,0 +1,461 @@
+static const TCHAR *const default_modes[] = {
+  _T("Nav1"),
+  _T("Nav2"),
+  _T("Display1"),
+  _T("Display2"),
+  _T("Config1"),
+  _T("Config2"),
+  _T("Config3"),
+  _T("Info1"),
+  _T("Info2"),
+  _T("Vario1"),
+  _T("Vario2"),
+  _T("Info3"),
+  _T("default.TA"),
+  _T("Display1.Traffic"),
+  _T("RemoteStick"),
+  NULL
+};
+static gcc_constexpr_data InputConfig::Event default_events[] = {
+  { InputEvents::eventBeep, _T("1"), 0 },
+  { InputEvents::eventTaskTransition, _T("start"), 1 },
+  { InputEvents::eventTaskTransition, _T("finish"), 1 },
+  { InputEvents::eventTaskTransition, _T("next"), 1 },
+  { InputEvents::eventTaskTransition, _T("ready"), 1 },
+  { InputEvents::eventAutoLogger, _T("start"), 0 },
+  { InputEvents::eventAddWaypoint, _T("takeoff"), 6 },
+  { InputEvents::eventStatusMessage, _T("Takeoff"), 7 },
+  { InputEvents::eventStatusMessage, _T("Landing"), 0 },
+  { InputEvents::eventAutoLogger, _T("stop"), 9 },
+  { InputEvents::eventStatusMessage, _T("Above final glide"), 0 },
+  { InputEvents::eventStatusMessage, _T("Below final glide"), 0 },
+  { InputEvents::eventStatusMessage, _T("Final glide through terrain"), 0 },
+  { InputEvents::eventMode, _T("default"), 0 },
+  { InputEvents::eventPan, _T("off"), 0 },
+  { InputEvents::eventPan, _T("down"), 0 },
+  { InputEvents::eventPan, _T("up"), 0 },
+  { InputEvents::eventPan, _T("left"), 0 },
+  { InputEvents::eventPan, _T("right"), 0 },
+  { InputEvents::eventZoom, _T("in"), 0 },
+  { InputEvents::eventZoom, _T("out"), 0 },
+  { InputEvents::eventNearestMapItems, _T("pan"), 0 },
+  { InputEvents::eventQuickMenu, _T(""), 0 },
+  { InputEvents::eventAnalysis, _T(""), 0 },
+  { InputEvents::eventMode, _T("default"), 24 },
+  { InputEvents::eventChecklist, _T(""), 0 },
+  { InputEvents::eventMode, _T("default"), 26 },
+  { InputEvents::eventFlarmTraffic, _T(""), 0 },
+  { InputEvents::eventMode, _T("default"), 28 },
+  { InputEvents::eventGotoLookup, _T(""), 0 },
+  { InputEvents::eventMode, _T("default"), 30 },
+  { InputEvents::eventSetup, _T("Alternates"), 0 },
+  { InputEvents::eventMode, _T("default"), 32 },
+  { InputEvents::eventSetup, _T("Task"), 0 },
+  { InputEvents::eventMode, _T("default"), 34 },
+  { InputEvents::eventSetup, _T("Basic"), 0 },
+  { InputEvents::eventMode, _T("default"), 36 },
+  { InputEvents::eventMode, _T("Menu"), 0 },
+  { InputEvents::eventMode, _T("Nav1"), 0 },
+  { InputEvents::eventMode, _T("Display1"), 0 },
+  { InputEvents::eventMode, _T("Config1"), 0 },
+  { InputEvents::eventMode, _T("Info1"), 0 },
+  { InputEvents::eventFLARMRadar, _T("toggle"), 0 },
+  { InputEvents::eventClearAirspaceWarnings, _T(""), 43 },
+  { InputEvents::eventClearStatusMessages, _T(""), 44 },
+  { InputEvents::eventScreenModes, _T("previous"), 0 },
+  { InputEvents::eventScreenModes, _T("next"), 0 },
+  { InputEvents::eventWaypointDetails, _T("select"), 0 },
+  { InputEvents::eventCalculator, _T(""), 0 },
+  { InputEvents::eventPan, _T("on"), 0 },
+  { InputEvents::eventStatus, _T("all"), 0 },
+  { InputEvents::eventSetup, _T("Target"), 0 },
+  { InputEvents::eventMode, _T("Nav2"), 0 },
+  { InputEvents::eventMode, _T("default"), 49 },
+  { InputEvents::eventAdjustWaypoint, _T("previousarm"), 0 },
+  { InputEvents::eventAdjustWaypoint, _T("nextarm"), 0 },
+  { InputEvents::eventMode, _T("default"), 48 },
+  { InputEvents::eventAbortTask, _T("toggle"), 14 },
+  { InputEvents::eventMode, _T("default"), 52 },
+  { InputEvents::eventWaypointDetails, _T("current"), 0 },
+  { InputEvents::eventMode, _T("default"), 60 },
+  { InputEvents::eventMode, _T("Display2"), 0 },
+  { InputEvents::eventZoom, _T("auto show"), 0 },
+  { InputEvents::eventZoom, _T("auto toggle"), 63 },
+  { InputEvents::eventStatusMessage, _T("Dropped marker"), 14 },
+  { InputEvents::eventLogger, _T("note Mark"), 65 },
+  { InputEvents::eventMarkLocation, _T(""), 66 },
+  { InputEvents::eventDeclutterLabels, _T("show"), 0 },
+  { InputEvents::eventDeclutterLabels, _T("toggle"), 68 },
+  { InputEvents::eventSnailTrail, _T("show"), 0 },
+  { InputEvents::eventSnailTrail, _T("toggle"), 70 },
+  { InputEvents::eventTerrainTopography, _T("terrain toggle"), 0 },
+  { InputEvents::eventTerrainTopography, _T("topography toggle"), 0 },
+  { InputEvents::eventScreenModes, _T("cycle"), 0 },
+  { InputEvents::eventMode, _T("Config2"), 0 },
+  { InputEvents::eventMacCready, _T("up"), 0 },
+  { InputEvents::eventMacCready, _T("down"), 0 },
+  { InputEvents::eventMacCready, _T("auto show"), 0 },
+  { InputEvents::eventMacCready, _T("auto toggle"), 78 },
+  { InputEvents::eventSetup, _T("Wind"), 0 },
+  { InputEvents::eventMode, _T("default"), 80 },
+  { InputEvents::eventMode, _T("Config3"), 0 },
+  { InputEvents::eventMode, _T("Vario1"), 0 },
+  { InputEvents::eventSetup, _T("System"), 0 },
+  { InputEvents::eventMode, _T("default"), 84 },
+  { InputEvents::eventSetup, _T("Airspace"), 0 },
+  { InputEvents::eventMode, _T("default"), 86 },
+  { InputEvents::eventLogger, _T("show"), 0 },
+  { InputEvents::eventLogger, _T("toggle ask"), 88 },
+  { InputEvents::eventSetup, _T("Replay"), 0 },
+  { InputEvents::eventMode, _T("default"), 90 },
+  { InputEvents::eventLogger, _T("nmea"), 0 },
+  { InputEvents::eventDevice, _T("list"), 0 },
+  { InputEvents::eventMode, _T("default"), 93 },
+  { InputEvents::eventSetup, _T("Plane"), 0 },
+  { InputEvents::eventMode, _T("default"), 95 },
+  { InputEvents::eventMode, _T("Vario2"), 0 },
+  { InputEvents::eventSetup, _T("Switches"), 0 },
+  { InputEvents::eventMode, _T("default"), 98 },
+  { InputEvents::eventSetup, _T("Voice"), 0 },
+  { InputEvents::eventAdjustVarioFilter, _T("xdemo"), 0 },
+  { InputEvents::eventAdjustVarioFilter, _T("zero"), 0 },
+  { InputEvents::eventAdjustVarioFilter, _T("accel"), 0 },
+  { InputEvents::eventStatusMessage, _T("Vario ASI zeroed"), 102 },
+  { InputEvents::eventStatusMessage, _T("Accelerometer leveled"), 0 },
+  { InputEvents::eventAdjustVarioFilter, _T("save"), 0 },
+  { InputEvents::eventStatusMessage, _T("Stored to EEPROM"), 106 },
+  { InputEvents::eventAdjustVarioFilter, _T("demostf"), 0 },
+  { InputEvents::eventAdjustVarioFilter, _T("democlimb"), 0 },
+  { InputEvents::eventMode, _T("Info2"), 0 },
+  { InputEvents::eventWeather, _T("list"), 0 },
+  { InputEvents::eventMode, _T("default"), 111 },
+  { InputEvents::eventNearestMapItems, _T("aircraft"), 0 },
+  { InputEvents::eventMode, _T("default"), 113 },
+  { InputEvents::eventMode, _T("Info3"), 0 },
+  { InputEvents::eventMode, _T("default"), 51 },
+  { InputEvents::eventSetup, _T("Weather"), 0 },
+  { InputEvents::eventMode, _T("default"), 117 },
+  { InputEvents::eventSetup, _T("Teamcode"), 0 },
+  { InputEvents::eventMode, _T("default"), 119 },
+  { InputEvents::eventFlarmDetails, _T(""), 0 },
+  { InputEvents::eventMode, _T("default"), 121 },
+  { InputEvents::eventThermalAssistant, _T(""), 0 },
+  { InputEvents::eventMode, _T("default"), 123 },
+  { InputEvents::eventCredits, _T(""), 0 },
+  { InputEvents::eventMode, _T("default"), 125 },
+  { InputEvents::eventRepeatStatusMessage, _T(""), 0 },
+  { InputEvents::eventExit, _T("system"), 0 },
+  { InputEvents::eventMode, _T("default"), 128 },
+  { InputEvents::eventMap, _T("show"), 0 },
+  { InputEvents::eventTraffic, _T("zoom in"), 0 },
+  { InputEvents::eventTraffic, _T("zoom out"), 0 },
+  { InputEvents::eventTraffic, _T("zoom auto toggle"), 0 },
+  { InputEvents::eventTraffic, _T("northup toggle"), 0 },
+  { InputEvents::eventNearestAirspaceDetails, _T(""), 0 },
+  { InputEvents::eventMode, _T("default"), 135 },
+};
+static gcc_constexpr_data struct flat_event_map default_key2event[] = {
+  { 4, VK_ESCAPE, 14 },
+  { 5, VK_ESCAPE, 14 },
+  { 6, VK_ESCAPE, 14 },
+  { 7, VK_ESCAPE, 14 },
+  { 8, VK_ESCAPE, 14 },
+  { 9, VK_ESCAPE, 14 },
+  { 10, VK_ESCAPE, 14 },
+  { 11, VK_ESCAPE, 14 },
+  { 12, VK_ESCAPE, 14 },
+  { 3, VK_ESCAPE, 14 },
+  { 13, VK_ESCAPE, 14 },
+  { 14, VK_ESCAPE, 14 },
+  { 1, VK_ESCAPE, 15 },
+  { 1, VK_DOWN, 16 },
+  { 1, VK_UP, 17 },
+  { 1, VK_LEFT, 18 },
+  { 1, VK_RIGHT, 19 },
+  { 1, VK_APP1, 15 },
+  { 1, VK_APP2, 20 },
+  { 1, VK_APP3, 21 },
+  { 1, VK_APP4, 22 },
+  { 0, VK_F1, 23 },
+  { 0, VK_F2, 25 },
+  { 0, VK_F3, 27 },
+  { 0, VK_F4, 29 },
+  { 0, VK_F5, 31 },
+  { 0, VK_F6, 33 },
+  { 0, VK_F7, 35 },
+  { 0, VK_F8, 37 },
+  { 0, VK_MENU, 38 },
+  { 0, VK_APP1, 39 },
+  { 0, VK_APP2, 40 },
+  { 0, VK_APP3, 41 },
+  { 0, VK_APP4, 42 },
+  { 0, VK_DOWN, 21 },
+  { 0, VK_UP, 20 },
+  { 0, VK_RETURN, 45 },
+  { 0, VK_LEFT, 46 },
+  { 0, VK_RIGHT, 47 },
+  { 0, (int)'6', 37 },
+  { 0, (int)'7', 49 },
+  { 0, (int)'9', 52 },
+  { 4, VK_APP1, 53 },
+  { 4, (int)'6', 54 },
+  { 4, (int)'7', 55 },
+  { 4, (int)'8', 56 },
+  { 4, (int)'9', 57 },
+  { 4, (int)'0', 33 },
+  { 5, VK_APP1, 14 },
+  { 5, (int)'6', 58 },
+  { 5, (int)'7', 31 },
+  { 5, (int)'8', 59 },
+  { 5, (int)'9', 61 },
+  { 6, VK_APP2, 62 },
+  { 6, (int)'6', 20 },
+  { 6, (int)'7', 21 },
+  { 6, (int)'8', 64 },
+  { 6, (int)'9', 67 },
+  { 6, (int)'0', 50 },
+  { 7, VK_APP2, 14 },
+  { 7, (int)'6', 69 },
+  { 7, (int)'7', 71 },
+  { 7, (int)'8', 72 },
+  { 7, (int)'9', 73 },
+  { 7, (int)'0', 74 },
+  { 8, VK_APP3, 75 },
+  { 8, (int)'6', 76 },
+  { 8, (int)'7', 77 },
+  { 8, (int)'8', 79 },
+  { 8, (int)'9', 37 },
+  { 8, (int)'0', 81 },
+  { 9, VK_APP3, 82 },
+  { 9, (int)'6', 83 },
+  { 9, (int)'7', 85 },
+  { 9, (int)'8', 87 },
+  { 9, (int)'9', 89 },
+  { 9, (int)'0', 91 },
+  { 10, VK_APP3, 14 },
+  { 10, (int)'6', 92 },
+  { 10, (int)'7', 94 },
+  { 10, (int)'8', 96 },
+  { 13, VK_APP3, 97 },
+  { 13, (int)'6', 99 },
+  { 13, (int)'7', 100 },
+  { 13, (int)'8', 101 },
+  { 13, (int)'9', 102 },
+  { 13, (int)'0', 103 },
+  { 14, VK_APP3, 14 },
+  { 14, (int)'6', 104 },
+  { 14, (int)'7', 105 },
+  { 14, (int)'8', 107 },
+  { 14, (int)'9', 108 },
+  { 14, (int)'0', 109 },
+  { 11, VK_APP4, 110 },
+  { 11, (int)'6', 29 },
+  { 11, (int)'7', 112 },
+  { 11, (int)'8', 114 },
+  { 11, (int)'9', 27 },
+  { 11, (int)'0', 25 },
+  { 12, VK_APP4, 115 },
+  { 12, (int)'6', 116 },
+  { 12, (int)'7', 118 },
+  { 12, (int)'8', 120 },
+  { 12, (int)'9', 122 },
+  { 12, (int)'0', 124 },
+  { 15, VK_APP4, 14 },
+  { 15, (int)'6', 126 },
+  { 15, (int)'0', 127 },
+  { 3, VK_APP1, 39 },
+  { 3, VK_APP2, 40 },
+  { 3, VK_APP3, 41 },
+  { 3, VK_APP4, 42 },
+  { 3, (int)'9', 14 },
+  { 3, (int)'0', 129 },
+  { 16, VK_ESCAPE, 130 },
+  { 16, VK_APP1, 130 },
+  { 17, (int)'6', 131 },
+  { 17, (int)'7', 132 },
+  { 17, (int)'8', 133 },
+  { 17, (int)'9', 134 },
+  { 18, (int)'0', 54 },
+  { 18, (int)'0', 55 },
+  { 18, (int)'0', 56 },
+  { 18, (int)'0', 57 },
+  { 18, (int)'0', 33 },
+  { 18, (int)'0', 58 },
+  { 18, (int)'0', 31 },
+  { 18, (int)'0', 59 },
+  { 18, (int)'0', 61 },
+  { 18, (int)'0', 64 },
+  { 18, (int)'0', 67 },
+  { 18, (int)'0', 50 },
+  { 18, (int)'0', 69 },
+  { 18, (int)'0', 71 },
+  { 18, (int)'0', 72 },
+  { 18, (int)'0', 73 },
+  { 18, (int)'0', 79 },
+  { 18, (int)'0', 37 },
+  { 18, (int)'0', 81 },
+  { 18, (int)'0', 85 },
+  { 18, (int)'0', 87 },
+  { 18, (int)'0', 89 },
+  { 18, (int)'0', 92 },
+  { 18, (int)'0', 94 },
+  { 18, (int)'0', 96 },
+  { 18, (int)'0', 28 },
+  { 18, (int)'0', 112 },
+  { 18, (int)'0', 136 },
+  { 18, (int)'0', 27 },
+  { 18, (int)'0', 25 },
+  { 18, (int)'0', 116 },
+  { 18, (int)'0', 124 },
+  { 0, 0, 0 },
+};
+static gcc_constexpr_data struct flat_event_map default_gc2event[] = {
+  { 0, GCE_TASK_START, 2 },
+  { 0, GCE_TASK_FINISH, 3 },
+  { 0, GCE_TASK_NEXTWAYPOINT, 4 },
+  { 0, GCE_ARM_READY, 5 },
+  { 0, GCE_TAKEOFF, 8 },
+  { 0, GCE_LANDING, 10 },
+  { 0, GCE_FLIGHTMODE_FINALGLIDE_ABOVE, 11 },
+  { 0, GCE_FLIGHTMODE_FINALGLIDE_BELOW, 12 },
+  { 0, GCE_FLIGHTMODE_FINALGLIDE_TERRAIN, 13 },
+  { 0, GCE_LANDABLE_UNREACHABLE, 1 },
+  { 0, 0, 0 },
+};
+static gcc_constexpr_data struct flat_event_map default_n2event[] = {
+  { 0, 0, 0 },
+};
+static gcc_constexpr_data struct flat_label default_labels[] = {
+  { 1, 1, 15, _T("Pan\nOff") },
+  { 1, 2, 20, _T("Zoom\nIn") },
+  { 1, 3, 21, _T("Zoom\nOut") },
+  { 1, 4, 22, _T("What's\nhere?") },
+  { 4, 1, 53, _T("Nav\n1/2") },
+  { 4, 5, 54, _T("Task") },
+  { 4, 6, 55, _T("$(WaypointPreviousArm)") },
+  { 4, 7, 56, _T("$(WaypointNextArm)") },
+  { 4, 8, 57, _T("Waypoint\nList$(CheckWaypointFile)") },
+  { 4, 9, 33, _T("Alternates$(CheckWaypointFile)") },
+  { 5, 1, 14, _T("Nav\n2/2") },
+  { 5, 5, 58, _T("Task\n$(TaskAbortToggleActionName)$(CheckWaypointFile)") },
+  { 5, 6, 31, _T("GoTo$(CheckWaypointFile)") },
+  { 5, 7, 59, _T("Target$(CheckTask)$(CheckTaskResumed)") },
+  { 5, 8, 61, _T("Waypoint\nDetails$(CheckTask)") },
+  { 5, 9, 0, _T("") },
+  { 6, 2, 62, _T("Display\n1/2") },
+  { 6, 5, 20, _T("Zoom\nIn") },
+  { 6, 6, 21, _T("Zoom\nOut") },
+  { 6, 7, 64, _T("Zoom\n$(ZoomAutoToggleActionName)") },
+  { 6, 8, 67, _T("Mark\nDrop") },
+  { 6, 9, 50, _T("Pan\nOn") },
+  { 7, 2, 14, _T("Display\n2/2") },
+  { 7, 5, 69, _T("Labels\n$(MapLabelsToggleActionName)") },
+  { 7, 6, 71, _T("Trail\n$(SnailTrailToggleName)") },
+  { 7, 7, 72, _T("Terrain\n$(TerrainToggleActionName)") },
+  { 7, 8, 73, _T("Topo.\n$(TopographyToggleActionName)") },
+  { 7, 9, 74, _T("$(NextPageName)") },
+  { 8, 3, 75, _T("Config\n1/3") },
+  { 8, 5, 76, _T("MacCready\n+") },
+  { 8, 6, 77, _T("MacCready\n-") },
+  { 8, 7, 79, _T("$(CheckAutoMc)MacCready\n$(MacCreadyToggleActionName)") },
+  { 8, 8, 37, _T("Flight\nSetup") },
+  { 8, 9, 81, _T("Setup\nWind") },
+  { 9, 3, 82, _T("Config\n2/3") },
+  { 9, 5, 83, _T("Vario$(CheckVega)") },
+  { 9, 6, 85, _T("Setup\nSystem") },
+  { 9, 7, 87, _T("Settings\nAirspace$(CheckAirspace)") },
+  { 9, 8, 89, _T("Logger\n$(LoggerActive)$(CheckLogger)") },
+  { 9, 9, 91, _T("Replay$(CheckReplay)") },
+  { 10, 3, 14, _T("Config\n3/3") },
+  { 10, 5, 92, _T("Raw Logger$(CheckLogger)") },
+  { 10, 6, 94, _T("Devices") },
+  { 10, 7, 96, _T("Setup Plane") },
+  { 13, 3, 97, _T("Vario\n1/2") },
+  { 13, 5, 99, _T("Airframe\nSwitches") },
+  { 13, 6, 100, _T("Setup Audio") },
+  { 13, 7, 101, _T("Manual\nDemo") },
+  { 13, 8, 102, _T("Setup\nStall") },
+  { 13, 9, 103, _T("Accel") },
+  { 14, 3, 14, _T("Vario\n2/2") },
+  { 14, 5, 104, _T("ASI\nZero") },
+  { 14, 6, 105, _T("Accel\nZero") },
+  { 14, 7, 107, _T("Store") },
+  { 14, 8, 108, _T("Cruise\nDemo") },
+  { 14, 9, 109, _T("Climb\nDemo") },
+  { 11, 4, 110, _T("Info\n1/3") },
+  { 11, 5, 29, _T("FLARM Radar$(CheckFLARM)") },
+  { 11, 6, 112, _T("METAR\nTAF$(CheckNet)") },
+  { 11, 7, 114, _T("What's\nhere?") },
+  { 11, 8, 27, _T("Check\nlist") },
+  { 11, 9, 25, _T("Analysis") },
+  { 12, 4, 115, _T("Info\n2/3") },
+  { 12, 5, 116, _T("Status") },
+  { 12, 6, 118, _T("Weather") },
+  { 12, 7, 120, _T("Team\nCode") },
+  { 12, 8, 122, _T("FLARM\nDetails") },
+  { 12, 9, 124, _T("Thermal Assistant") },
+  { 15, 4, 14, _T("Info\n3/3") },
+  { 15, 5, 126, _T("Credits") },
+  { 15, 6, 0, _T("") },
+  { 15, 7, 0, _T("") },
+  { 15, 8, 0, _T("") },
+  { 15, 9, 127, _T("Message\nRepeat") },
+  { 3, 1, 39, _T("Nav") },
+  { 3, 2, 40, _T("Display") },
+  { 3, 3, 41, _T("Config") },
+  { 3, 4, 42, _T("Info") },
+  { 3, 8, 14, _T("Cancel") },
+  { 3, 9, 129, _T("Quit") },
+  { 16, 1, 130, _T("Return") },
+  { 17, 5, 131, _T("Zoom\nIn") },
+  { 17, 6, 132, _T("Zoom\nOut") },
+  { 17, 7, 133, _T("Zoom\n$(TrafficZoomAutoToggleActionName)") },
+  { 17, 8, 134, _T("$(TrafficNorthUpToggleActionName)") },
+  { 18, 0, 54, _T("Task") },
+  { 18, 1, 55, _T("$(WaypointPreviousArm)") },
+  { 18, 2, 56, _T("$(WaypointNextArm)") },
+  { 18, 3, 57, _T("Waypoint\nList$(CheckWaypointFile)") },
+  { 18, 4, 33, _T("Alternates$(CheckWaypointFile)") },
+  { 18, 5, 58, _T("Task\n$(TaskAbortToggleActionName)$(CheckWaypointFile)") },
+  { 18, 6, 31, _T("GoTo$(CheckWaypointFile)") },
+  { 18, 7, 59, _T("Target$(CheckTask)$(CheckTaskResumed)") },
+  { 18, 8, 61, _T("Waypoint\nDetails$(CheckTask)") },
+  { 18, 9, 64, _T("Zoom\n$(ZoomAutoToggleActionName)") },
+  { 18, 10, 67, _T("Mark\nDrop") },
+  { 18, 11, 50, _T("Pan\nOn") },
+  { 18, 12, 69, _T("Labels\n$(MapLabelsToggleActionName)") },
+  { 18, 13, 71, _T("Trail\n$(SnailTrailToggleName)") },
+  { 18, 14, 72, _T("Terrain\n$(TerrainToggleActionName)") },
+  { 18, 15, 73, _T("Topo.\n$(TopographyToggleActionName)") },
+  { 18, 16, 79, _T("$(CheckAutoMc)MC\n$(MacCreadyToggleActionName)") },
+  { 18, 17, 37, _T("Flight\nSetup") },
+  { 18, 18, 81, _T("Setup\nWind") },
+  { 18, 19, 85, _T("Setup\nSystem") },
+  { 18, 20, 87, _T("Settings\nAirspace$(CheckAirspace)") },
+  { 18, 21, 89, _T("Logger\n$(LoggerActive)$(CheckLogger)") },
+  { 18, 22, 92, _T("Raw Logger$(CheckLogger)") },
+  { 18, 23, 94, _T("Devices") },
+  { 18, 24, 96, _T("Setup Plane") },
+  { 18, 25, 28, _T("FLARM Radar$(CheckFLARM)") },
+  { 18, 26, 112, _T("METAR\nTAF$(CheckNet)") },
+  { 18, 27, 136, _T("Nearest\nAirspace$(CheckAirspace)") },
+  { 18, 28, 27, _T("Check\nlist") },
+  { 18, 29, 25, _T("Analysis") },
+  { 18, 30, 116, _T("Status") },
+  { 18, 31, 124, _T("Thermal Assistant$(CheckCircling)") },
+  { 0, 0, 0, NULL },
+};
+static gcc_constexpr_data struct flat_gesture_map default_gesture2event[] = {
+  { 0, 20, _T("U") },
+  { 0, 21, _T("D") },
+  { 0, 46, _T("L") },
+  { 0, 47, _T("R") },
+  { 0, 48, _T("DR") },
+  { 0, 32, _T("DL") },
+  { 0, 38, _T("DU") },
+  { 0, 49, _T("RD") },
+  { 0, 24, _T("URD") },
+  { 0, 50, _T("URDL") },
+  { 0, 51, _T("LDRDL") },
+  { 0, 0, NULL },
+};
@@ -0,0 +1,240 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Airspace/AirspaceCache.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "IO/BinaryCache.hpp"
+
+#include <vector>
+#include <stdint.h>
+
+struct AirspaceCacheHeader {
+  static const uint32_t MAGIC = 0x43505341;
+
+  /**
+   * Increment this when the format or the parser's output changes.
+   */
+  static const uint32_t VERSION = 2;
+
+  uint32_t magic, version;
+
+  /**
+   * The sizes of the types which are stored in their native layout;
+   * a mismatch means the file was written by a different build.
+   */
+  uint8_t tchar_size, fixed_size, geo_point_size, altitude_size;
+  uint8_t activity_size;
+
+  /**
+   * The length of the original path (in characters), which follows
+   * the header.
+   */
+  uint32_t path_length;
+
+  uint32_t n_airspaces;
+
+  void Init() {
+    magic = MAGIC;
+    version = VERSION;
+    tchar_size = sizeof(TCHAR);
+    fixed_size = sizeof(fixed);
+    geo_point_size = sizeof(GeoPoint);
+    altitude_size = sizeof(AirspaceAltitude);
+    activity_size = sizeof(AirspaceActivity);
+  }
+
+  bool IsValid() const {
+    return magic == MAGIC && version == VERSION &&
+      tchar_size == sizeof(TCHAR) && fixed_size == sizeof(fixed) &&
+      geo_point_size == sizeof(GeoPoint) &&
+      altitude_size == sizeof(AirspaceAltitude) &&
+      activity_size == sizeof(AirspaceActivity);
+  }
+};
+
+/**
+ * One airspace.  It is followed by the name and the radio frequency
+ * (without null terminator), and then by the center and radius of a
+ * circle or the vertices of a polygon.
+ */
+struct AirspaceCacheRecord {
+  uint8_t shape, type;
+  uint16_t name_length, radio_length;
+
+  /**
+   * The number of polygon vertices; zero for circles.
+   */
+  uint32_t n_points;
+
+  AirspaceAltitude base, top;
+
+  /**
+   * The days of the week on which the airspace is active.
+   */
+  AirspaceActivity days_of_operation;
+};
+
+static bool
+SaveAirspace(FILE *file, const AbstractAirspace &airspace)
+{
+  const tstring name = airspace.GetName();
+  const tstring radio = airspace.GetRadioText();
+
+  /* value-initialise to zero the padding bytes, too, so the file
+     contents are reproducible */
+  AirspaceCacheRecord record = AirspaceCacheRecord();
+  record.shape = (uint8_t)airspace.shape;
+  record.type = (uint8_t)airspace.GetType();
+  record.name_length = name.length();
+  record.radio_length = radio.length();
+  record.base = airspace.GetBase();
+  record.top = airspace.GetTop();
+  record.days_of_operation = airspace.GetDays();
+
+  if (name.length() > 0xffff || radio.length() > 0xffff)
+    return false;
+
+  std::vector<GeoPoint> points;
+  if (airspace.shape == AbstractAirspace::Shape::POLYGON) {
+    const SearchPointVector &border = airspace.GetPoints();
+    points.reserve(border.size());
+    for (auto i = border.begin(), end = border.end(); i != end; ++i)
+      points.push_back(i->get_location());
+
+    record.n_points = points.size();
+  }
+
+  if (!WriteCacheData(file, &record, sizeof(record)) ||
+      !WriteCacheString(file, name) || !WriteCacheString(file, radio))
+    return false;
+
+  if (airspace.shape == AbstractAirspace::Shape::CIRCLE) {
+    const AirspaceCircle &circle = (const AirspaceCircle &)airspace;
+    const GeoPoint center = circle.GetCenter();
+    const fixed radius = circle.GetRadius();
+    return WriteCacheData(file, &center, sizeof(center)) &&
+      WriteCacheData(file, &radius, sizeof(radius));
+  } else
+    return points.empty() ||
+      WriteCacheData(file, &points.front(),
+                     points.size() * sizeof(points.front()));
+}
+
+bool
+AirspaceCache::Save(FILE *file, const TCHAR *original_path,
+                    std::deque<AbstractAirspace *>::const_iterator begin,
+                    std::deque<AbstractAirspace *>::const_iterator end)
+{
+  AirspaceCacheHeader header;
+  header.Init();
+  header.path_length = _tcslen(original_path);
+  header.n_airspaces = end - begin;
+
+  if (!WriteCacheData(file, &header, sizeof(header)) ||
+      !WriteCacheData(file, original_path, header.path_length * sizeof(TCHAR)))
+    return false;
+
+  for (auto i = begin; i != end; ++i)
+    if (!SaveAirspace(file, **i))
+      return false;
+
+  return true;
+}
+
+static AbstractAirspace *
+LoadAirspace(CacheReader &reader)
+{
+  AirspaceCacheRecord record;
+  tstring name, radio;
+  if (!reader.Read(record) || record.type >= AIRSPACECLASSCOUNT ||
+      !reader.ReadString(name, record.name_length) ||
+      !reader.ReadString(radio, record.radio_length))
+    return NULL;
+
+  AbstractAirspace *airspace;
+  if (record.shape == (uint8_t)AbstractAirspace::Shape::CIRCLE) {
+    GeoPoint center;
+    fixed radius;
+    if (!reader.Read(center) || !reader.Read(radius))
+      return NULL;
+
+    airspace = new AirspaceCircle(center, radius);
+  } else if (record.shape == (uint8_t)AbstractAirspace::Shape::POLYGON) {
+    std::vector<GeoPoint> points(record.n_points);
+    if (record.n_points > 0 &&
+        !reader.Read(&points.front(), points.size() * sizeof(points.front())))
+      return NULL;
+
+    airspace = new AirspacePolygon(points);
+  } else
+    return NULL;
+
+  airspace->SetProperties(name, (AirspaceClass)record.type,
+                          record.base, record.top);
+  airspace->SetRadio(radio);
+  airspace->SetDays(record.days_of_operation);
+  return airspace;
+}
+
+bool
+AirspaceCache::Load(FILE *file, const TCHAR *original_path,
+                    Airspaces &airspaces)
+{
+  CacheReader reader;
+  if (!reader.Load(file))
+    return false;
+
+  AirspaceCacheHeader header;
+  tstring path;
+  if (!reader.Read(header) || !header.IsValid() ||
+      !reader.ReadString(path, header.path_length) ||
+      path != original_path)
+    return false;
+
+  std::vector<AbstractAirspace *> loaded;
+  loaded.reserve(header.n_airspaces);
+
+  bool success = true;
+  for (unsigned i = 0; i < header.n_airspaces; ++i) {
+    AbstractAirspace *airspace = LoadAirspace(reader);
+    if (airspace == NULL) {
+      success = false;
+      break;
+    }
+
+    loaded.push_back(airspace);
+  }
+
+  if (!success || !reader.IsEnd()) {
+    for (auto i = loaded.begin(), end = loaded.end(); i != end; ++i)
+      delete *i;
+    return false;
+  }
+
+  for (auto i = loaded.begin(), end = loaded.end(); i != end; ++i)
+    airspaces.insert(*i);
+
+  return true;
+}
@@ -0,0 +1,67 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_CACHE_HPP
+#define XCSOAR_AIRSPACE_CACHE_HPP
+
+#include <deque>
+#include <stdio.h>
+#include <tchar.h>
+
+class Airspaces;
+class AbstractAirspace;
+
+/**
+ * Stores parsed airspaces in a binary file, to avoid parsing the
+ * airspace file (including the arc tessellation) on every startup.
+ * The format depends on the build (character and number types), and
+ * is meant to be used with #FileCache only.
+ *
+ * Only what the parser produces is stored: shape, vertices, class,
+ * name, radio frequency and altitudes.  Data derived from the
+ * complete airspace database (flat projection, flight levels, ground
+ * levels) is calculated after loading, as usual.
+ */
+namespace AirspaceCache {
+  /**
+   * Write the specified airspaces to the file.
+   *
+   * @param original_path the path of the airspace file; a cache file
+   * with a different path is not loaded
+   * @return false on I/O error
+   */
+  bool Save(FILE *file, const TCHAR *original_path,
+            std::deque<AbstractAirspace *>::const_iterator begin,
+            std::deque<AbstractAirspace *>::const_iterator end);
+
+  /**
+   * Read a file written by Save() and insert its airspaces.  Nothing
+   * is inserted if the file is malformed.
+   *
+   * @return false if the file is malformed or does not belong to the
+   * specified airspace file
+   */
+  bool Load(FILE *file, const TCHAR *original_path, Airspaces &airspaces);
+}
+
+#endif
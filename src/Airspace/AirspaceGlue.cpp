@@ -30,11 +30,101 @@ Copyright_License {
 #include "Language/Language.hpp"
 #include "LogFile.hpp"
 #include "IO/ConfiguredFile.hpp"
+#include "IO/FileCache.hpp"
+#include "Airspace/AirspaceCache.hpp"
+#include "Profile/Profile.hpp"
+#include "OS/FileUtil.hpp"
+
+#include <windef.h> /* for MAX_PATH */
+
+/**
+ * Determine the path of the configured airspace file, or the path of
+ * the file inside the map file (which #FileCache understands).  This
+ * mirrors the lookup in OpenConfiguredTextFile().
+ *
+ * @return false if no such file is configured
+ */
+static bool
+GetAirspacePath(const TCHAR *profile_key, const TCHAR *in_map_file,
+                TCHAR *path)
+{
+  if (Profile::GetPath(profile_key, path) && File::Exists(path))
+    return true;
+
+  if (in_map_file == NULL || !Profile::GetPath(szProfileMapFile, path))
+    return false;
+
+  _tcscat(path, _T("/"));
+  _tcscat(path, in_map_file);
+  return true;
+}
+
+/**
+ * Load one airspace file, preferably from the cache.
+ *
+ * @param cache_name the name of the cache file
+ * @param in_map_file the name of the file inside the map file, or
+ * NULL if there is no fallback
+ * @return true if the file was loaded successfully
+ */
+static bool
+LoadAirspaceFile(Airspaces &airspaces, const TCHAR *profile_key,
+                 const TCHAR *in_map_file, const TCHAR *cache_name,
+                 FileCache *cache, OperationEnvironment &operation)
+{
+  TCHAR path[MAX_PATH];
+  if (cache != NULL &&
+      !GetAirspacePath(profile_key, in_map_file, path))
+    cache = NULL;
+
+  if (cache != NULL) {
+    FILE *file = cache->Load(cache_name, path);
+    if (file != NULL) {
+      const bool loaded = AirspaceCache::Load(file, path, airspaces);
+      fclose(file);
+
+      if (loaded)
+        return true;
+
+      LogStartUp(_T("Airspace cache %s is invalid"), cache_name);
+    }
+  }
+
+  TLineReader *reader = in_map_file != NULL
+    ? OpenConfiguredTextFile(profile_key, in_map_file,
+                             ConvertLineReader::AUTO)
+    : OpenConfiguredTextFile(profile_key, ConvertLineReader::AUTO);
+  if (reader == NULL)
+    return false;
+
+  const unsigned n_before = airspaces.GetPending().size();
+
+  AirspaceParser parser(airspaces);
+  const bool success = parser.Parse(*reader, operation);
+  delete reader;
+
+  if (!success || cache == NULL)
+    return success;
+
+  /* save the cache file */
+  FILE *file = cache->Save(cache_name, path);
+  if (file != NULL) {
+    const std::deque<AbstractAirspace *> &pending = airspaces.GetPending();
+    if (AirspaceCache::Save(file, path, pending.begin() + n_before,
+                            pending.end()))
+      cache->Commit(cache_name, file);
+    else
+      cache->Cancel(cache_name, file);
+  }
+
+  return true;
+}
 
 void
 ReadAirspace(Airspaces &airspaces,
              RasterTerrain *terrain,
              const AtmosphericPressure &press,
+             FileCache *cache,
              OperationEnvironment &operation)
 {
   LogStartUp(_T("ReadAirspace"));
@@ -42,31 +132,18 @@ ReadAirspace(Airspaces &airspaces,
 
   bool airspace_ok = false;
 
-  AirspaceParser parser(airspaces);
-
   // Read the airspace filenames from the registry
-  TLineReader *reader =
-    OpenConfiguredTextFile(szProfileAirspaceFile, _T("airspace.txt"),
-                           ConvertLineReader::AUTO);
-  if (reader != NULL) {
-    if (!parser.Parse(*reader, operation))
-      LogStartUp(_T("No airspace file 1"));
-    else
-      airspace_ok =  true;
-
-    delete reader;
-  }
+  if (LoadAirspaceFile(airspaces, szProfileAirspaceFile, _T("airspace.txt"),
+                       _T("airspace"), cache, operation))
+    airspace_ok = true;
+  else
+    LogStartUp(_T("No airspace file 1"));
 
-  reader = OpenConfiguredTextFile(szProfileAdditionalAirspaceFile,
-                                  ConvertLineReader::AUTO);
-  if (reader != NULL) {
-    if (!parser.Parse(*reader, operation))
-      LogStartUp(_T("No airspace file 2"));
-    else
-      airspace_ok = true;
-
-    delete reader;
-  }
+  if (LoadAirspaceFile(airspaces, szProfileAdditionalAirspaceFile, NULL,
+                       _T("airspace2"), cache, operation))
+    airspace_ok = true;
+  else
+    LogStartUp(_T("No airspace file 2"));
 
   if (airspace_ok) {
     airspaces.optimise();
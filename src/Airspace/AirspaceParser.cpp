@@ -26,7 +26,6 @@ Copyright_License {
 #include "Airspace/Airspaces.hpp"
 #include "Operation/Operation.hpp"
 #include "Units/System.hpp"
-#include "Dialogs/Message.hpp"
 #include "Language/Language.hpp"
 #include "Util/CharUtil.hpp"
 #include "Util/StringUtil.hpp"
@@ -232,14 +231,19 @@ struct TempAirspaceType
   }
 };
 
-static bool
-ShowParseWarning(int line, const TCHAR* str)
+/**
+ * Report a line which could not be parsed.  This does not ask the
+ * user, because the parser may run in a worker thread; the line is
+ * skipped and the #OperationEnvironment decides how to show the
+ * message.
+ */
+static void
+ShowParseWarning(OperationEnvironment &operation, int line, const TCHAR* str)
 {
   StaticString<256> buffer;
   buffer.Format(_T("%s: %d\r\n\"%s\"\r\n%s."),
                 _("Parse Error at Line"), line, str, _("Line skipped."));
-  return (MessageBoxX(buffer, _("Airspace"), MB_OKCANCEL) == IDOK);
-
+  operation.SetErrorMessage(buffer);
 }
 
 static void
@@ -857,14 +861,12 @@ AirspaceParser::Parse(TLineReader &reader, OperationEnvironment &operation)
 
     // Parse the line
     if (filetype == AFT_OPENAIR)
-      if (!ParseLine(airspaces, line, temp_area) &&
-          !ShowParseWarning(LineCount, line))
-        return false;
+      if (!ParseLine(airspaces, line, temp_area))
+        ShowParseWarning(operation, LineCount, line);
 
     if (filetype == AFT_TNP)
-      if (!ParseLineTNP(airspaces, line, temp_area, ignore) &&
-          !ShowParseWarning(LineCount, line))
-        return false;
+      if (!ParseLineTNP(airspaces, line, temp_area, ignore))
+        ShowParseWarning(operation, LineCount, line);
 
     // Update the ProgressDialog
     if ((LineCount & 0xff) == 0)
@@ -0,0 +1,48 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_BLACKBOARD_SNAPSHOT_HPP
+#define XCSOAR_BLACKBOARD_SNAPSHOT_HPP
+
+#include <memory>
+
+struct MoreData;
+struct DerivedInfo;
+
+/**
+ * An immutable, reference counted copy of MoreData.  The producer
+ * (the MergeThread) publishes a new one after each update; readers
+ * just take a reference, and the old version is freed when its last
+ * reader has released it.
+ */
+typedef std::shared_ptr<const MoreData> BasicSnapshot;
+
+/**
+ * An immutable, reference counted copy of DerivedInfo, published by
+ * the CalculationThread.
+ *
+ * @see BasicSnapshot
+ */
+typedef std::shared_ptr<const DerivedInfo> CalculatedSnapshot;
+
+#endif
@@ -57,6 +57,9 @@ DeviceBlackboard::DeviceBlackboard()
 
   real_data = simulator_data = replay_data = gps_info;
 
+  basic_snapshot = BasicSnapshot(new MoreData(gps_info));
+  calculated_snapshot = CalculatedSnapshot(new DerivedInfo(calculated_info));
+
   simulator.Init(simulator_data);
 }
 
@@ -222,7 +225,24 @@ DeviceBlackboard::SetAltitude(fixed val)
 void
 DeviceBlackboard::ReadBlackboard(const DerivedInfo &derived_info)
 {
-  calculated_info = derived_info;
+  CalculatedSnapshot snapshot(new DerivedInfo(derived_info));
+  ReadBlackboard(snapshot);
+}
+
+void
+DeviceBlackboard::ReadBlackboard(CalculatedSnapshot &derived_info)
+{
+  assert(derived_info);
+
+  calculated_snapshot.swap(derived_info);
+}
+
+void
+DeviceBlackboard::PublishBasic(BasicSnapshot &snapshot)
+{
+  assert(snapshot);
+
+  basic_snapshot.swap(snapshot);
 }
 
 /**
@@ -271,6 +291,9 @@ DeviceBlackboard::Merge()
 {
   real_data.Reset();
   for (unsigned i = 0; i < NUMDEV; ++i) {
+    if (published_device_data[i].Consume())
+      per_device_data[i] = published_device_data[i].GetFront();
+
     if (!per_device_data[i].alive)
       continue;
 
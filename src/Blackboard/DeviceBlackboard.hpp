@@ -26,9 +26,11 @@ Copyright_License {
 
 #include "Blackboard/BaseBlackboard.hpp"
 #include "Blackboard/ComputerSettingsBlackboard.hpp"
+#include "Blackboard/BlackboardSnapshot.hpp"
 #include "Device/Simulator.hpp"
 #include "Device/List.hpp"
 #include "Thread/Mutex.hpp"
+#include "Thread/TripleBuffer.hpp"
 
 #include <cassert>
 
@@ -55,6 +57,12 @@ class DeviceBlackboard:
    */
   NMEAInfo per_device_data[NUMDEV];
 
+  /**
+   * Snapshots published by the devices' port threads with
+   * PublishRealState().  Merge() copies them to #per_device_data.
+   */
+  TripleBuffer<NMEAInfo> published_device_data[NUMDEV];
+
   /**
    * Merged data from the physical devices.
    */
@@ -70,12 +78,32 @@ class DeviceBlackboard:
    */
   NMEAInfo replay_data;
 
+  /**
+   * Immutable copies of Basic() and Calculated() as of the last
+   * PublishBasic() and ReadBlackboard() call.  Other threads grab
+   * these instead of copying the whole structures while holding the
+   * mutex.  The pointers are protected by #mutex.
+   *
+   * There is no private copy of the calculated results:
+   * Calculated() reads through #calculated_snapshot.
+   */
+  BasicSnapshot basic_snapshot;
+  CalculatedSnapshot calculated_snapshot;
+
 public:
   Mutex mutex;
 
 public:
   DeviceBlackboard();
   void ReadBlackboard(const DerivedInfo &derived_info);
+
+  /**
+   * Install new results from the CalculationThread.  Caller must
+   * lock the blackboard.  This only exchanges pointers: upon return,
+   * the parameter holds the previous snapshot, which the caller
+   * should release after unlocking.
+   */
+  void ReadBlackboard(CalculatedSnapshot &derived_info);
   void ReadComputerSettings(const ComputerSettings &settings);
 
 protected:
@@ -93,12 +121,61 @@ public:
     return per_device_data[i];
   }
 
+  /**
+   * Publish new data parsed from the specified device, and schedule
+   * a merge.  This method does not lock the blackboard; the
+   * MergeThread will pick up the most recent snapshot.  Each device
+   * must have only one thread calling this method at a time.
+   */
+  void PublishRealState(unsigned i, const NMEAInfo &data) {
+    assert(i < NUMDEV);
+
+    published_device_data[i].Publish(data);
+    ScheduleMerge();
+  }
+
   NMEAInfo &SetSimulatorState() { return simulator_data; }
   NMEAInfo &SetReplayState() { return replay_data; }
 
 public:
   const NMEAInfo &RealState() const { return real_data; }
 
+  /**
+   * Hides BaseBlackboard::Calculated(): the results live in the
+   * shared snapshot.  Caller must lock the blackboard.
+   */
+  gcc_pure
+  const DerivedInfo &Calculated() const {
+    return *calculated_snapshot;
+  }
+
+  /**
+   * Returns the most recently published copy of Basic().  Caller
+   * must lock the blackboard, but may use the returned object after
+   * unlocking.
+   */
+  const BasicSnapshot &GetBasicSnapshot() const {
+    return basic_snapshot;
+  }
+
+  /**
+   * Returns the most recently published copy of Calculated().
+   *
+   * @see GetBasicSnapshot()
+   */
+  const CalculatedSnapshot &GetCalculatedSnapshot() const {
+    return calculated_snapshot;
+  }
+
+  /**
+   * Publish a copy of Basic() for GetBasicSnapshot().  Called by the
+   * MergeThread after it has finished updating it; the copy is made
+   * by the caller before locking the blackboard.  Upon return, the
+   * parameter holds the previous snapshot.  Caller must lock the
+   * blackboard.
+   */
+  void PublishBasic(BasicSnapshot &snapshot);
+
   /**
    * Is the specified device a FLARM?
    *
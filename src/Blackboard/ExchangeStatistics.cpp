@@ -0,0 +1,49 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ExchangeStatistics.hpp"
+#include "Thread/Mutex.hpp"
+#include "OS/Clock.hpp"
+#include "LogFile.hpp"
+
+void
+ExchangeStatistics::Log() const
+{
+  LogStartUp(_T("Blackboard exchange %s: %lu exchanges, %lu kB copied, "
+                "lock wait %lu ms total, %u us max"),
+             name, exchanges, (unsigned long)(bytes_copied / 1024),
+             (unsigned long)(lock_wait_us / 1000), max_lock_wait_us);
+}
+
+ExchangeLock::ExchangeLock(Mutex &_mutex, ExchangeStatistics &statistics)
+  :mutex(_mutex)
+{
+  const uint64_t start = MonotonicClockUS();
+  mutex.Lock();
+  statistics.AddLockWait(unsigned(MonotonicClockUS() - start));
+}
+
+ExchangeLock::~ExchangeLock()
+{
+  mutex.Unlock();
+}
@@ -0,0 +1,95 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_EXCHANGE_STATISTICS_HPP
+#define XCSOAR_EXCHANGE_STATISTICS_HPP
+
+#include "Util/NonCopyable.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tchar.h>
+
+class Mutex;
+
+/**
+ * Instrumentation for a thread which exchanges data with the
+ * DeviceBlackboard: how often it did, how many bytes it copied and
+ * how long it waited for the blackboard mutex.
+ *
+ * Only the owning thread updates the counters; Log() may be called
+ * after that thread has stopped.
+ */
+class ExchangeStatistics : private NonCopyable {
+  const TCHAR *name;
+
+  unsigned long exchanges;
+
+  uint64_t bytes_copied;
+
+  uint64_t lock_wait_us;
+  unsigned max_lock_wait_us;
+
+public:
+  ExchangeStatistics(const TCHAR *_name)
+    :name(_name) {
+    Clear();
+  }
+
+  void Clear() {
+    exchanges = 0;
+    bytes_copied = 0;
+    lock_wait_us = 0;
+    max_lock_wait_us = 0;
+  }
+
+  void AddCopy(size_t size) {
+    bytes_copied += size;
+  }
+
+  void AddLockWait(unsigned us) {
+    ++exchanges;
+    lock_wait_us += us;
+    if (us > max_lock_wait_us)
+      max_lock_wait_us = us;
+  }
+
+  /**
+   * Write the counters to the log file.
+   */
+  void Log() const;
+};
+
+/**
+ * Like ScopeLock, but measures the time needed to obtain the lock and
+ * records it in an ExchangeStatistics object.
+ */
+class ExchangeLock : private NonCopyable {
+  Mutex &mutex;
+
+public:
+  ExchangeLock(Mutex &_mutex, ExchangeStatistics &statistics);
+  ~ExchangeLock();
+};
+
+#endif
@@ -28,13 +28,15 @@ Copyright_License {
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Components.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
+#include "LatencyTrace.hpp"
 
 /**
  * Constructor of the CalculationThread class
  * @param _glide_computer The GlideComputer used for the CalculationThread
  */
 CalculationThread::CalculationThread(GlideComputer &_glide_computer)
-  :WorkerThread(450, 100, 50), glide_computer(_glide_computer) {
+  :WorkerThread(450, 100, 50), glide_computer(_glide_computer),
+   exchange_statistics(_T("calculation")) {
 }
 
 void
@@ -51,6 +53,19 @@ CalculationThread::SetScreenDistanceMeters(fixed new_value)
   screen_distance_meters = new_value;
 }
 
+void
+CalculationThread::PublishCalculated()
+{
+  /* the snapshot is created before locking the blackboard, so only
+     the pointer exchange happens while holding the lock; the
+     previous snapshot is released after unlocking */
+  CalculatedSnapshot calculated(new DerivedInfo(glide_computer.Calculated()));
+  exchange_statistics.AddCopy(sizeof(*calculated));
+
+  ExchangeLock protect(device_blackboard->mutex, exchange_statistics);
+  device_blackboard->ReadBlackboard(calculated);
+}
+
 /**
  * Main loop of the CalculationThread
  */
@@ -60,17 +75,19 @@ CalculationThread::Tick()
   const Validity previous_warning =
     glide_computer.Calculated().airspace_warnings.latest;
 
-  bool gps_updated;
-
   // update and transfer master info to glide computer
+  BasicSnapshot basic;
   {
-    ScopeLock protect(device_blackboard->mutex);
+    ExchangeLock protect(device_blackboard->mutex, exchange_statistics);
+    basic = device_blackboard->GetBasicSnapshot();
+  }
 
-    gps_updated = device_blackboard->Basic().location_available.Modified(glide_computer.Basic().location_available);
+  const bool gps_updated =
+    basic->location_available.Modified(glide_computer.Basic().location_available);
 
-    // Copy data from DeviceBlackboard to GlideComputerBlackboard
-    glide_computer.ReadBlackboard(device_blackboard->Basic());
-  }
+  // Copy data from DeviceBlackboard to GlideComputerBlackboard
+  glide_computer.ReadBlackboard(*basic);
+  exchange_statistics.AddCopy(sizeof(*basic));
 
   {
     ScopeLock protect(mutex);
@@ -90,15 +107,15 @@ CalculationThread::Tick()
   // values changed, so copy them back now: ONLY CALCULATED INFO
   // should be changed in DoCalculations, so we only need to write
   // that one back (otherwise we may write over new data)
-  {
-    ScopeLock protect(device_blackboard->mutex);
-    device_blackboard->ReadBlackboard(glide_computer.Calculated());
-  }
+  PublishCalculated();
 
   // if (new GPS data)
   if (gps_updated) {
+    LatencyTrace::Record(LatencyTrace::CALCULATED, basic->time);
+
     // inform map new data is ready
     TriggerCalculatedUpdate();
+    fix_processed.Signal();
   }
 
   if (do_idle) {
@@ -108,10 +125,7 @@ CalculationThread::Tick()
     if (glide_computer.Calculated().airspace_warnings.latest != previous_warning) {
       /* there's a new airspace warning */
 
-      {
-        ScopeLock protect(device_blackboard->mutex);
-        device_blackboard->ReadBlackboard(glide_computer.Calculated());
-      }
+      PublishCalculated();
 
       TriggerAirspaceWarning();
     }
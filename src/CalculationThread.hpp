@@ -26,7 +26,9 @@ Copyright_License {
 
 #include "Thread/WorkerThread.hpp"
 #include "Thread/Mutex.hpp"
+#include "Thread/Trigger.hpp"
 #include "ComputerSettings.hpp"
+#include "Blackboard/ExchangeStatistics.hpp"
 
 class GlideComputer;
 
@@ -49,12 +51,48 @@ class CalculationThread : public WorkerThread {
   /** Pointer to the GlideComputer that should be used */
   GlideComputer &glide_computer;
 
+  /**
+   * Instrumentation of the data exchange with the DeviceBlackboard.
+   * Only accessed by this thread while it is running.
+   */
+  ExchangeStatistics exchange_statistics;
+
+  /**
+   * Signalled after each Tick() which has processed a new GPS fix.
+   * See WaitFixProcessed().
+   */
+  ::Trigger fix_processed;
+
 public:
   CalculationThread(GlideComputer &_glide_computer);
 
   void SetComputerSettings(const ComputerSettings &new_value);
   void SetScreenDistanceMeters(fixed new_value);
 
+  const ExchangeStatistics &GetExchangeStatistics() const {
+    return exchange_statistics;
+  }
+
+  /**
+   * Prepare for WaitFixProcessed().  Call this before submitting the
+   * new fix to the DeviceBlackboard.
+   */
+  void ResetFixProcessed() {
+    fix_processed.Reset();
+  }
+
+  /**
+   * Wait until a new GPS fix has been processed since the last
+   * ResetFixProcessed() call.  This allows a replay to feed fixes
+   * as fast as this thread can consume them.
+   *
+   * @return true if a fix was processed, false if the timeout has
+   * expired
+   */
+  bool WaitFixProcessed(unsigned timeout_ms) {
+    return fix_processed.Wait(timeout_ms);
+  }
+
   bool Start(bool suspended=false) {
     if (!WorkerThread::Start(suspended))
       return false;
@@ -63,6 +101,12 @@ public:
     return true;
   }
 
+private:
+  /**
+   * Pass the GlideComputer's results to the DeviceBlackboard.
+   */
+  void PublishCalculated();
+
 protected:
   virtual void Tick();
 };
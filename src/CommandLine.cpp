@@ -27,6 +27,7 @@ Copyright_License {
 #include "OS/PathName.hpp"
 #include "Hardware/Display.hpp"
 #include "Simulator.hpp"
+#include "LatencyTrace.hpp"
 
 namespace CommandLine {
 #if !defined(_WIN32_WCE)
@@ -75,6 +76,9 @@ CommandLine::Parse(Args args)
       sim_set_in_cmd_line_flag=true;
     }
 #endif
+    else if (strcmp(s, "-trace-latency") == 0) {
+      LatencyTrace::Enable();
+    }
 #if !defined(_WIN32_WCE)
     else if (isdigit(s[1])) {
       char *p;
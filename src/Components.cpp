@@ -48,6 +48,7 @@ Copyright_License {
 #include "MapSettings.hpp"
 #include "Logger/Logger.hpp"
 #include "Logger/NMEALogger.hpp"
+#include "LatencyTrace.hpp"
 #include "Logger/GlueFlightLogger.hpp"
 #include "Waypoint/WaypointDetailsReader.hpp"
 #include "Screen/Fonts.hpp"
@@ -92,6 +93,9 @@ Copyright_License {
 #include "Task/ProtectedTaskManager.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
 #include "Operation/VerboseOperationEnvironment.hpp"
+#include "Thread/JobGraph.hpp"
+#include "Thread/ThreadPool.hpp"
+#include "OS/Clock.hpp"
 #include "Pages.hpp"
 #include "Weather/NOAAGlue.hpp"
 #include "Weather/NOAAStore.hpp"
@@ -146,6 +150,149 @@ static GlideComputerEvents glide_computer_events;
 AltairControl altair_control;
 #endif
 
+/**
+ * Opens the terrain file.
+ */
+class TerrainJob : public JobGraph::Job {
+public:
+  RasterTerrain *terrain;
+
+  TerrainJob():terrain(NULL) {}
+
+  virtual void Run(OperationEnvironment &env) {
+    LogStartUp(_T("OpenTerrain"));
+    env.SetText(_("Loading Terrain File..."));
+    terrain = RasterTerrain::OpenTerrain(file_cache, env);
+  }
+};
+
+class GeoidJob : public JobGraph::Job {
+public:
+  virtual void Run(OperationEnvironment &env) {
+    EGM96::Load();
+  }
+};
+
+class TopographyJob : public JobGraph::Job {
+public:
+  virtual void Run(OperationEnvironment &env) {
+    LoadConfiguredTopography(*topography, file_cache, env);
+  }
+};
+
+/**
+ * Reads the waypoint files.  Depends on #TerrainJob, because
+ * waypoints without elevation are looked up in the terrain.
+ */
+class WaypointJob : public JobGraph::Job {
+  const TerrainJob &terrain_job;
+
+public:
+  WaypointJob(const TerrainJob &_terrain_job)
+    :terrain_job(_terrain_job) {}
+
+  virtual void Run(OperationEnvironment &env) {
+    WaypointGlue::LoadWaypoints(way_points, terrain_job.terrain, file_cache,
+                                env);
+  }
+};
+
+/**
+ * Reads and parses the airfield info file.  Depends on #WaypointJob.
+ */
+class WaypointDetailsJob : public JobGraph::Job {
+public:
+  virtual void Run(OperationEnvironment &env) {
+    WaypointDetails::ReadFileFromProfile(way_points, env);
+  }
+};
+
+/**
+ * Reads the airspace files.  The ground levels are looked up
+ * separately by #AirspaceGroundJob, so this job does not need to wait
+ * for the terrain.
+ */
+class AirspaceJob : public JobGraph::Job {
+  const AtmosphericPressure pressure;
+
+public:
+  AirspaceJob(const AtmosphericPressure &_pressure)
+    :pressure(_pressure) {}
+
+  virtual void Run(OperationEnvironment &env) {
+    ReadAirspace(airspace_database, NULL, pressure, file_cache, env);
+  }
+};
+
+/**
+ * Looks up the ground level of all airspaces.  Depends on
+ * #TerrainJob and #AirspaceJob.
+ */
+class AirspaceGroundJob : public JobGraph::Job {
+  const TerrainJob &terrain_job;
+
+public:
+  AirspaceGroundJob(const TerrainJob &_terrain_job)
+    :terrain_job(_terrain_job) {}
+
+  virtual void Run(OperationEnvironment &env) {
+    if (terrain_job.terrain != NULL && !airspace_database.empty())
+      airspace_database.set_ground_levels(*terrain_job.terrain);
+  }
+};
+
+/**
+ * Load the terrain, topography, waypoints and airspaces.  The files
+ * are loaded in parallel, as far as their dependencies allow.
+ */
+static void
+LoadFiles(OperationEnvironment &operation)
+{
+  TerrainJob terrain_job;
+  GeoidJob geoid_job;
+  TopographyJob topography_job;
+  WaypointJob waypoint_job(terrain_job);
+  WaypointDetailsJob waypoint_details_job;
+  AirspaceJob airspace_job(CommonInterface::GetComputerSettings().pressure);
+  AirspaceGroundJob airspace_ground_job(terrain_job);
+
+  /* the weights are rough estimates of the relative loading time,
+     for the combined progress bar */
+  JobGraph graph;
+  const unsigned terrain_index =
+    graph.Add(_T("terrain"), terrain_job, 4);
+  graph.Add(_T("geoid"), geoid_job);
+  graph.Add(_T("topography"), topography_job, 4);
+  const unsigned waypoint_index =
+    graph.Add(_T("waypoints"), waypoint_job, 2);
+  const unsigned waypoint_details_index =
+    graph.Add(_T("waypoint details"), waypoint_details_job);
+  const unsigned airspace_index =
+    graph.Add(_T("airspace"), airspace_job, 2);
+  const unsigned airspace_ground_index =
+    graph.Add(_T("airspace ground"), airspace_ground_job);
+
+  graph.AddDependency(waypoint_index, terrain_index);
+  graph.AddDependency(waypoint_details_index, waypoint_index);
+  graph.AddDependency(airspace_ground_index, terrain_index);
+  graph.AddDependency(airspace_ground_index, airspace_index);
+
+  /* one thread more than there are cores, because the loaders spend
+     some of their time waiting for I/O */
+  const unsigned start = MonotonicClockMS();
+  graph.Run(operation, ThreadPool::GetDefaultWorkerCount() + 2);
+  const unsigned duration = MonotonicClockMS() - start;
+
+  terrain = terrain_job.terrain;
+
+  for (unsigned i = 0; i < graph.GetJobCount(); ++i)
+    LogStartUp(_T("Loaded %s in %u ms, started after %u ms"),
+               graph.GetName(i), graph.GetDuration(i),
+               graph.GetStartTime(i));
+
+  LogStartUp(_T("Loaded all files in %u ms"), duration);
+}
+
 bool
 XCSoarInterface::LoadProfile()
 {
@@ -324,10 +471,9 @@ XCSoarInterface::Startup()
     new ProtectedTaskManager(*task_manager,
                              XCSoarInterface::GetComputerSettings().task);
 
-  // Read the terrain file
-  operation.SetText(_("Loading Terrain File..."));
-  LogStartUp(_T("OpenTerrain"));
-  terrain = RasterTerrain::OpenTerrain(file_cache, operation);
+  // Read the terrain, topography, waypoint and airspace files
+  topography = new TopographyStore();
+  LoadFiles(operation);
 
   glide_computer = new GlideComputer(way_points, airspace_database,
                                      *protected_task_manager,
@@ -339,9 +485,6 @@ XCSoarInterface::Startup()
 
   replay = new Replay(&logger, *protected_task_manager);
 
-  // Load the EGM96 geoid data
-  EGM96::Load();
-
   GlidePolar &gp = SetComputerSettings().polar.glide_polar_task;
   gp = GlidePolar(fixed_zero);
   gp.SetMC(GetComputerSettings().task.safety_mc);
@@ -350,16 +493,6 @@ XCSoarInterface::Startup()
   PlaneGlue::Synchronize(GetComputerSettings().plane, SetComputerSettings(), gp);
   task_manager->SetGlidePolar(gp);
 
-  // Read the topography file(s)
-  topography = new TopographyStore();
-  LoadConfiguredTopography(*topography, operation);
-
-  // Read the waypoint files
-  WaypointGlue::LoadWaypoints(way_points, terrain, operation);
-
-  // Read and parse the airfield info file
-  WaypointDetails::ReadFileFromProfile(way_points, operation);
-
   // Set the home waypoint
   WaypointGlue::SetHome(way_points, terrain, SetComputerSettings(),
                         false);
@@ -372,10 +505,6 @@ XCSoarInterface::Startup()
   LogStartUp(_T("RASP load"));
   RASP.ScanAll(Basic().location, operation);
 
-  // Reads the airspace files
-  ReadAirspace(airspace_database, terrain, GetComputerSettings().pressure,
-               operation);
-
   {
     const AircraftState aircraft_state =
       ToAircraftState(device_blackboard->Basic(),
@@ -548,6 +677,7 @@ XCSoarInterface::Shutdown()
   merge_thread = NULL;
 
   calculation_thread->Join();
+  calculation_thread->GetExchangeStatistics().Log();
   delete calculation_thread;
   calculation_thread = NULL;
 
@@ -559,6 +689,10 @@ XCSoarInterface::Shutdown()
   delete draw_thread;
 #endif
 
+  if (main_window.GetMap() != NULL)
+    main_window.GetMap()->GetExchangeStatistics().Log();
+  exchange_statistics.Log();
+
   LogStartUp(_T("delete MapWindow"));
   main_window.Deinitialise();
 
@@ -592,6 +726,14 @@ XCSoarInterface::Shutdown()
   // Close any device connections
   devShutdown();
 
+  if (LatencyTrace::IsEnabled()) {
+    TCHAR path[MAX_PATH];
+    LocalPath(path, _T("latency.trace"));
+    LogStartUp(_T("Write %s"), path);
+    LatencyTrace::Dump(path);
+    LatencyTrace::Disable();
+  }
+
   NMEALogger::Shutdown();
 
   delete replay;
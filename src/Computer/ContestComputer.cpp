@@ -25,11 +25,38 @@ Copyright_License {
 #include "ComputerSettings.hpp"
 #include "NMEA/Derived.hpp"
 
+/**
+ * Adapter which runs a #ContestManager::Executor::Job on a
+ * #ThreadPool.
+ */
+class ContestPoolJob : public ThreadPool::Job {
+  ContestManager::Executor::Job &job;
+
+public:
+  ContestPoolJob(ContestManager::Executor::Job &_job):job(_job) {}
+
+  virtual void Run(unsigned begin, unsigned end) {
+    job.Run(begin, end);
+  }
+};
+
+void
+ContestComputer::PoolExecutor::Execute(Job &job, unsigned n)
+{
+  ContestPoolJob pool_job(job);
+  thread_pool.Run(pool_job, 0, n);
+}
+
 ContestComputer::ContestComputer(const Trace &trace_full,
                                  const Trace &trace_sprint)
-  :contest_manager(OLC_Sprint, trace_full, trace_sprint)
+  :executor(ThreadPool::GetDefaultWorkerCount()),
+   contest_manager(OLC_Sprint, trace_full, trace_sprint)
 {
   contest_manager.SetIncremental(true);
+
+  if (executor.GetWorkerCount() > 0)
+    /* multi-core: solve independent contests in parallel */
+    contest_manager.SetExecutor(&executor);
 }
 
 void
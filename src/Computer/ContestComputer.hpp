@@ -25,12 +25,32 @@ Copyright_License {
 #define XCSOAR_CONTEST_COMPUTER_HPP
 
 #include "Engine/Contest/ContestManager.hpp"
+#include "Thread/ThreadPool.hpp"
 
 struct ComputerSettings;
 struct DerivedInfo;
 class Trace;
 
 class ContestComputer {
+  /**
+   * Runs independent contest solvers on a #ThreadPool, so they don't
+   * steal time from each other on multi-core hardware.
+   */
+  class PoolExecutor : public ContestManager::Executor {
+    ThreadPool thread_pool;
+
+  public:
+    explicit PoolExecutor(unsigned n_workers):thread_pool(n_workers) {}
+
+    unsigned GetWorkerCount() const {
+      return thread_pool.GetWorkerCount();
+    }
+
+    virtual void Execute(Job &job, unsigned n);
+  };
+
+  PoolExecutor executor;
+
   ContestManager contest_manager;
 
 public:
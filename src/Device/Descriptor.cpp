@@ -41,6 +41,7 @@ Copyright_License {
 #include "Asset.hpp"
 #include "Input/InputQueue.hpp"
 #include "LogFile.hpp"
+#include "LatencyTrace.hpp"
 #include "Job/Job.hpp"
 
 #ifdef ANDROID
@@ -95,6 +96,8 @@ DeviceDescriptor::DeviceDescriptor(unsigned _index)
 #endif
    ticker(false), borrowed(false)
 {
+  parsed_data.Reset();
+  receive_time = 0;
 }
 
 #if defined(__clang__) || GCC_VERSION >= 40700
@@ -122,6 +125,20 @@ DeviceDescriptor::CancelAsync()
 #pragma GCC diagnostic pop
 #endif
 
+void
+DeviceDescriptor::ResetData()
+{
+  parsed_data.Reset();
+
+  device_blackboard->mutex.Lock();
+  device_blackboard->SetRealState(index).Reset();
+  device_blackboard->mutex.Unlock();
+
+  /* replace a snapshot which may still be pending, so the
+     MergeThread does not resurrect stale data */
+  device_blackboard->PublishRealState(index, parsed_data);
+}
+
 bool
 DeviceDescriptor::Open(Port &_port, const DeviceRegister &_driver,
                        OperationEnvironment &env)
@@ -133,10 +150,7 @@ DeviceDescriptor::Open(Port &_port, const DeviceRegister &_driver,
 
   reopen_clock.Update();
 
-  device_blackboard->mutex.Lock();
-  device_blackboard->SetRealState(index).Reset();
-  device_blackboard->ScheduleMerge();
-  device_blackboard->mutex.Unlock();
+  ResetData();
 
   settings_sent.Clear();
   settings_received.Clear();
@@ -256,10 +270,7 @@ DeviceDescriptor::Close()
   pipe_to_device = NULL;
   ticker = false;
 
-  device_blackboard->mutex.Lock();
-  device_blackboard->SetRealState(index).Reset();
-  device_blackboard->ScheduleMerge();
-  device_blackboard->mutex.Unlock();
+  ResetData();
 
   settings_sent.Clear();
   settings_received.Clear();
@@ -378,15 +389,13 @@ DeviceDescriptor::IsAlive() const
 }
 
 bool
-DeviceDescriptor::ParseNMEA(const char *line, NMEAInfo &info)
+DeviceDescriptor::ParseNMEA(const NMEASentence &sentence, NMEAInfo &info)
 {
-  assert(line != NULL);
-
   /* restore the driver's ExternalSettings */
   const ExternalSettings old_settings = info.settings;
   info.settings = settings_received;
 
-  if (device != NULL && device->ParseNMEA(line, info)) {
+  if (device != NULL && device->ParseSentence(sentence, info)) {
     info.alive.Update(info.clock);
 
     if (!config.sync_from_device)
@@ -396,6 +405,8 @@ DeviceDescriptor::ParseNMEA(const char *line, NMEAInfo &info)
        sent to the device */
     const ExternalSettings old_received = settings_received;
     settings_received = info.settings;
+
+    ScopeLock protect(settings_mutex);
     info.settings.EliminateRedundant(settings_sent, old_received);
 
     return true;
@@ -406,7 +417,7 @@ DeviceDescriptor::ParseNMEA(const char *line, NMEAInfo &info)
   info.settings = old_settings;
 
   // Additional "if" to find GPS strings
-  if (parser.ParseLine(line, info)) {
+  if (parser.ParseLine(sentence, info)) {
     info.alive.Update(fixed(MonotonicClockMS()) / 1000);
     return true;
   }
@@ -455,10 +466,10 @@ DeviceDescriptor::PutMacCready(fixed value, OperationEnvironment &env)
   if (!device->PutMacCready(value, env))
     return false;
 
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
+  ScopeLock protect(settings_mutex);
+  const fixed clock = fixed(MonotonicClockMS()) / 1000;
   settings_sent.mac_cready = value;
-  settings_sent.mac_cready_available.Update(basic.clock);
+  settings_sent.mac_cready_available.Update(clock);
 
   return true;
 }
@@ -478,10 +489,10 @@ DeviceDescriptor::PutBugs(fixed value, OperationEnvironment &env)
   if (!device->PutBugs(value, env))
     return false;
 
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
+  ScopeLock protect(settings_mutex);
+  const fixed clock = fixed(MonotonicClockMS()) / 1000;
   settings_sent.bugs = value;
-  settings_sent.bugs_available.Update(basic.clock);
+  settings_sent.bugs_available.Update(clock);
 
   return true;
 }
@@ -503,12 +514,12 @@ DeviceDescriptor::PutBallast(fixed fraction, fixed overload,
   if (!device->PutBallast(fraction, overload, env))
     return false;
 
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
+  ScopeLock protect(settings_mutex);
+  const fixed clock = fixed(MonotonicClockMS()) / 1000;
   settings_sent.ballast_fraction = fraction;
-  settings_sent.ballast_fraction_available.Update(basic.clock);
+  settings_sent.ballast_fraction_available.Update(clock);
   settings_sent.ballast_overload = overload;
-  settings_sent.ballast_overload_available.Update(basic.clock);
+  settings_sent.ballast_overload_available.Update(clock);
 
   return true;
 }
@@ -573,10 +584,10 @@ DeviceDescriptor::PutQNH(const AtmosphericPressure &value,
   if (!device->PutQNH(value, env))
     return false;
 
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
+  ScopeLock protect(settings_mutex);
+  const fixed clock = fixed(MonotonicClockMS()) / 1000;
   settings_sent.qnh = value;
-  settings_sent.qnh_available.Update(basic.clock);
+  settings_sent.qnh_available.Update(clock);
 
   return true;
 }
@@ -704,12 +715,11 @@ DeviceDescriptor::OnSysTicker(const DerivedInfo &calculated)
 }
 
 bool
-DeviceDescriptor::ParseLine(const char *line)
+DeviceDescriptor::ParseLine(const NMEASentence &sentence)
 {
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
-  basic.UpdateClock();
-  return ParseNMEA(line, basic);
+  parsed_data.UpdateClock();
+  parsed_data.Expire();
+  return ParseNMEA(sentence, parsed_data);
 }
 
 #if defined(__clang__) || GCC_VERSION >= 40700
@@ -745,19 +755,24 @@ DeviceDescriptor::DataReceived(const void *data, size_t length)
   if (monitor != NULL)
     monitor->DataReceived(data, length);
 
+  if (LatencyTrace::IsEnabled())
+    receive_time = MonotonicClockUS();
+
   // Pass data directly to drivers that use binary data protocols
   if (driver != NULL && device != NULL && driver->UsesRawData()) {
-    ScopeLock protect(device_blackboard->mutex);
-    NMEAInfo &basic = device_blackboard->SetRealState(index);
+    NMEAInfo &basic = parsed_data;
     basic.UpdateClock();
+    basic.Expire();
 
     const ExternalSettings old_settings = basic.settings;
+    const Validity old_location = basic.location_available;
 
     if (device->DataReceived(data, length, basic)) {
       if (!config.sync_from_device)
         basic.settings = old_settings;
 
-      device_blackboard->ScheduleMerge();
+      TraceFix(old_location);
+      device_blackboard->PublishRealState(index, basic);
     }
 
     return;
@@ -767,9 +782,11 @@ DeviceDescriptor::DataReceived(const void *data, size_t length)
 }
 
 void
-DeviceDescriptor::LineReceived(const char *line)
+DeviceDescriptor::SentenceReceived(const NMEASentence &sentence)
 {
-  NMEALogger::Log(line);
+  const char *line = sentence.line;
+
+  NMEALogger::Log(index, line);
 
   if (pipe_to_device && pipe_to_device->port) {
     // stream pipe, pass nmea to other device (NmeaOut)
@@ -778,6 +795,21 @@ DeviceDescriptor::LineReceived(const char *line)
     pipe_to_device->port->Write("\r\n");
   }
 
-  if (ParseLine(line))
-    device_blackboard->ScheduleMerge();
+  const Validity old_location = parsed_data.location_available;
+
+  if (ParseLine(sentence)) {
+    TraceFix(old_location);
+    device_blackboard->PublishRealState(index, parsed_data);
+  }
+}
+
+void
+DeviceDescriptor::TraceFix(const Validity &old_location) const
+{
+  if (LatencyTrace::IsEnabled() &&
+      parsed_data.location_available.Modified(old_location)) {
+    LatencyTrace::Record(LatencyTrace::RECEIVED, parsed_data.time,
+                         receive_time);
+    LatencyTrace::Record(LatencyTrace::PARSED, parsed_data.time);
+  }
 }
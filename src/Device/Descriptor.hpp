@@ -29,16 +29,17 @@ Copyright_License {
 #include "Device/Parser.hpp"
 #include "Profile/DeviceConfig.hpp"
 #include "RadioFrequency.hpp"
+#include "NMEA/Info.hpp"
 #include "NMEA/ExternalSettings.hpp"
 #include "PeriodClock.hpp"
 #include "Job/Async.hpp"
 #include "Thread/Notify.hpp"
+#include "Thread/Mutex.hpp"
 
 #include <assert.h>
 #include <tchar.h>
 #include <stdio.h>
 
-struct NMEAInfo;
 struct DerivedInfo;
 struct Declaration;
 struct Waypoint;
@@ -87,6 +88,27 @@ class DeviceDescriptor : private Notify, private PortLineHandler {
 
   NMEAParser parser;
 
+  /**
+   * The data parsed from this device.  It is only accessed by the
+   * port thread (or while the port thread is not running), and
+   * copies are passed to the DeviceBlackboard with
+   * DeviceBlackboard::PublishRealState(), so parsing a line does not
+   * need to lock the blackboard.
+   */
+  NMEAInfo parsed_data;
+
+  /**
+   * The time when the data being parsed was received [us].  Only
+   * set while the #LatencyTrace is enabled.
+   */
+  uint64_t receive_time;
+
+  /**
+   * Protects #settings_sent, which is written by the main thread
+   * and read by the port thread.
+   */
+  Mutex settings_mutex;
+
   /**
    * The settings that were sent to the device.  This is used to check
    * if the device is sending back the new configuration; then the
@@ -287,7 +309,7 @@ public:
   bool IsAlive() const;
 
 private:
-  bool ParseNMEA(const char *line, struct NMEAInfo &info);
+  bool ParseNMEA(const NMEASentence &sentence, struct NMEAInfo &info);
 
 public:
   void SetMonitor(Port::Handler *_monitor) {
@@ -331,7 +353,19 @@ public:
   void OnSysTicker(const DerivedInfo &calculated);
 
 private:
-  bool ParseLine(const char *line);
+  /**
+   * Clear all data received from this device, both locally and in
+   * the DeviceBlackboard.  Must not be called while the port thread
+   * is running.
+   */
+  void ResetData();
+
+  bool ParseLine(const NMEASentence &sentence);
+
+  /**
+   * Record the #LatencyTrace events of a new fix in #parsed_data.
+   */
+  void TraceFix(const Validity &old_location) const;
 
   /* virtual methods from class Notify */
   virtual void OnNotification();
@@ -339,8 +373,8 @@ private:
   /* virtual methods from Port::Handler */
   virtual void DataReceived(const void *data, size_t length);
 
-  /* virtual methods from PortLineHandler */
-  virtual void LineReceived(const char *line);
+  /* virtual methods from NMEASentenceHandler */
+  virtual void SentenceReceived(const NMEASentence &sentence);
 };
 
 #endif
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Device/Driver.hpp"
+#include "NMEA/Sentence.hpp"
 
 Device::~Device() {}
 
@@ -42,6 +43,13 @@ AbstractDevice::ParseNMEA(const char *line, struct NMEAInfo &info)
   return false;
 }
 
+bool
+AbstractDevice::ParseSentence(const NMEASentence &sentence,
+                              struct NMEAInfo &info)
+{
+  return ParseNMEA(sentence.line, info);
+}
+
 bool
 AbstractDevice::PutMacCready(fixed MacCready, OperationEnvironment &env)
 {
@@ -33,6 +33,7 @@ Copyright_License {
 #include <stdint.h>
 
 struct NMEAInfo;
+struct NMEASentence;
 struct DerivedInfo;
 struct DeviceConfig;
 struct Waypoint;
@@ -112,6 +113,17 @@ public:
    */
   virtual bool ParseNMEA(const char *line, struct NMEAInfo &info) = 0;
 
+  /**
+   * Parse a line which has been dissected by SplitNMEA() already.
+   * Drivers which implement this can skip fields without searching
+   * for commas, and use the verified checksum.
+   *
+   * @param info destination for sensor values
+   * @return true when the line has been processed
+   */
+  virtual bool ParseSentence(const NMEASentence &sentence,
+                             struct NMEAInfo &info) = 0;
+
   /**
    * Send the new MacCready value to the device.
    *
@@ -243,6 +255,12 @@ public:
 
   virtual bool ParseNMEA(const char *line, struct NMEAInfo &info);
 
+  /**
+   * Passes the line to ParseNMEA().
+   */
+  virtual bool ParseSentence(const NMEASentence &sentence,
+                             struct NMEAInfo &info);
+
   virtual bool PutMacCready(fixed MacCready, OperationEnvironment &env);
   virtual bool PutBugs(fixed bugs, OperationEnvironment &env);
   virtual bool PutBallast(fixed fraction, fixed overload,
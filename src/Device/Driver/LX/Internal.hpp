@@ -61,6 +61,8 @@ public:
   virtual bool EnableNMEA(OperationEnvironment &env);
 
   virtual bool ParseNMEA(const char *line, struct NMEAInfo &info);
+  virtual bool ParseSentence(const NMEASentence &sentence,
+                             struct NMEAInfo &info);
 
   virtual bool PutBallast(fixed fraction, fixed overload,
                           OperationEnvironment &env);
@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Internal.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/Sentence.hpp"
 #include "NMEA/Info.hpp"
 #include "Engine/Navigation/SpeedVector.hpp"
 #include "Units/System.hpp"
@@ -152,7 +153,15 @@ LXWP3(gcc_unused NMEAInputLine &line, gcc_unused NMEAInfo &info)
 bool
 LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
 {
-  NMEAInputLine line(String);
+  NMEASentence sentence;
+  sentence.Parse(String);
+  return ParseSentence(sentence, info);
+}
+
+bool
+LXDevice::ParseSentence(const NMEASentence &sentence, NMEAInfo &info)
+{
+  NMEAInputLine line(sentence);
   char type[16];
   line.read(type, 16);
 
@@ -26,6 +26,7 @@ Copyright_License {
 #include "Input/InputQueue.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/Sentence.hpp"
 #include "Compiler.h"
 #include "Util/Macros.hpp"
 
@@ -278,7 +279,15 @@ PDTSM(NMEAInputLine &line, gcc_unused NMEAInfo &info)
 bool
 VegaDevice::ParseNMEA(const char *String, NMEAInfo &info)
 {
-  NMEAInputLine line(String);
+  NMEASentence sentence;
+  sentence.Parse(String);
+  return ParseSentence(sentence, info);
+}
+
+bool
+VegaDevice::ParseSentence(const NMEASentence &sentence, NMEAInfo &info)
+{
+  NMEAInputLine line(sentence);
   char type[16];
   line.read(type, 16);
 
@@ -30,6 +30,7 @@ Copyright_License {
 #include "NMEA/Info.hpp"
 #include "NMEA/Checksum.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/Sentence.hpp"
 #include "StringUtil.hpp"
 #include "Compatibility/string.h" /* for _ttoi() */
 #include "Units/System.hpp"
@@ -63,16 +64,27 @@ NMEAParser::Reset()
 
 bool
 NMEAParser::ParseLine(const char *string, NMEAInfo &info)
+{
+  if (string[0] != '$')
+    return false;
+
+  NMEASentence sentence;
+  sentence.Parse(string);
+  return ParseLine(sentence, info);
+}
+
+bool
+NMEAParser::ParseLine(const NMEASentence &sentence, NMEAInfo &info)
 {
   assert(positive(info.clock));
 
-  if (string[0] != '$')
+  if (sentence.line[0] != '$')
     return false;
 
-  if (!ignore_checksum && !NMEAChecksum(string))
+  if (!ignore_checksum && !sentence.checksum_valid)
     return false;
 
-  NMEAInputLine line(string);
+  NMEAInputLine line(sentence);
 
   char type[16];
   line.read(type, 16);
@@ -28,6 +28,7 @@ Copyright_License {
 
 struct FlarmState;
 struct NMEAInfo;
+struct NMEASentence;
 struct BrokenDateTime;
 class NMEAInputLine;
 struct GeoPoint;
@@ -71,6 +72,11 @@ public:
    */
   bool ParseLine(const char *line, NMEAInfo &info);
 
+  /**
+   * Parses a line which has been dissected by SplitNMEA() already.
+   */
+  bool ParseLine(const NMEASentence &sentence, NMEAInfo &info);
+
 public:
   /**
    * Calculates the checksum of the provided NMEA string and
@@ -22,7 +22,6 @@ Copyright_License {
 */
 
 #include "LineHandler.hpp"
-#include "Util/CharUtil.hpp"
 
 #include <string.h>
 
@@ -48,27 +47,10 @@ PortLineHandler::DataReceived(const void *_data, size_t length)
     data += nbytes;
     buffer.Append(nbytes);
 
-    while (true) {
-      /* read data from the buffer, to see if there's a newline
-         character */
-      range = buffer.Read();
-      if (range.IsEmpty())
-        break;
-
-      char *newline = (char *)memchr(range.data, '\n', range.length);
-      if (newline == NULL)
-        /* no newline here: wait for more data */
-        break;
-
-      /* remove trailing whitespace, such as '\r' */
-      char *end = newline;
-      while (end > range.data && IsWhitespaceOrNull(end[-1]))
-        --end;
-
-      *end = '\0';
-      LineReceived(range.data);
-
-      buffer.Consume(newline - range.data + 1);
-    }
+    /* pass all complete lines in the buffer to the handler; an
+       incomplete line remains there until more data arrives */
+    range = buffer.Read();
+    if (!range.IsEmpty())
+      buffer.Consume(SplitNMEA(range.data, range.length, *this));
   } while (data < end);
 }
@@ -26,15 +26,21 @@ Copyright_License {
 
 #include "Port.hpp"
 #include "FifoBuffer.hpp"
-
-class PortLineHandler : protected Port::Handler {
+#include "NMEA/Sentence.hpp"
+
+/**
+ * Splits the data received from a port into lines, and passes them
+ * to NMEASentenceHandler::SentenceReceived(), dissected by
+ * SplitNMEA().
+ */
+class PortLineHandler
+  : protected Port::Handler, protected NMEASentenceHandler {
   typedef FifoBuffer<char, 256u> Buffer;
 
   Buffer buffer;
 
 protected:
   virtual void DataReceived(const void *data, size_t length);
-  virtual void LineReceived(const char *line) = 0;
 };
 
 #endif
@@ -30,6 +30,8 @@ Copyright_License {
 #include "Replay/Replay.hpp"
 #include "DataField/FileReader.hpp"
 #include "DataField/Float.hpp"
+#include "DataField/Boolean.hpp"
+#include "DataField/Integer.hpp"
 
 static WndForm *wf = NULL;
 
@@ -73,10 +75,42 @@ OnRateData(DataField *Sender, DataField::DataAccessMode Mode)
   }
 }
 
+static void
+OnTimeWarpData(DataField *Sender, DataField::DataAccessMode Mode)
+{
+  DataFieldBoolean &df = *(DataFieldBoolean *)Sender;
+
+  switch (Mode) {
+  case DataField::daChange:
+    replay->SetTimeWarp(df.GetAsBoolean(), replay->GetRedrawInterval());
+    break;
+
+  case DataField::daSpecial:
+    return;
+  }
+}
+
+static void
+OnRedrawIntervalData(DataField *Sender, DataField::DataAccessMode Mode)
+{
+  DataFieldInteger &df = *(DataFieldInteger *)Sender;
+
+  switch (Mode) {
+  case DataField::daChange:
+    replay->SetTimeWarp(replay->GetTimeWarp(), df.GetAsInteger() * 1000);
+    break;
+
+  case DataField::daSpecial:
+    return;
+  }
+}
+
 static gcc_constexpr_data CallBackTableEntry CallBackTable[] = {
   DeclareCallBackEntry(OnStopClicked),
   DeclareCallBackEntry(OnStartClicked),
   DeclareCallBackEntry(OnRateData),
+  DeclareCallBackEntry(OnTimeWarpData),
+  DeclareCallBackEntry(OnRedrawIntervalData),
   DeclareCallBackEntry(OnCloseClicked),
   DeclareCallBackEntry(NULL)
 };
@@ -98,11 +132,26 @@ dlgLoggerReplayShowModal()
     wp->RefreshDisplay();
   }
 
+  wp = (WndProperty*)wf->FindByName(_T("prpTimeWarp"));
+  if (wp) {
+    DataFieldBoolean &df = *(DataFieldBoolean *)wp->GetDataField();
+    df.Set(replay->GetTimeWarp());
+    wp->RefreshDisplay();
+  }
+
+  wp = (WndProperty*)wf->FindByName(_T("prpRedrawInterval"));
+  if (wp) {
+    DataFieldInteger &df = *(DataFieldInteger *)wp->GetDataField();
+    df.Set(replay->GetRedrawInterval() / 1000);
+    wp->RefreshDisplay();
+  }
+
   wp = (WndProperty*)wf->FindByName(_T("prpFile"));
   if (wp) {
     DataFieldFileReader* dfe;
     dfe = (DataFieldFileReader*)wp->GetDataField();
     dfe->ScanDirectoryTop(_T("*.nmea"));
+    dfe->ScanDirectoryTop(_T("*.ncap"));
     dfe->ScanDirectoryTop(_T("*.igc"));
     dfe->Lookup(replay->GetFilename());
     wp->RefreshDisplay();
@@ -223,6 +223,13 @@ public:
     days_of_operation = mask;
   }
 
+  /**
+   * Get the days of the week on which the airspace is active
+   */
+  const AirspaceActivity &GetDays() const {
+    return days_of_operation;
+  }
+
   /** 
    * Get type of airspace
    * 
@@ -26,7 +26,9 @@
 #include "Navigation/Flat/FlatBoundingBox.hpp"
 #include "Navigation/TaskProjection.hpp"
 #include "AirspaceIntersectSort.hpp"
+#include "Navigation/ConvexHull/PolygonInterior.hpp"
 
+#include <algorithm>
 #include <assert.h>
 
 AirspacePolygon::AirspacePolygon(const std::vector<GeoPoint> &pts,
@@ -55,6 +57,9 @@ AirspacePolygon::AirspacePolygon(const std::vector<GeoPoint> &pts,
     } else {
       m_is_convex = m_border.IsConvex();
     }
+
+    if (m_border.size() > PolygonSlabs::MIN_EDGES)
+      slabs.Build(m_border);
   }
 }
 
@@ -70,7 +75,11 @@ AirspacePolygon::GetCenter() const
 bool 
 AirspacePolygon::Inside(const GeoPoint &loc) const
 {
-  return m_border.IsInside(loc);
+  if (!slabs.IsDefined())
+    return m_border.IsInside(loc);
+
+  const auto range = slabs.Lookup(loc.latitude);
+  return PolygonInterior(loc, m_border, range.first, range.second);
 }
 
 AirspaceIntersectionVector
@@ -81,9 +90,37 @@ AirspacePolygon::Intersects(const GeoPoint &start, const GeoPoint &end) const
 
   AirspaceIntersectSort sorter(start, end, *this);
 
-  for (auto it = m_border.begin(); it + 1 != m_border.end(); ++it) {
+  if (!slabs.IsDefined()) {
+    for (auto it = m_border.begin(); it + 1 != m_border.end(); ++it) {
+
+      const FlatRay r_seg(it->get_flatLocation(), (it + 1)->get_flatLocation());
+      fixed t;
+      if (ray.IntersectsDistinct(r_seg, t))
+        sorter.add(t, m_task_projection->unproject(ray.Parametric(t)));
+    }
+
+    return sorter.all();
+  }
 
-    const FlatRay r_seg(it->get_flatLocation(), (it + 1)->get_flatLocation());
+  /* only edges which overlap the ray's latitude range can intersect
+     it; the range is widened by one flat unit to be safe against
+     rounding in the projection */
+
+  const int y_min = std::min(ray.point.Latitude,
+                             ray.point.Latitude + ray.vector.Latitude) - 1;
+  const int y_max = std::max(ray.point.Latitude,
+                             ray.point.Latitude + ray.vector.Latitude) + 1;
+  const Angle south =
+    m_task_projection->unproject(FlatGeoPoint(ray.point.Longitude, y_min)).latitude;
+  const Angle north =
+    m_task_projection->unproject(FlatGeoPoint(ray.point.Longitude, y_max)).latitude;
+
+  std::vector<unsigned> edges;
+  slabs.Collect(south, north, edges);
+
+  for (auto i = edges.begin(); i != edges.end(); ++i) {
+    const FlatRay r_seg(m_border[*i].get_flatLocation(),
+                        m_border[*i + 1].get_flatLocation());
     fixed t;
     if (ray.IntersectsDistinct(r_seg, t))
       sorter.add(t, m_task_projection->unproject(ray.Parametric(t)));
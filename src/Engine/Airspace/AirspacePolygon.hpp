@@ -24,6 +24,7 @@
 #define AIRSPACEPOLYGON_HPP
 
 #include "AbstractAirspace.hpp"
+#include "Navigation/ConvexHull/PolygonSlabs.hpp"
 #include <vector>
 
 #ifdef DO_PRINT
@@ -34,6 +35,14 @@
 class AirspacePolygon: 
   public AbstractAirspace 
 {
+  /**
+   * Edge index for large polygons, to speed up Inside() and
+   * Intersects().  It is built once by the constructor (and is
+   * therefore safe to use from concurrent readers); it is undefined
+   * for polygons with few edges, which are scanned linearly.
+   */
+  PolygonSlabs slabs;
+
 public:
   /** 
    * Constructor.  For testing, pts vector is a cloud of points,
@@ -26,6 +26,8 @@
 #include "Navigation/Aircraft.hpp"
 #include "Navigation/Geometry/GeoVector.hpp"
 
+#include <limits.h>
+
 #ifdef INSTRUMENT_TASK
 extern unsigned n_queries;
 extern long count_intersections;
@@ -40,7 +42,7 @@ public:
                                   AirspaceVisitor &_visitor)
     :predicate(&_predicate), visitor(&_visitor) {}
 
-  void operator()(Airspace as) {
+  void operator()(const Airspace &as) {
     AbstractAirspace &aas = *as.get_airspace();
     if (predicate->condition(aas))
       visitor->Visit(as);
@@ -55,10 +57,10 @@ Airspaces::visit_within_range(const GeoPoint &loc,
 {
   if (empty()) return; // nothing to do
 
-  Airspace bb_target(loc, task_projection);
-  int mrange = task_projection.project_range(loc, range);
+  const FlatBoundingBox box(task_projection.project(loc),
+                            task_projection.project_range(loc, range));
   AirspacePredicateVisitorAdapter adapter(predicate, visitor);
-  airspace_tree.visit_within_range(bb_target, -mrange, adapter);
+  airspace_tree.VisitOverlapping(box, adapter);
 
 #ifdef INSTRUMENT_TASK
   n_queries++;
@@ -77,7 +79,7 @@ public:
                                      AirspaceIntersectionVisitor &_visitor)
     :start(_loc), end(_end), ray(&_ray), visitor(&_visitor) {}
 
-  void operator()(Airspace as) {
+  void operator()(const Airspace &as) {
     if (as.intersects(*ray) &&
         visitor->set_intersections(as.Intersects(start, end)))
       visitor->Visit(as);
@@ -93,10 +95,10 @@ Airspaces::VisitIntersecting(const GeoPoint &loc, const GeoPoint &end,
   FlatRay ray(task_projection.project(loc), task_projection.project(end));
 
   const GeoPoint c = loc.Middle(end);
-  Airspace bb_target(c, task_projection);
   int mrange = task_projection.project_range(c, loc.Distance(end) / 2);
+  const FlatBoundingBox box(task_projection.project(c), mrange);
   IntersectingAirspaceVisitorAdapter adapter(loc, end, ray, visitor);
-  airspace_tree.visit_within_range(bb_target, -mrange, adapter);
+  airspace_tree.VisitOverlapping(box, adapter);
 
 #ifdef INSTRUMENT_TASK
   n_queries++;
@@ -116,6 +118,27 @@ struct AirspacePredicateAdapter {
   }
 };
 
+struct AirspaceAlwaysTrue {
+  bool operator()(const Airspace &) const {
+    return true;
+  }
+};
+
+/**
+ * Visitor for AirspaceTree::VisitOverlapping() which collects all
+ * airspaces in a vector.
+ */
+class AirspaceCollector {
+  Airspaces::AirspaceVector &vector;
+
+public:
+  AirspaceCollector(Airspaces::AirspaceVector &_vector):vector(_vector) {}
+
+  void operator()(const Airspace &as) {
+    vector.push_back(as);
+  }
+};
+
 const Airspace *
 Airspaces::find_nearest(const GeoPoint &location,
                         const AirspacePredicate &condition) const
@@ -123,11 +146,11 @@ Airspaces::find_nearest(const GeoPoint &location,
   if (empty())
     return NULL;
 
-  const Airspace bb_target(location, task_projection);
   const int mrange = task_projection.project_range(location, fixed(30000));
   const AirspacePredicateAdapter predicate(condition);
-  std::pair<AirspaceTree::const_iterator, AirspaceTree::distance_type> found =
-    airspace_tree.find_nearest_if(bb_target, BBDist(0, mrange), predicate);
+  std::pair<AirspaceTree::const_iterator, unsigned> found =
+    airspace_tree.FindNearestIf(task_projection.project(location), mrange,
+                                predicate);
 
   return found.first != airspace_tree.end()
     ? &*found.first
@@ -140,10 +163,9 @@ Airspaces::scan_nearest(const GeoPoint &location,
 {
   if (empty()) return AirspaceVector(); // nothing to do
 
-  Airspace bb_target(location, task_projection);
-
-  std::pair<AirspaceTree::const_iterator, AirspaceTree::distance_type>
-    found = airspace_tree.find_nearest(bb_target);
+  std::pair<AirspaceTree::const_iterator, unsigned> found =
+    airspace_tree.FindNearestIf(task_projection.project(location), UINT_MAX,
+                                AirspaceAlwaysTrue());
 
 #ifdef INSTRUMENT_TASK
   n_queries++;
@@ -153,7 +175,7 @@ Airspaces::scan_nearest(const GeoPoint &location,
   if (found.first != airspace_tree.end()) {
     // also should do scan_range with range = 0 since there
     // could be more than one with zero dist
-    if (found.second.is_zero()) {
+    if (found.second == 0) {
       return scan_range(location, fixed_zero, condition);
     } else {
       if (condition(*found.first->get_airspace()))
@@ -173,9 +195,11 @@ Airspaces::scan_range(const GeoPoint &location,
 
   Airspace bb_target(location, task_projection);
   int mrange = task_projection.project_range(location, range);
-  
-  std::deque< Airspace > vectors;
-  airspace_tree.find_within_range(bb_target, -mrange, std::back_inserter(vectors));
+  const FlatBoundingBox box(task_projection.project(location), mrange);
+
+  AirspaceVector vectors;
+  AirspaceCollector collector(vectors);
+  airspace_tree.VisitOverlapping(box, collector);
 
 #ifdef INSTRUMENT_TASK
   n_queries++;
@@ -201,10 +225,11 @@ const Airspaces::AirspaceVector
 Airspaces::find_inside(const AircraftState &state,
                        const AirspacePredicate &condition) const
 {
-  Airspace bb_target(state.location, task_projection);
+  const FlatBoundingBox box(task_projection.project(state.location));
 
   AirspaceVector vectors;
-  airspace_tree.find_within_range(bb_target, 0, std::back_inserter(vectors));
+  AirspaceCollector collector(vectors);
+  airspace_tree.VisitOverlapping(box, collector);
 
 #ifdef INSTRUMENT_TASK
   n_queries++;
@@ -240,14 +265,13 @@ Airspaces::optimise()
     airspace_tree.clear();
   }
 
-  if (!tmp_as.empty()) {
-    while (!tmp_as.empty()) {
-      Airspace as(*tmp_as.front(), task_projection);
-      airspace_tree.insert(as);
-      tmp_as.pop_front();
-    }
-    airspace_tree.optimise();
+  while (!tmp_as.empty()) {
+    Airspace as(*tmp_as.front(), task_projection);
+    airspace_tree.insert(as);
+    tmp_as.pop_front();
   }
+
+  airspace_tree.Optimise();
 }
 
 void 
@@ -405,17 +429,8 @@ Airspaces::synchronise_in_range(const Airspaces& master,
   // so delete them --- including the clearances!
   for (auto v = contents_self.begin(); v != contents_self.end();) {
     bool found = false;
-    for (auto t = airspace_tree.begin(); t != airspace_tree.end(); ) {
-      if (t->get_airspace() == v->get_airspace()) {
-        AirspaceTree::const_iterator new_t = t;
-        ++new_t;
-        airspace_tree.erase_exact(*t);
-        t = new_t;
-        found = true;
-      } else {
-        ++t;
-      }
-    }
+    while (airspace_tree.Remove(*v))
+      found = true;
     assert(found);
     v->clear_clearance();
     v = contents_self.erase(v);
@@ -432,9 +447,10 @@ Airspaces::visit_inside(const GeoPoint &loc,
 {
   if (empty()) return; // nothing to do
 
-  Airspace bb_target(loc, task_projection);
+  const FlatBoundingBox box(task_projection.project(loc));
   AirspaceVector vectors;
-  airspace_tree.find_within_range(bb_target, 0, std::back_inserter(vectors));
+  AirspaceCollector collector(vectors);
+  airspace_tree.VisitOverlapping(box, collector);
 
   for (auto v = vectors.begin(); v != vectors.end(); ++v) {
     if ((*v).inside(loc))
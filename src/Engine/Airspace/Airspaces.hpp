@@ -37,21 +37,21 @@ class AirspaceVisitor;
 class AirspaceIntersectionVisitor;
 
 /**
- * Container for airspaces using kd-tree representation internally for fast 
- * geospatial lookups.
+ * Container for airspaces using an STR-packed R-tree representation
+ * internally for fast geospatial lookups.
+ *
+ * Complexity analysis (with R-tree):
  *
- * Complexity analysis (with kdtree):
- *   
  *    Find within range (k points found):
- *     O(n^(3/4) + k)
+ *     O(log(n) + k) typically
  *
  *    Find intersecting:
- *     O(n^(3/4) + k)
+ *     O(log(n) + k) typically
  *
  *    Find nearest:
- *     O(log(n))
+ *     O(log(n)) typically
  *
- *  Without kd-tree:
+ *  Without R-tree:
  *
  *    Find within range:
  *     O(n)
@@ -108,8 +108,16 @@ public:
    */
   void insert(AbstractAirspace* asp);
 
-  /** 
-   * Re-organise the internal airspace tree after inserting/deleting.
+  /**
+   * Returns the airspaces which have been inserted since the last
+   * optimise() call, in the order they were inserted.
+   */
+  const std::deque<AbstractAirspace *> &GetPending() const {
+    return tmp_as;
+  }
+
+  /**
+   * Rebuild the internal airspace tree after inserting/deleting.
    * Should be called after inserting/deleting airspaces prior to performing
    * any searches, but can be done once after a batch insert/delete.
    */
@@ -28,6 +28,7 @@ ContestManager::ContestManager(const Contests _contest,
                                const Trace &trace_full,
                                const Trace &trace_sprint):
   contest(_contest),
+  executor(NULL),
   trace_full(trace_full),
   trace_sprint(trace_sprint),
   olc_sprint(trace_sprint),
@@ -96,6 +97,37 @@ ContestManager::RunContest(AbstractContest &_contest,
   return true;
 }
 
+class ContestManager::SolverJob : public Executor::Job {
+  SolverRun *runs;
+  bool exhaustive;
+
+public:
+  SolverJob(SolverRun *_runs, bool _exhaustive)
+    :runs(_runs), exhaustive(_exhaustive) {}
+
+  virtual void Run(unsigned begin, unsigned end) {
+    for (unsigned i = begin; i < end; ++i)
+      runs[i].changed = RunContest(runs[i].contest, runs[i].result,
+                                   runs[i].solution, exhaustive);
+  }
+};
+
+bool
+ContestManager::RunContests(SolverRun *runs, unsigned n, bool exhaustive)
+{
+  SolverJob job(runs, exhaustive);
+  if (executor != NULL && n > 1)
+    executor->Execute(job, n);
+  else
+    job.Run(0, n);
+
+  bool changed = false;
+  for (unsigned i = 0; i < n; ++i)
+    changed |= runs[i].changed;
+
+  return changed;
+}
+
 bool 
 ContestManager::UpdateIdle(bool exhaustive)
 {
@@ -127,16 +159,16 @@ ContestManager::UpdateIdle(bool exhaustive)
                           stats.solution[0], exhaustive);
     break;
 
-  case OLC_Plus:
-    retval = RunContest(olc_classic, stats.result[0],
-                         stats.solution[0], exhaustive);
+  case OLC_Plus: {
+    SolverRun runs[] = {
+      { olc_classic, stats.result[0], stats.solution[0], false },
+      { olc_fai, stats.result[1], stats.solution[1], false },
+    };
+
+    retval = RunContests(runs, 2, exhaustive);
 
     olc_plus.GetClassicResult() = stats.result[0];
     olc_plus.GetClassicSolution() = stats.solution[0];
-
-    retval |= RunContest(olc_fai, stats.result[1],
-                          stats.solution[1], exhaustive);
-
     olc_plus.GetFAIResult() = stats.result[1];
     olc_plus.GetFAISolution() = stats.solution[1];
 
@@ -145,20 +177,27 @@ ContestManager::UpdateIdle(bool exhaustive)
                   stats.solution[2], exhaustive);
 
     break;
+  }
 
-  case OLC_XContest:
-    retval = RunContest(olc_xcontest_free, stats.result[0],
-                         stats.solution[0], exhaustive);
-    retval |= RunContest(olc_xcontest_triangle, stats.result[1],
-                          stats.solution[1], exhaustive);
+  case OLC_XContest: {
+    SolverRun runs[] = {
+      { olc_xcontest_free, stats.result[0], stats.solution[0], false },
+      { olc_xcontest_triangle, stats.result[1], stats.solution[1], false },
+    };
+
+    retval = RunContests(runs, 2, exhaustive);
     break;
+  }
 
-  case OLC_DHVXC:
-    retval = RunContest(olc_dhvxc_free, stats.result[0],
-                         stats.solution[0], exhaustive);
-    retval |= RunContest(olc_dhvxc_triangle, stats.result[1],
-                          stats.solution[1], exhaustive);
+  case OLC_DHVXC: {
+    SolverRun runs[] = {
+      { olc_dhvxc_free, stats.result[0], stats.solution[0], false },
+      { olc_dhvxc_triangle, stats.result[1], stats.solution[1], false },
+    };
+
+    retval = RunContests(runs, 2, exhaustive);
     break;
+  }
 
   case OLC_SISAT:
     retval = RunContest(olc_sisat, stats.result[0],
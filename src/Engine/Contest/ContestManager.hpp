@@ -43,8 +43,47 @@ class ContestManager
 {
   friend class PrintHelper;
 
+public:
+  /**
+   * Runs independent solvers concurrently, e.g. on a thread pool.
+   * The engine library itself does not create threads.
+   */
+  class Executor {
+  public:
+    class Job {
+    public:
+      /**
+       * Run the solvers [begin, end).
+       */
+      virtual void Run(unsigned begin, unsigned end) = 0;
+    };
+
+    /**
+     * Run the job on the range [0, n), possibly split into several
+     * parts which run concurrently, and return when all of them are
+     * finished.
+     */
+    virtual void Execute(Job &job, unsigned n) = 0;
+  };
+
+private:
+  struct SolverRun {
+    AbstractContest &contest;
+    ContestResult &result;
+    ContestTraceVector &solution;
+    bool changed;
+  };
+
+  class SolverJob;
+
   Contests contest;
 
+  /**
+   * If not NULL, then independent solvers run in parallel on this
+   * object.
+   */
+  Executor *executor;
+
   ContestStatistics stats;
 
   const Trace &trace_full;
@@ -77,6 +116,20 @@ public:
 
   void SetIncremental(bool incremental);
 
+  /**
+   * Enable parallel solving: solvers which do not depend on each
+   * other's results (e.g. OLC-Classic and OLC-FAI for OLC-Plus) get
+   * solved concurrently.  Each solver works on its own copy of the
+   * trace, and the results are merged into #stats after all of them
+   * have finished.
+   *
+   * @param executor the object which runs the solvers, or NULL to
+   * solve sequentially
+   */
+  void SetExecutor(Executor *_executor) {
+    executor = _executor;
+  }
+
   void SetContest(Contests _contest) {
     contest = _contest;
   }
@@ -109,6 +162,14 @@ public:
 private:
   static bool RunContest(AbstractContest &_contest, ContestResult &result,
                          ContestTraceVector &solution, bool exhaustive);
+
+  /**
+   * Run several independent solvers, in parallel if an #Executor
+   * was set.
+   *
+   * @return true if one of them has changed its result
+   */
+  bool RunContests(SolverRun *runs, unsigned n, bool exhaustive);
 };
 
 #endif
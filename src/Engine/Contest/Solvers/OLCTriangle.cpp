@@ -125,8 +125,50 @@ public:
 
   gcc_pure
   Result Calculate(const SearchPoint &c, unsigned best) const;
+
+  /**
+   * Check whether any third point inside the specified box could
+   * possibly produce a result in Calculate().  This compares upper
+   * and lower bounds of the leg distances, so it may return true for
+   * boxes which contain no valid point, but never false for a box
+   * which does.
+   */
+  gcc_pure
+  bool IsFeasible(const FlatBoundingBox &box, unsigned best) const;
 };
 
+bool
+TriangleSecondLeg::IsFeasible(const FlatBoundingBox &box, unsigned best) const
+{
+  const unsigned max_2 = box.MaxDistance(b.get_flatLocation());
+  const unsigned max_3 = box.MaxDistance(a.get_flatLocation());
+  const unsigned max_total = df_1 + max_2 + max_3;
+
+  // the largest possible triangle is too small or not better than
+  // the best one
+  if (max_total < 20 || max_total <= best)
+    return false;
+
+  if (!is_fai)
+    return true;
+
+  const unsigned min_2 = box.MinDistance(b.get_flatLocation());
+  const unsigned min_3 = box.MinDistance(a.get_flatLocation());
+  const unsigned min_total = df_1 + min_2 + min_3;
+  const unsigned max_shortest = min(df_1, min(max_2, max_3));
+
+  // all points fail the 25% worst-case rule
+  if (max_shortest * 4 < min_total)
+    return false;
+
+  // all points fail the 28% rule and then the 45% worst-case rule
+  const unsigned min_longest = max(df_1, max(min_2, min_3));
+  if (max_shortest * 25 < min_total * 7 && min_longest * 20 > max_total * 9)
+    return false;
+
+  return true;
+}
+
 TriangleSecondLeg::Result
 TriangleSecondLeg::Calculate(const SearchPoint &c, unsigned best) const
 {
@@ -238,25 +280,41 @@ OLCTriangle::AddEdges(const ScanTaskPoint origin)
 
     // give first leg points to penultimate node
     TriangleSecondLeg sl(is_fai, GetPoint(previous), GetPoint(origin));
-    for (ScanTaskPoint destination(origin.GetStageNumber() + 1,
-                                   origin.GetPointIndex() + 1),
-           end(origin.GetStageNumber() + 1, n_points - 1);
-         destination != end; destination.IncrementPointIndex()) {
-      TriangleSecondLeg::Result result = sl.Calculate(GetPoint(destination),
-                                                      best_d);
-      const unsigned d = result.leg_distance;
-      if (d) {
-        best_d = result.total_distance;
 
-        Link(destination, origin, GetStageWeight(origin.GetStageNumber()) * d);
-
-        // we have an improved solution
-        is_complete = true;
+    // scan the candidates box by box, skipping boxes which cannot
+    // contain a better triangle
+    const unsigned end_index = n_points - 1;
+    for (unsigned i = origin.GetPointIndex() + 1; i < end_index;) {
+      const unsigned box_index = i / BOX_SIZE;
+      assert(box_index < boxes.size());
+      const unsigned box_end = min((box_index + 1) * BOX_SIZE, end_index);
+      if (!sl.IsFeasible(boxes[box_index], best_d)) {
+        i = box_end;
+        continue;
+      }
 
-        // need to scan again whether path is closed
-        is_closed = false;
-        first_tp = origin.GetPointIndex();
+      for (ScanTaskPoint destination(origin.GetStageNumber() + 1, i),
+             end(origin.GetStageNumber() + 1, box_end);
+           destination != end; destination.IncrementPointIndex()) {
+        TriangleSecondLeg::Result result = sl.Calculate(GetPoint(destination),
+                                                        best_d);
+        const unsigned d = result.leg_distance;
+        if (d) {
+          best_d = result.total_distance;
+
+          Link(destination, origin,
+               GetStageWeight(origin.GetStageNumber()) * d);
+
+          // we have an improved solution
+          is_complete = true;
+
+          // need to scan again whether path is closed
+          is_closed = false;
+          first_tp = origin.GetPointIndex();
+        }
       }
+
+      i = box_end;
     }
   }
     break;
@@ -301,6 +359,16 @@ OLCTriangle::CalcScore() const
 void
 OLCTriangle::StartSearch()
 {
+  boxes.clear();
+  boxes.reserve((n_points + BOX_SIZE - 1) / BOX_SIZE);
+
+  for (unsigned i = 0; i < n_points; ++i) {
+    const FlatGeoPoint &location = GetPoint(i).get_flatLocation();
+    if (i % BOX_SIZE == 0)
+      boxes.push_back(FlatBoundingBox(location));
+    else
+      boxes.back().Expand(location);
+  }
 }
 
 
@@ -24,6 +24,9 @@
 #define OLC_TRIANGLE_HPP
 
 #include "ContestDijkstra.hpp"
+#include "Navigation/Flat/FlatBoundingBox.hpp"
+
+#include <vector>
 
 /**
  * Specialisation of OLC Dijkstra for OLC Triangle (triangle) rules
@@ -38,6 +41,20 @@ protected:
   unsigned best_d;
   bool is_fai;
 
+  /**
+   * Number of consecutive trace points which share one entry in
+   * #boxes.
+   */
+  static const unsigned BOX_SIZE = 16;
+
+  /**
+   * The bounding boxes of consecutive runs of #BOX_SIZE trace
+   * points, built by StartSearch().  AddEdges() skips all candidates
+   * in a box if no point inside it can beat the best triangle found
+   * so far, or if none can satisfy the FAI leg rules.
+   */
+  std::vector<FlatBoundingBox> boxes;
+
 public:
   OLCTriangle(const Trace &_trace,
               const bool _is_fai=true);
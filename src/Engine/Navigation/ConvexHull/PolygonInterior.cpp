@@ -21,6 +21,8 @@
  */
 #include "PolygonInterior.hpp"
 
+#include <assert.h>
+
 // Copyright 2001, softSurfer (www.softsurfer.com)
 // This code may be freely used and modified for any purpose
 // providing that this copyright notice is included with it.
@@ -58,6 +60,27 @@ isLeft( const FlatGeoPoint &P0, const FlatGeoPoint &P1, const FlatGeoPoint &P2 )
   return 0;
 }
 
+/**
+ * The contribution of the edge from V[i] to V[i+1] to the winding
+ * number of P.
+ */
+inline static int
+WindingNumber(const GeoPoint &P, const std::vector<SearchPoint>& V,
+              unsigned i)
+{
+  if (V[i].get_location().latitude <= P.latitude) {         // start y <= P.Latitude
+    if (V[i+1].get_location().latitude > P.latitude)      // an upward crossing
+      if (isLeft( V[i].get_location(), V[i+1].get_location(), P)>0)  // P left of edge
+        return 1;            // have a valid up intersect
+  }
+  else {                       // start y > P.Latitude (no test needed)
+    if (V[i+1].get_location().latitude <= P.latitude)     // a downward crossing
+      if (isLeft( V[i].get_location(), V[i+1].get_location(), P)<0)  // P right of edge
+        return -1;            // have a valid down intersect
+  }
+  return 0;
+}
+
 //===================================================================
 
 // PolygonInterior(): winding number interior test for a point in a polygon
@@ -76,21 +99,29 @@ PolygonInterior( const GeoPoint &P, const std::vector<SearchPoint>& V)
   int    wn = 0;    // the winding number counter
 
   // loop through all edges of the polygon
-  for (int i=0; i<n; ++i) {   // edge from V[i] to V[i+1]
-    if (V[i].get_location().latitude <= P.latitude) {         // start y <= P.Latitude
-      if (V[i+1].get_location().latitude > P.latitude)      // an upward crossing
-        if (isLeft( V[i].get_location(), V[i+1].get_location(), P)>0)  // P left of edge
-          ++wn;            // have a valid up intersect
-    }
-    else {                       // start y > P.Latitude (no test needed)
-      if (V[i+1].get_location().latitude <= P.latitude)     // a downward crossing
-        if (isLeft( V[i].get_location(), V[i+1].get_location(), P)<0)  // P right of edge
-          --wn;            // have a valid down intersect
-    }
-  }
+  for (int i=0; i<n; ++i)   // edge from V[i] to V[i+1]
+    wn += WindingNumber(P, V, i);
+
   return wn != 0;
 }
 
+bool
+PolygonInterior(const GeoPoint &P, const std::vector<SearchPoint>& V,
+                const unsigned *edges, const unsigned *edges_end)
+{
+  if (V.size()<3) {
+    return false;
+  }
+
+  int    wn = 0;    // the winding number counter
+
+  for (; edges != edges_end; ++edges) {
+    assert(*edges + 1 < V.size());
+    wn += WindingNumber(P, V, *edges);
+  }
+
+  return wn != 0;
+}
 
 bool
 PolygonInterior( const FlatGeoPoint &P, const std::vector<SearchPoint>& V)
@@ -33,6 +33,16 @@
 gcc_pure bool
 PolygonInterior( const GeoPoint &P, const std::vector<SearchPoint>& V);
 
+/**
+ * Like PolygonInterior(), but only evaluates the specified edges
+ * (edge i connects V[i] and V[i+1]).  The list must include every
+ * edge which crosses the latitude of P, e.g. obtained from
+ * PolygonSlabs::Lookup().
+ */
+gcc_pure bool
+PolygonInterior(const GeoPoint &P, const std::vector<SearchPoint>& V,
+                const unsigned *edges, const unsigned *edges_end);
+
 gcc_pure bool
 PolygonInterior( const FlatGeoPoint &P, const std::vector<SearchPoint>& V);
 
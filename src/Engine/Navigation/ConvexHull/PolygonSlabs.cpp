@@ -0,0 +1,136 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+#include "PolygonSlabs.hpp"
+#include "Navigation/SearchPoint.hpp"
+
+#include <algorithm>
+#include <assert.h>
+
+/**
+ * The upper limit for the number of slabs; more slabs would make
+ * long edges (which are listed in every slab they span) expensive.
+ */
+static const unsigned MAX_SLABS = 1024;
+
+unsigned
+PolygonSlabs::FindSlab(Angle latitude) const
+{
+  assert(IsDefined());
+
+  const unsigned n_slabs = offsets.size() - 1;
+  const fixed f = (latitude - south).Native() * scale;
+  if (!positive(f))
+    return 0;
+
+  return std::min(unsigned(f), n_slabs - 1);
+}
+
+void
+PolygonSlabs::Build(const std::vector<SearchPoint> &border)
+{
+  Clear();
+
+  if (border.size() < 2)
+    return;
+
+  const unsigned n_edges = border.size() - 1;
+
+  south = north = border.front().get_location().latitude;
+  for (auto it = border.begin(); it != border.end(); ++it) {
+    const Angle latitude = it->get_location().latitude;
+    if (latitude < south)
+      south = latitude;
+    if (latitude > north)
+      north = latitude;
+  }
+
+  const unsigned n_slabs = std::max(1u, std::min(n_edges / 4, MAX_SLABS));
+  const fixed height = (north - south).Native();
+  scale = positive(height) ? fixed(n_slabs) / height : fixed_zero;
+
+  /* first pass: count the edges in each slab, shifted by one so the
+     prefix sum below turns the counts into start offsets */
+
+  offsets.assign(n_slabs + 1, 0);
+  first_slabs.resize(n_edges);
+  std::vector<unsigned> last_slabs(n_edges);
+
+  for (unsigned i = 0; i < n_edges; ++i) {
+    const Angle a = border[i].get_location().latitude;
+    const Angle b = border[i + 1].get_location().latitude;
+    first_slabs[i] = FindSlab(std::min(a, b));
+    last_slabs[i] = FindSlab(std::max(a, b));
+    for (unsigned s = first_slabs[i]; s <= last_slabs[i]; ++s)
+      ++offsets[s + 1];
+  }
+
+  for (unsigned s = 1; s <= n_slabs; ++s)
+    offsets[s] += offsets[s - 1];
+
+  /* second pass: fill in the edge numbers; iterating in edge order
+     keeps each slab sorted */
+
+  edges.resize(offsets.back());
+  std::vector<unsigned> fill(offsets.begin(), offsets.end() - 1);
+
+  for (unsigned i = 0; i < n_edges; ++i)
+    for (unsigned s = first_slabs[i]; s <= last_slabs[i]; ++s)
+      edges[fill[s]++] = i;
+}
+
+std::pair<const unsigned *, const unsigned *>
+PolygonSlabs::Lookup(Angle latitude) const
+{
+  assert(IsDefined());
+
+  if (latitude < south || latitude > north)
+    return std::make_pair((const unsigned *)NULL, (const unsigned *)NULL);
+
+  const unsigned s = FindSlab(latitude);
+  const unsigned *data = edges.empty() ? NULL : &edges.front();
+  return std::make_pair(data + offsets[s], data + offsets[s + 1]);
+}
+
+void
+PolygonSlabs::Collect(Angle min_latitude, Angle max_latitude,
+                      std::vector<unsigned> &dest) const
+{
+  assert(IsDefined());
+
+  dest.clear();
+
+  if (max_latitude < south || min_latitude > north)
+    return;
+
+  const unsigned first = FindSlab(min_latitude);
+  const unsigned last = FindSlab(max_latitude);
+
+  dest.insert(dest.end(), edges.begin() + offsets[first],
+              edges.begin() + offsets[first + 1]);
+
+  /* edges spanning several slabs are listed in each of them; in the
+     following slabs, report only those which begin there */
+  for (unsigned s = first + 1; s <= last; ++s)
+    for (unsigned j = offsets[s], end = offsets[s + 1]; j != end; ++j)
+      if (first_slabs[edges[j]] == s)
+        dest.push_back(edges[j]);
+}
@@ -0,0 +1,112 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+#ifndef POLYGON_SLABS_HPP
+#define POLYGON_SLABS_HPP
+
+#include "Math/Angle.hpp"
+#include "Compiler.h"
+
+#include <vector>
+#include <utility>
+
+class SearchPoint;
+
+/**
+ * An index of the edges of a closed polygon, which divides the
+ * polygon's latitude range into horizontal slabs of equal height.
+ * Each slab lists the edges whose latitude span overlaps it, so
+ * point-in-polygon and intersection tests only need to look at a
+ * small subset of the edges.
+ *
+ * The index is built on geographic coordinates, so it stays valid
+ * when the polygon is projected again.
+ */
+class PolygonSlabs {
+  Angle south, north;
+
+  /** number of slabs per (native) unit of latitude */
+  fixed scale;
+
+  /**
+   * Index into #edges where each slab begins; the last element is
+   * the total number of entries.
+   */
+  std::vector<unsigned> offsets;
+
+  /**
+   * The edge numbers of all slabs, in ascending order within each
+   * slab.  Edge i connects vertex i and vertex i+1.
+   */
+  std::vector<unsigned> edges;
+
+  /**
+   * The first slab of each edge.  Collect() uses this to report edges
+   * spanning several slabs only once.
+   */
+  std::vector<unsigned> first_slabs;
+
+public:
+  /**
+   * Polygons with fewer edges than this are not worth indexing.
+   */
+  static const unsigned MIN_EDGES = 32;
+
+  gcc_pure
+  bool IsDefined() const {
+    return !offsets.empty();
+  }
+
+  void Clear() {
+    offsets.clear();
+    edges.clear();
+    first_slabs.clear();
+  }
+
+  /**
+   * Build the index for a closed polygon (first and last vertex are
+   * the same).
+   */
+  void Build(const std::vector<SearchPoint> &border);
+
+  /**
+   * Returns the edges which may cross the specified latitude, in
+   * ascending order.  The range is empty if the latitude is outside
+   * of the polygon.
+   */
+  gcc_pure
+  std::pair<const unsigned *, const unsigned *>
+  Lookup(Angle latitude) const;
+
+  /**
+   * Collect the edges which may overlap the specified latitude range
+   * into the given vector, without duplicates.  The order is
+   * unspecified.
+   */
+  void Collect(Angle min_latitude, Angle max_latitude,
+               std::vector<unsigned> &dest) const;
+
+private:
+  gcc_pure
+  unsigned FindSlab(Angle latitude) const;
+};
+
+#endif
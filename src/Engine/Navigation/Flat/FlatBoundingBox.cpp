@@ -41,6 +41,26 @@ FlatBoundingBox::Distance(const FlatBoundingBox &f) const
   return ihypot(dx, dy);
 }
 
+unsigned
+FlatBoundingBox::MinDistance(const FlatGeoPoint &p) const
+{
+  int dx = max(0, max(bb_ll.Longitude - p.Longitude,
+                      p.Longitude - bb_ur.Longitude));
+  int dy = max(0, max(bb_ll.Latitude - p.Latitude,
+                      p.Latitude - bb_ur.Latitude));
+
+  return ihypot(dx, dy);
+}
+
+unsigned
+FlatBoundingBox::MaxDistance(const FlatGeoPoint &p) const
+{
+  int dx = max(p.Longitude - bb_ll.Longitude, bb_ur.Longitude - p.Longitude);
+  int dy = max(p.Latitude - bb_ll.Latitude, bb_ur.Latitude - p.Latitude);
+
+  return ihypot(dx, dy);
+}
+
 bool
 FlatBoundingBox::Intersects(const FlatRay& ray) const
 {
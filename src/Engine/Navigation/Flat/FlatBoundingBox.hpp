@@ -77,6 +77,30 @@ public:
   gcc_pure
   unsigned Distance(const FlatBoundingBox &f) const;
 
+  /**
+   * Calculate the distance from a point to the nearest point of this
+   * box.  This is a lower bound for the distance to any point inside
+   * the box.
+   *
+   * @param p The point
+   *
+   * @return Distance in projected units (or zero if inside)
+   */
+  gcc_pure
+  unsigned MinDistance(const FlatGeoPoint &p) const;
+
+  /**
+   * Calculate the distance from a point to the furthest corner of
+   * this box.  This is an upper bound for the distance to any point
+   * inside the box.
+   *
+   * @param p The point
+   *
+   * @return Distance in projected units
+   */
+  gcc_pure
+  unsigned MaxDistance(const FlatGeoPoint &p) const;
+
   /**
    * Test whether a point is inside the bounding box
    *
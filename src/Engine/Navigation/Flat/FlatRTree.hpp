@@ -0,0 +1,248 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+#ifndef FLATRTREE_HPP
+#define FLATRTREE_HPP
+
+#include "FlatBoundingBox.hpp"
+#include "Util/STRTree.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <limits.h>
+#include <assert.h>
+
+/**
+ * A static R-tree of objects derived from #FlatBoundingBox.  The
+ * tree is bulk loaded with the sort-tile-recursive (STR) algorithm
+ * (see #STRTreeBuilder) in Optimise().  This gives full, well
+ * separated nodes even with many large overlapping boxes, but the
+ * tree cannot be modified incrementally.
+ *
+ * Values added with insert() or removed with Remove() invalidate
+ * the tree until Optimise() is called again.  Until then, queries
+ * fall back to a linear scan.
+ */
+template<typename T, unsigned NODE_SIZE=16>
+class FlatRTree {
+public:
+  typedef typename std::vector<T>::size_type size_type;
+  typedef typename std::vector<T>::const_iterator const_iterator;
+
+private:
+  /**
+   * An inner node.  It covers the entries
+   * [first, first + count) of #values if it is a leaf node, and of
+   * #nodes otherwise.
+   */
+  struct Node : public FlatBoundingBox {
+    unsigned first, count;
+
+    Node(const FlatBoundingBox &box, unsigned _first)
+      :FlatBoundingBox(box), first(_first), count(1) {}
+  };
+
+  struct CompareLongitude {
+    bool operator()(const FlatBoundingBox &a,
+                    const FlatBoundingBox &b) const {
+      return a.GetCenter().Longitude < b.GetCenter().Longitude;
+    }
+  };
+
+  struct CompareLatitude {
+    bool operator()(const FlatBoundingBox &a,
+                    const FlatBoundingBox &b) const {
+      return a.GetCenter().Latitude < b.GetCenter().Latitude;
+    }
+  };
+
+  typedef STRTreeBuilder<Node, CompareLongitude, CompareLatitude,
+                         NODE_SIZE> Builder;
+
+  std::vector<T> values;
+
+  /**
+   * All nodes of the tree, level by level.  The leaf nodes come
+   * first, and the last one is the root.  Empty if the tree has not
+   * been built.
+   */
+  std::vector<Node> nodes;
+
+  /**
+   * The number of leaf nodes at the beginning of #nodes.
+   */
+  unsigned n_leaves;
+
+public:
+  FlatRTree():n_leaves(0) {}
+
+  size_type size() const {
+    return values.size();
+  }
+
+  bool empty() const {
+    return values.empty();
+  }
+
+  const_iterator begin() const {
+    return values.begin();
+  }
+
+  const_iterator end() const {
+    return values.end();
+  }
+
+  void clear() {
+    values.clear();
+    nodes.clear();
+    n_leaves = 0;
+  }
+
+  /**
+   * Add a value.  Call Optimise() after a batch of insertions.
+   */
+  void insert(const T &value) {
+    values.push_back(value);
+    nodes.clear();
+  }
+
+  /**
+   * Remove the first value which equals the specified one.  Call
+   * Optimise() after a batch of removals.
+   *
+   * @return true if a value was removed
+   */
+  bool Remove(const T &value) {
+    typename std::vector<T>::iterator i =
+      std::find(values.begin(), values.end(), value);
+    if (i == values.end())
+      return false;
+
+    values.erase(i);
+    nodes.clear();
+    return true;
+  }
+
+  /**
+   * (Re-)build the tree if values have been added or removed since
+   * the last call.
+   */
+  void Optimise() {
+    if (!nodes.empty() || values.empty())
+      return;
+
+    n_leaves = Builder::Build(values.begin(), values.end(), nodes);
+  }
+
+  /**
+   * Call the visitor on all values whose bounding box overlaps the
+   * specified one (boxes which touch count as overlapping).
+   */
+  template<typename V>
+  void VisitOverlapping(const FlatBoundingBox &box, V &visitor) const {
+    if (nodes.empty()) {
+      for (const_iterator i = values.begin(), end = values.end();
+           i != end; ++i)
+        if (i->Overlaps(box))
+          visitor(*i);
+      return;
+    }
+
+    VisitOverlapping(nodes.size() - 1, box, visitor);
+  }
+
+  /**
+   * Find the value whose bounding box is nearest to the specified
+   * location and which matches the predicate.
+   *
+   * @param max_distance ignore values further away than this
+   * (projected units)
+   * @return the value (end() if none was found) and its bounding box
+   * distance, which is zero if the location is inside the box
+   */
+  template<typename P>
+  gcc_pure
+  std::pair<const_iterator, unsigned>
+  FindNearestIf(const FlatGeoPoint &location, unsigned max_distance,
+                const P &predicate) const {
+    std::pair<const_iterator, unsigned> best(values.end(), max_distance);
+
+    if (nodes.empty()) {
+      for (const_iterator i = values.begin(), end = values.end();
+           i != end; ++i)
+        CheckNearest(i, location, predicate, best);
+    } else
+      FindNearestIf(nodes.size() - 1, location, predicate, best);
+
+    return best;
+  }
+
+private:
+  template<typename V>
+  void VisitOverlapping(unsigned index, const FlatBoundingBox &box,
+                        V &visitor) const {
+    const Node &node = nodes[index];
+    if (!node.Overlaps(box))
+      return;
+
+    const unsigned end = node.first + node.count;
+    if (index < n_leaves) {
+      for (unsigned i = node.first; i < end; ++i)
+        if (values[i].Overlaps(box))
+          visitor(values[i]);
+    } else {
+      for (unsigned i = node.first; i < end; ++i)
+        VisitOverlapping(i, box, visitor);
+    }
+  }
+
+  template<typename P>
+  static void CheckNearest(const_iterator i, const FlatGeoPoint &location,
+                           const P &predicate,
+                           std::pair<const_iterator, unsigned> &best) {
+    const unsigned distance = i->MinDistance(location);
+    if (distance <= best.second && predicate(*i)) {
+      best.first = i;
+      best.second = distance;
+    }
+  }
+
+  template<typename P>
+  void FindNearestIf(unsigned index, const FlatGeoPoint &location,
+                     const P &predicate,
+                     std::pair<const_iterator, unsigned> &best) const {
+    const Node &node = nodes[index];
+    if (node.MinDistance(location) > best.second)
+      return;
+
+    const unsigned end = node.first + node.count;
+    if (index < n_leaves) {
+      for (unsigned i = node.first; i < end; ++i)
+        CheckNearest(values.begin() + i, location, predicate, best);
+    } else {
+      for (unsigned i = node.first; i < end; ++i)
+        FindNearestIf(i, location, predicate, best);
+    }
+  }
+};
+
+#endif
@@ -24,13 +24,15 @@ Copyright_License {
 #include "Trace.hpp"
 #include "Vector.hpp"
 #include "Navigation/Aircraft.hpp"
-#include "Util/GlobalSliceAllocator.hpp"
 
 #include <algorithm>
 
 Trace::Trace(const unsigned _no_thin_time, const unsigned max_time,
              const unsigned max_points)
-  :chronological_list(ListHead::empty()),
+  :nodes(max_points), n_allocated(0),
+   free_list(ListHead::empty()),
+   delta_heap(max_points), heap_size(0),
+   chronological_list(ListHead::empty()),
    cached_size(0),
    m_max_time(max_time),
    no_thin_time(_no_thin_time),
@@ -43,17 +45,19 @@ Trace::Trace(const unsigned _no_thin_time, const unsigned max_time,
 void
 Trace::clear()
 {
-  assert(cached_size == delta_list.size());
+  assert(cached_size == heap_size);
   assert(cached_size == chronological_list.Count());
 
   m_average_delta_distance = 0;
   m_average_delta_time = 0;
 
-  delta_list.clear();
+  n_allocated = 0;
+  free_list.Clear();
+  heap_size = 0;
   chronological_list.Clear();
   cached_size = 0;
 
-  assert(cached_size == delta_list.size());
+  assert(cached_size == heap_size);
   assert(cached_size == chronological_list.Count());
 
   ++modify_serial;
@@ -75,49 +79,33 @@ Trace::get_recent_time(const unsigned t) const
 void
 Trace::update_delta(TraceDelta &td)
 {
-  assert(cached_size == delta_list.size());
   assert(cached_size == chronological_list.Count());
 
   if (chronological_list.IsEdge(td))
     return;
 
-  const TraceDelta &previous = td.GetPrevious();
-  const TraceDelta &next = td.GetNext();
+  td.update(td.GetPrevious().point, td.GetNext().point);
 
-  TraceDelta temp_td = td;
-  temp_td.SetDisconnected();
-
-  td.Replace(temp_td);
-
-  // erase old one
-  auto i = delta_list.find(td);
-  assert(i != delta_list.end());
-  delta_list.erase(i);
-
-  // insert new in sorted position
-  temp_td.update(previous.point, next.point);
-  TraceDelta &new_td = insert(temp_td);
-  new_td.SetDisconnected();
-  temp_td.Replace(new_td);
+  /* points which are parked by erase_delta() are put back into the
+     heap later */
+  if (td.IsInHeap())
+    HeapUpdate(td);
 }
 
 void
-Trace::erase_inside(TraceDelta::iterator it)
+Trace::erase_inside(TraceDelta &td)
 {
   assert(cached_size > 0);
-  assert(cached_size == delta_list.size());
   assert(cached_size == chronological_list.Count());
-  assert(it != delta_list.end());
-
-  const TraceDelta &td = *it;
   assert(!td.IsEdge());
 
-  TraceDelta &previous = const_cast<TraceDelta &>(td.GetPrevious());
-  TraceDelta &next = const_cast<TraceDelta &>(td.GetNext());
+  TraceDelta &previous = td.GetPrevious();
+  TraceDelta &next = td.GetNext();
 
   // now delete the item
-  td.RemoveConst();
-  delta_list.erase(it);
+  td.Remove();
+  HeapRemove(td);
+  FreeDelta(td);
   --cached_size;
 
   // and update the deltas
@@ -128,7 +116,7 @@ Trace::erase_inside(TraceDelta::iterator it)
 bool
 Trace::erase_delta(const unsigned target_size, const unsigned recent)
 {
-  assert(cached_size == delta_list.size());
+  assert(cached_size == heap_size);
   assert(cached_size == chronological_list.Count());
 
   if (size() < 2)
@@ -138,19 +126,26 @@ Trace::erase_delta(const unsigned target_size, const unsigned recent)
 
   const unsigned recent_time = get_recent_time(recent);
 
-  TraceDelta::iterator candidate = delta_list.begin();
-  while (size() > target_size) {
-    const TraceDelta &td = *candidate;
+  /* the points which must not be removed are taken out of the heap
+     and parked at the end of the array until we're done */
+  const unsigned parking = delta_heap.size();
+  unsigned n_parked = 0;
+
+  while (size() > target_size && heap_size > 0) {
+    TraceDelta &td = *delta_heap[0];
     if (!td.IsEdge() && td.point.GetTime() < recent_time) {
-      erase_inside(candidate);
-      candidate = delta_list.begin(); // find new top
+      erase_inside(td);
       modified = true;
     } else {
-      ++candidate;
       // suppressed removal, skip it.
+      HeapRemove(td);
+      delta_heap[parking - ++n_parked] = &td;
     }
   }
 
+  while (n_parked > 0)
+    HeapPush(*delta_heap[parking - n_parked--]);
+
   return modified;
 }
 
@@ -164,10 +159,8 @@ Trace::erase_earlier_than(const unsigned p_time)
   do {
     TraceDelta &td = GetFront();
     td.Remove();
-
-    auto i = delta_list.find(td);
-    assert(i != delta_list.end());
-    delta_list.erase(i);
+    HeapRemove(td);
+    FreeDelta(td);
 
     --cached_size;
   } while (!empty() && GetFront().point.GetTime() < p_time);
@@ -180,41 +173,122 @@ Trace::erase_earlier_than(const unsigned p_time)
   return true;
 }
 
-Trace::TraceDelta &
-Trace::insert(const TraceDelta &td) {
-  TraceDelta::iterator it = delta_list.insert(td);
-
-  /* std::set doesn't allow modification of an item, but we
-     override that */
-  TraceDelta &new_td = const_cast<TraceDelta &>(*it);
-  return new_td;
-}
-
 /**
  * Update start node (and neighbour) after min time pruning
  */
 void
 Trace::erase_start(TraceDelta &td_start) {
-  TraceDelta temp_td = td_start;
-  temp_td.SetDisconnected();
-  td_start.Replace(temp_td);
+  td_start.elim_distance = null_delta;
+  td_start.elim_time = null_time;
+  HeapUpdate(td_start);
+}
+
+Trace::TraceDelta &
+Trace::AllocateDelta()
+{
+  if (!free_list.IsEmpty()) {
+    TraceDelta &td = *(TraceDelta *)free_list.GetNext();
+    td.Remove();
+    return td;
+  }
+
+  assert(n_allocated < nodes.size());
+  return nodes[n_allocated++];
+}
+
+void
+Trace::FreeDelta(TraceDelta &td)
+{
+  assert(!td.IsInHeap());
+
+  td.InsertAfter(free_list);
+}
+
+void
+Trace::HeapSiftUp(unsigned i)
+{
+  TraceDelta &td = *delta_heap[i];
+
+  while (i > 0) {
+    const unsigned parent = (i - 1) / 2;
+    if (!TraceDelta::DeltaRank(td, *delta_heap[parent]))
+      break;
+
+    HeapSet(i, *delta_heap[parent]);
+    i = parent;
+  }
+
+  HeapSet(i, td);
+}
+
+void
+Trace::HeapSiftDown(unsigned i)
+{
+  TraceDelta &td = *delta_heap[i];
+
+  while (true) {
+    unsigned child = 2 * i + 1;
+    if (child >= heap_size)
+      break;
+
+    if (child + 1 < heap_size &&
+        TraceDelta::DeltaRank(*delta_heap[child + 1], *delta_heap[child]))
+      ++child;
+
+    if (!TraceDelta::DeltaRank(*delta_heap[child], td))
+      break;
+
+    HeapSet(i, *delta_heap[child]);
+    i = child;
+  }
+
+  HeapSet(i, td);
+}
+
+void
+Trace::HeapPush(TraceDelta &td)
+{
+  assert(!td.IsInHeap());
+  assert(heap_size < delta_heap.size());
 
-  auto i_start = delta_list.find(td_start);
-  assert(i_start != delta_list.end());
-  delta_list.erase(i_start);
+  HeapSet(heap_size, td);
+  HeapSiftUp(heap_size++);
+}
+
+void
+Trace::HeapRemove(TraceDelta &td)
+{
+  assert(td.IsInHeap());
+  assert(td.heap_index < heap_size);
+  assert(delta_heap[td.heap_index] == &td);
 
-  temp_td.elim_distance = null_delta;
-  temp_td.elim_time = null_time;
+  const unsigned i = td.heap_index;
+  td.heap_index = TraceDelta::NO_HEAP_INDEX;
+
+  if (i == --heap_size)
+    return;
+
+  /* move the last item into the gap */
+  HeapSet(i, *delta_heap[heap_size]);
+  HeapUpdate(*delta_heap[i]);
+}
+
+void
+Trace::HeapUpdate(TraceDelta &td)
+{
+  assert(td.IsInHeap());
 
-  TraceDelta &new_td = insert(temp_td);
-  new_td.SetDisconnected();
-  temp_td.Replace(new_td);
+  const unsigned i = td.heap_index;
+  if (i > 0 && TraceDelta::DeltaRank(td, *delta_heap[(i - 1) / 2]))
+    HeapSiftUp(i);
+  else
+    HeapSiftDown(i);
 }
 
 void
 Trace::append(const AircraftState& state)
 {
-  assert(cached_size == delta_list.size());
+  assert(cached_size == heap_size);
   assert(cached_size == chronological_list.Count());
 
   if (empty()) {
@@ -238,7 +312,9 @@ Trace::append(const AircraftState& state)
   TracePoint tp(state);
   tp.project(task_projection);
 
-  TraceDelta &td = insert(tp);
+  TraceDelta &td = AllocateDelta();
+  td = TraceDelta(tp);
+  HeapPush(td);
   td.InsertBefore(chronological_list);
 
   ++cached_size;
@@ -327,7 +403,7 @@ Trace::Thin2()
 void
 Trace::Thin()
 {
-  assert(cached_size == delta_list.size());
+  assert(cached_size == heap_size);
   assert(cached_size == chronological_list.Count());
   assert(size() == m_max_points);
 
@@ -26,14 +26,13 @@ Copyright_License {
 
 #include "Point.hpp"
 #include "Util/NonCopyable.hpp"
-#include "Util/SliceAllocator.hpp"
+#include "Util/AllocatedArray.hpp"
 #include "Util/ListHead.hpp"
 #include "Util/CastIterator.hpp"
 #include "Util/Serial.hpp"
 #include "Navigation/TaskProjection.hpp"
 #include "Compiler.h"
 
-#include <set>
 #include <assert.h>
 #include <stdio.h>
 
@@ -50,6 +49,11 @@ class TracePointerVector;
  * the candidate point removed.  In this version, time differences is also a
  * secondary factor, such that thinning attempts to remove points such that,
  * for equal distance ranking, smaller time step details are removed first.
+ *
+ * All points live in one array which is allocated by the constructor.
+ * The thinning candidates are ranked by a binary heap of pointers
+ * into this array; each point knows its position in the heap, so its
+ * rank can be updated in place when a neighbour gets removed.
  */
 class Trace : private NonCopyable
 {
@@ -85,19 +89,7 @@ class Trace : private NonCopyable
       return false;
     }
 
-    struct DeltaRankOp {
-      bool operator()(const TraceDelta &s1, const TraceDelta &s2) {
-        return DeltaRank(s1, s2);
-      }
-    };
-
-    /* using std::multiset, not because we need multiple values (we
-       don't), but to avoid std::set's overhead for duplicate
-       elimination */
-    typedef std::multiset<TraceDelta, DeltaRankOp,
-                          GlobalSliceAllocator<TraceDelta, 128u> > List;
-    typedef List::iterator iterator;
-    typedef List::const_iterator const_iterator;
+    static const unsigned NO_HEAP_INDEX = 0 - 1;
 
     TracePoint point;
 
@@ -105,17 +97,26 @@ class Trace : private NonCopyable
     unsigned elim_distance;
     unsigned delta_distance;
 
+    /**
+     * The position of this object in Trace::delta_heap, or
+     * #NO_HEAP_INDEX if it is not in the heap.
+     */
+    unsigned heap_index;
+
+    TraceDelta() = default;
+
     TraceDelta(const TracePoint &p)
       :point(p),
        elim_time(null_time), elim_distance(null_delta),
-       delta_distance(0) {}
+       delta_distance(0), heap_index(NO_HEAP_INDEX) {}
 
     TraceDelta(const TracePoint &p_last, const TracePoint &p,
                const TracePoint &p_next)
       :point(p),
        elim_time(time_metric(p_last, p, p_next)),
        elim_distance(distance_metric(p_last, p, p_next)),
-       delta_distance(p.flat_distance(p_last))
+       delta_distance(p.flat_distance(p_last)),
+       heap_index(NO_HEAP_INDEX)
     {
       assert(elim_distance != null_delta);
     }
@@ -127,6 +128,10 @@ class Trace : private NonCopyable
       return elim_time == null_time;
     }
 
+    bool IsInHeap() const {
+      return heap_index != NO_HEAP_INDEX;
+    }
+
     TraceDelta &GetPrevious() {
       return *(TraceDelta *)ListHead::GetPrevious();
     }
@@ -188,7 +193,24 @@ class Trace : private NonCopyable
 
   typedef CastIterator<const TraceDelta, ListHead::const_iterator> ChronologicalConstIterator;
 
-  TraceDelta::List delta_list;
+  /**
+   * The storage for all points.  The elements which are not in use
+   * are linked in #free_list, or have never been used (index
+   * #n_allocated and above).
+   */
+  AllocatedArray<TraceDelta> nodes;
+  unsigned n_allocated;
+  ListHead free_list;
+
+  /**
+   * A binary min-heap ordered by TraceDelta::DeltaRank(): the best
+   * candidate for thinning is at the top.  While erase_delta() is
+   * running, the points which must not be removed are parked at the
+   * end of the array.
+   */
+  AllocatedArray<TraceDelta *> delta_heap;
+  unsigned heap_size;
+
   ListHead chronological_list;
   unsigned cached_size;
 
@@ -230,25 +252,20 @@ protected:
   unsigned get_recent_time(const unsigned t) const;
 
   /**
-   * Update delta values for specified item in the delta list and the
-   * tree.  This repositions the item after into its sorted position.
+   * Update delta values for specified item in the delta list and
+   * move it to its new position in the heap.
    *
-   * @param it Item to update
-   * @param tree Tree containing leaf
-   *
-   * @return Iterator to updated item
+   * @param td Item to update
    */
   void update_delta(TraceDelta &td);
 
   /**
-   * Erase a non-edge item from delta list and tree, updating
-   * deltas in the process.  This Invalidates the calling iterator.
-   *
-   * @param it Item to erase
-   * @param tree Tree to remove from
+   * Erase a non-edge item from delta list and heap, updating
+   * deltas in the process.
    *
+   * @param td Item to erase
    */
-  void erase_inside(TraceDelta::iterator it);
+  void erase_inside(TraceDelta &td);
 
   /**
    * Erase elements based on delta metric until the size is
@@ -278,13 +295,39 @@ protected:
    */
   bool erase_earlier_than(const unsigned p_time);
 
-  TraceDelta &insert(const TraceDelta &td);
-
   /**
    * Update start node (and neighbour) after min time pruning
    */
   void erase_start(TraceDelta &td_start);
 
+  /**
+   * Obtain an unused element from #nodes.
+   */
+  TraceDelta &AllocateDelta();
+
+  /**
+   * Return an element to #free_list.  It must already be removed from
+   * the chronological list and from the heap.
+   */
+  void FreeDelta(TraceDelta &td);
+
+  void HeapSet(unsigned i, TraceDelta &td) {
+    delta_heap[i] = &td;
+    td.heap_index = i;
+  }
+
+  void HeapSiftUp(unsigned i);
+  void HeapSiftDown(unsigned i);
+
+  void HeapPush(TraceDelta &td);
+  void HeapRemove(TraceDelta &td);
+
+  /**
+   * Restore the heap order after the rank of the specified item has
+   * changed.
+   */
+  void HeapUpdate(TraceDelta &td);
+
 public:
   /**
    * Add trace to internal store.  Call optimise() periodically
@@ -24,8 +24,80 @@ Copyright_License {
 #include "Database.hpp"
 #include "Util/StringUtil.hpp"
 
+#include <algorithm>
 #include <assert.h>
 
+/**
+ * The size of one string chunk, in characters.  The FlarmNet.org
+ * strings are much shorter than that.
+ */
+static const unsigned CHUNK_SIZE = 16384;
+
+struct FlarmDatabase::CompareCallSign {
+  const std::vector<Item> &items;
+
+  CompareCallSign(const std::vector<Item> &_items):items(_items) {}
+
+  gcc_pure
+  const TCHAR *GetCallSign(unsigned i) const {
+    return items[i].record.callsign;
+  }
+
+  gcc_pure
+  bool operator()(unsigned a, unsigned b) const {
+    return _tcscmp(GetCallSign(a), GetCallSign(b)) < 0;
+  }
+
+  gcc_pure
+  bool operator()(unsigned a, const TCHAR *b) const {
+    return _tcscmp(GetCallSign(a), b) < 0;
+  }
+
+  gcc_pure
+  bool operator()(const TCHAR *a, unsigned b) const {
+    return _tcscmp(a, GetCallSign(b)) < 0;
+  }
+};
+
+FlarmDatabase::~FlarmDatabase()
+{
+  for (auto i = chunks.begin(), end = chunks.end(); i != end; ++i)
+    delete[] *i;
+}
+
+void
+FlarmDatabase::Clear()
+{
+  items.clear();
+  callsign_index.clear();
+
+  for (auto i = chunks.begin(), end = chunks.end(); i != end; ++i)
+    delete[] *i;
+  chunks.clear();
+  chunk_fill = 0;
+}
+
+const TCHAR *
+FlarmDatabase::StoreString(const TCHAR *value)
+{
+  if (StringIsEmpty(value))
+    /* empty strings are common; share one instance */
+    return _T("");
+
+  const unsigned size = _tcslen(value) + 1;
+  assert(size <= CHUNK_SIZE);
+
+  if (chunks.empty() || chunk_fill + size > CHUNK_SIZE) {
+    chunks.push_back(new TCHAR[CHUNK_SIZE]);
+    chunk_fill = 0;
+  }
+
+  TCHAR *p = chunks.back() + chunk_fill;
+  std::copy(value, value + size, p);
+  chunk_fill += size;
+  return p;
+}
+
 void
 FlarmDatabase::Insert(const FlarmRecord &record)
 {
@@ -34,21 +106,71 @@ FlarmDatabase::Insert(const FlarmRecord &record)
     /* ignore malformed records */
     return;
 
-  map.insert(std::make_pair(id, record));
+  Item item;
+  item.id = id;
+  item.record.id = StoreString(record.id);
+  item.record.pilot = StoreString(record.pilot);
+  item.record.airfield = StoreString(record.airfield);
+  item.record.plane_type = StoreString(record.plane_type);
+  item.record.registration = StoreString(record.registration);
+  item.record.callsign = StoreString(record.callsign);
+  item.record.frequency = StoreString(record.frequency);
+  items.push_back(item);
+}
+
+void
+FlarmDatabase::Finish()
+{
+  /* sort by id; the stable sort keeps the first of several records
+     with the same id in front, and std::unique() keeps only that
+     one */
+  std::stable_sort(items.begin(), items.end());
+  items.erase(std::unique(items.begin(), items.end()), items.end());
+
+  /* release the space reserved by push_back() */
+  std::vector<Item>(items).swap(items);
+
+  callsign_index.resize(items.size());
+  for (unsigned i = 0; i < items.size(); ++i)
+    callsign_index[i] = i;
+
+  std::stable_sort(callsign_index.begin(), callsign_index.end(),
+                   CompareCallSign(items));
 }
 
 const FlarmRecord *
-FlarmDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
+FlarmDatabase::FindRecordById(FlarmId id) const
 {
-  for (auto i = map.begin(), end = map.end(); i != end; ++i) {
-    assert(i->first.IsDefined());
+  assert(callsign_index.size() == items.size());
+
+  Item key;
+  key.id = id;
+  auto i = std::lower_bound(items.begin(), items.end(), key);
+  return i != items.end() && i->id == id
+    ? &i->record
+    : NULL;
+}
 
-    const FlarmRecord &record = i->second;
-    if (StringIsEqual(record.callsign, cn))
-      return &record;
-  }
+std::pair<const unsigned *, const unsigned *>
+FlarmDatabase::LookupCallSign(const TCHAR *cn) const
+{
+  assert(callsign_index.size() == items.size());
 
-  return NULL;
+  if (callsign_index.empty())
+    return std::make_pair((const unsigned *)NULL, (const unsigned *)NULL);
+
+  const unsigned *begin = &callsign_index.front();
+  return std::equal_range(begin, begin + callsign_index.size(), cn,
+                          CompareCallSign(items));
+}
+
+const FlarmRecord *
+FlarmDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
+{
+  auto range = LookupCallSign(cn);
+  return range.first != range.second
+    ? &items[*range.first].record
+    : NULL;
 }
 
 unsigned
@@ -56,14 +178,11 @@ FlarmDatabase::FindRecordsByCallSign(const TCHAR *cn,
                                      const FlarmRecord *array[],
                                      unsigned size) const
 {
-  unsigned count = 0;
-  for (auto i = map.begin(), end = map.end(); i != end; ++i) {
-    assert(i->first.IsDefined());
+  auto range = LookupCallSign(cn);
 
-    const FlarmRecord &record = i->second;
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = &record;
-  }
+  unsigned count = 0;
+  for (auto i = range.first; i != range.second && count < size; ++i)
+    array[count++] = &items[*i].record;
 
   return count;
 }
@@ -72,14 +191,11 @@ unsigned
 FlarmDatabase::FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
                                  unsigned size) const
 {
-  unsigned count = 0;
-  for (auto i = map.begin(), end = map.end(); i != end; ++i) {
-    assert(i->first.IsDefined());
+  auto range = LookupCallSign(cn);
 
-    const FlarmRecord &record = i->second;
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = i->first;
-  }
+  unsigned count = 0;
+  for (auto i = range.first; i != range.second && count < size; ++i)
+    array[count++] = items[*i].id;
 
   return count;
 }
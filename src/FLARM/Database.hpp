@@ -26,44 +26,89 @@ Copyright_License {
 
 #include "FlarmId.hpp"
 #include "Record.hpp"
+#include "Util/NonCopyable.hpp"
 #include "Compiler.h"
 
-#include <map>
+#include <vector>
 #include <tchar.h>
 
-class NLineReader;
-class FlarmId;
-
 /**
  * An in-memory representation of the FlarmNet.org database.
+ *
+ * The records are kept in a vector sorted by FLARM id, and their
+ * strings are copied into large shared chunks, which is much more
+ * compact than one heap allocation per record.  A second index sorts
+ * the records by callsign.
  */
-class FlarmDatabase {
-  typedef std::map<FlarmId, FlarmRecord> RecordMap;
-  RecordMap map;
+class FlarmDatabase : private NonCopyable {
+  struct Item {
+    FlarmId id;
+    FlarmRecord record;
+
+    /* these compare only the id */
+
+    bool operator<(const Item &other) const {
+      return id < other.id;
+    }
+
+    bool operator==(const Item &other) const {
+      return id == other.id;
+    }
+  };
+
+  /**
+   * All records, sorted by id (after Finish()).
+   */
+  std::vector<Item> items;
+
+  /**
+   * Indexes into #items, sorted by callsign, and by id within the
+   * same callsign.
+   */
+  std::vector<unsigned> callsign_index;
+
+  /**
+   * The string chunks owned by this object.
+   */
+  std::vector<TCHAR *> chunks;
+
+  /**
+   * The number of characters already used in the last chunk.
+   */
+  unsigned chunk_fill;
+
+  struct CompareCallSign;
 
 public:
+  FlarmDatabase():chunk_fill(0) {}
+  ~FlarmDatabase();
+
   bool IsEmpty() const {
-    return map.empty();
+    return items.empty();
   }
 
-  void Clear() {
-    map.clear();
-  }
+  void Clear();
 
+  /**
+   * Adds a record to the database.  The strings are copied.  Call
+   * Finish() after the last record has been inserted; until then,
+   * the lookup methods will not work.
+   */
   void Insert(const FlarmRecord &record);
 
+  /**
+   * Sorts the records and builds the indexes.  Of several records
+   * with the same id, only the first one is kept.
+   */
+  void Finish();
+
   /**
    * Finds a FLARMNetRecord object based on the given FLARM id
    * @param id FLARM id
    * @return FLARMNetRecord object
    */
   gcc_pure
-  const FlarmRecord *FindRecordById(FlarmId id) {
-    auto i = map.find(id);
-    return i != map.end()
-      ? &i->second
-      : NULL;
-  }
+  const FlarmRecord *FindRecordById(FlarmId id) const;
 
   /**
    * Finds a FLARMNetRecord object based on the given Callsign
@@ -77,6 +122,19 @@ public:
                                  unsigned size) const;
   unsigned FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
                              unsigned size) const;
+
+private:
+  /**
+   * Copies the string into a chunk and returns the copy.
+   */
+  const TCHAR *StoreString(const TCHAR *value);
+
+  /**
+   * Returns the range of #callsign_index matching the callsign.
+   */
+  gcc_pure
+  std::pair<const unsigned *, const unsigned *>
+  LookupCallSign(const TCHAR *cn) const;
 };
 
 #endif
@@ -29,8 +29,37 @@ Copyright_License {
 #include "IO/LineReader.hpp"
 #include "IO/FileLineReader.hpp"
 
-#include <stdio.h>
-#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Maps hexadecimal digits to their value; all other characters map
+ * to zero.
+ */
+static const unsigned char hex_values[256] = {
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  0,  0,  0,  0,  0,  0,
+   0, 10, 11, 12, 13, 14, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0, 10, 11, 12, 13, 14, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+static inline unsigned char
+DecodeHexByte(const char *p)
+{
+  return (hex_values[(unsigned char)p[0]] << 4) |
+    hex_values[(unsigned char)p[1]];
+}
 
 /**
  * Decodes the FlarmNet.org file and puts the wanted
@@ -42,19 +71,9 @@ Copyright_License {
 static void
 LoadString(const char *bytes, int charCount, TCHAR *res)
 {
-  int bytesToRead = charCount * 2;
-
   TCHAR *curChar = res;
-
-  char tmp[3];
-  tmp[2] = 0;
-  for (int z = 0; z < bytesToRead; z += 2) {
-    tmp[0] = bytes[z];
-    tmp[1] = bytes[z+1];
-
-    *curChar = (unsigned char)strtoul(tmp, NULL, 16);
-    curChar++;
-  }
+  for (int z = 0; z < charCount; ++z, bytes += 2)
+    *curChar++ = DecodeHexByte(bytes);
 
   *curChar = 0;
 
@@ -63,31 +82,44 @@ LoadString(const char *bytes, int charCount, TCHAR *res)
 }
 
 /**
- * Reads next FlarmNet.org file entry and returns the pointer to
- * a new FlarmNetRecord instance or NULL on error.
+ * Decodes a FlarmNet.org file entry and inserts it into the database.
  *
- * The caller is responsible for deleting the object again!
+ * @return false if the line is malformed
  */
 static bool
-LoadRecord(FlarmRecord &record, const char *line)
+LoadRecord(FlarmDatabase &database, const char *line)
 {
   if (strlen(line) < 172)
     return false;
 
-  LoadString(line, 6, record.id);
-  LoadString(line + 12, 21, record.pilot);
-  LoadString(line + 54, 21, record.airfield);
-  LoadString(line + 96, 21, record.plane_type);
-  LoadString(line + 138, 7, record.registration);
-  LoadString(line + 152, 3, record.callsign);
-  LoadString(line + 158, 7, record.frequency);
+  TCHAR id[7], pilot[22], airfield[22], plane_type[22];
+  TCHAR registration[8], callsign[4], frequency[8];
+
+  LoadString(line, 6, id);
+  LoadString(line + 12, 21, pilot);
+  LoadString(line + 54, 21, airfield);
+  LoadString(line + 96, 21, plane_type);
+  LoadString(line + 138, 7, registration);
+  LoadString(line + 152, 3, callsign);
+  LoadString(line + 158, 7, frequency);
 
   // Terminate callsign string on first whitespace
-  int maxSize = sizeof(record.callsign) / sizeof(TCHAR);
-  for (int i = 0; record.callsign[i] != 0 && i < maxSize; i++)
-    if (IsWhitespaceOrNull(record.callsign[i]))
-      record.callsign[i] = 0;
+  for (unsigned i = 0; callsign[i] != 0; i++) {
+    if (IsWhitespaceOrNull(callsign[i])) {
+      callsign[i] = 0;
+      break;
+    }
+  }
 
+  FlarmRecord record;
+  record.id = id;
+  record.pilot = pilot;
+  record.airfield = airfield;
+  record.plane_type = plane_type;
+  record.registration = registration;
+  record.callsign = callsign;
+  record.frequency = frequency;
+  database.Insert(record);
   return true;
 }
 
@@ -100,14 +132,11 @@ FlarmNetReader::LoadFile(NLineReader &reader, FlarmDatabase &database)
     return 0;
 
   int itemCount = 0;
-  while ((line = reader.read()) != NULL) {
-    FlarmRecord record;
-    if (LoadRecord(record, line)) {
-      database.Insert(record);
+  while ((line = reader.read()) != NULL)
+    if (LoadRecord(database, line))
       itemCount++;
-    }
-  }
 
+  database.Finish();
   return itemCount;
 }
 
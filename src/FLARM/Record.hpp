@@ -31,29 +31,30 @@ Copyright_License {
 class FlarmId;
 
 /**
- * FlarmNet.org file entry
+ * FlarmNet.org file entry.  The strings are owned by the
+ * #FlarmDatabase which contains the record; they are never NULL.
  */
 struct FlarmRecord {
   /**< FLARM id 6 bytes */
-  TCHAR id[7];
+  const TCHAR *id;
 
-  /**< Name 15 bytes */
-  TCHAR pilot[22];
+  /**< Name 21 bytes */
+  const TCHAR *pilot;
 
-  /**< Airfield 4 bytes */
-  TCHAR airfield[22];
+  /**< Airfield 21 bytes */
+  const TCHAR *airfield;
 
-  /**< Aircraft type 1 byte */
-  TCHAR plane_type[22];
+  /**< Aircraft type 21 bytes */
+  const TCHAR *plane_type;
 
   /**< Registration 7 bytes */
-  TCHAR registration[8];
+  const TCHAR *registration;
 
   /**< Callsign 3 bytes */
-  TCHAR callsign[4];
+  const TCHAR *callsign;
 
-  /**< Radio frequency 6 bytes */
-  TCHAR frequency[8];
+  /**< Radio frequency 7 bytes */
+  const TCHAR *frequency;
 
   gcc_pure
   FlarmId GetId() const;
@@ -0,0 +1,84 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "BinaryCache.hpp"
+
+#include <string.h>
+
+bool
+WriteCacheData(FILE *file, const void *data, size_t size)
+{
+  return size == 0 || fwrite(data, size, 1, file) == 1;
+}
+
+bool
+WriteCacheString(FILE *file, const tstring &value)
+{
+  return WriteCacheData(file, value.data(), value.length() * sizeof(TCHAR));
+}
+
+bool
+CacheReader::Load(FILE *file)
+{
+  const long start = ftell(file);
+  if (start < 0 || fseek(file, 0, SEEK_END) != 0)
+    return false;
+
+  const long size = ftell(file);
+  if (size < start || fseek(file, start, SEEK_SET) != 0)
+    return false;
+
+  buffer.resize(size - start);
+  if (!buffer.empty() &&
+      fread(&buffer.front(), buffer.size(), 1, file) != 1)
+    return false;
+
+  p = buffer.empty() ? NULL : &buffer.front();
+  end = p + buffer.size();
+  return true;
+}
+
+bool
+CacheReader::Read(void *dest, size_t size)
+{
+  if (size > size_t(end - p))
+    return false;
+
+  memcpy(dest, p, size);
+  p += size;
+  return true;
+}
+
+bool
+CacheReader::ReadString(tstring &dest, unsigned length)
+{
+  const size_t size = length * sizeof(TCHAR);
+  if (size > size_t(end - p))
+    return false;
+
+  dest.resize(length);
+  if (length > 0)
+    memcpy(&dest[0], p, size);
+  p += size;
+  return true;
+}
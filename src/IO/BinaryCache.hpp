@@ -0,0 +1,97 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IO_BINARY_CACHE_HPP
+#define XCSOAR_IO_BINARY_CACHE_HPP
+
+#include "Util/NonCopyable.hpp"
+#include "Util/tstring.hpp"
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Helpers for binary cache files (see #FileCache) which store values
+ * in their native layout.
+ */
+
+/**
+ * Write raw data to the file.
+ *
+ * @return false on I/O error
+ */
+bool
+WriteCacheData(FILE *file, const void *data, size_t size);
+
+/**
+ * Write the characters of the string, without length and null
+ * terminator.
+ *
+ * @return false on I/O error
+ */
+bool
+WriteCacheString(FILE *file, const tstring &value);
+
+/**
+ * Reads values from a cache file, which is loaded into memory at
+ * once.  All read methods fail if there is not enough data left.
+ */
+class CacheReader : private NonCopyable {
+  std::vector<uint8_t> buffer;
+  const uint8_t *p, *end;
+
+public:
+  CacheReader():p(NULL), end(NULL) {}
+
+  /**
+   * Load the rest of the file, starting at its current position.
+   *
+   * @return false on I/O error
+   */
+  bool Load(FILE *file);
+
+  bool Read(void *dest, size_t size);
+
+  template<typename T>
+  bool Read(T &dest) {
+    return Read(&dest, sizeof(dest));
+  }
+
+  /**
+   * Read a string written by WriteCacheString().
+   *
+   * @param length the number of characters
+   */
+  bool ReadString(tstring &dest, unsigned length);
+
+  /**
+   * Has all data been consumed?
+   */
+  bool IsEnd() const {
+    return p == end;
+  }
+};
+
+#endif
@@ -63,6 +63,14 @@ public:
     return file.Flush();
   }
 
+  /**
+   * Flush buffered data, and cut off the file after the specified
+   * number of bytes.
+   */
+  bool Truncate(long size) {
+    return file.Flush() && file.Truncate(size);
+  }
+
   bool Write(const void *s, size_t size, size_t length) {
     return file.Write(s, size, length) == length;
   }
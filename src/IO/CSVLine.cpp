@@ -33,13 +33,25 @@ end_of_line(const char *line)
 }
 
 CSVLine::CSVLine(const char *line):
-  data(line), end(end_of_line(line)) {}
+  data(line), end(end_of_line(line)), start(line),
+  separator(NULL), separator_end(NULL) {}
 
 size_t
 CSVLine::skip()
 {
-  const char* _seperator = strchr(data, ',');
-  if (_seperator != NULL && _seperator < end) {
+  /* the read methods may have moved past some of the known commas */
+  while (separator != separator_end && start + *separator < data)
+    ++separator;
+
+  if (separator != separator_end) {
+    const char *_seperator = start + *separator++;
+    size_t length = _seperator - data;
+    data = _seperator + 1;
+    return length;
+  }
+
+  const char *_seperator = (const char *)memchr(data, ',', end - data);
+  if (_seperator != NULL) {
     size_t length = _seperator - data;
     data = _seperator + 1;
     return length;
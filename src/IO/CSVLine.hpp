@@ -26,6 +26,8 @@ Copyright_License {
 
 #include "Math/fixed.hpp"
 
+#include <stdint.h>
+
 /**
  * A helper class which can dissect a NMEA input line.
  */
@@ -33,9 +35,28 @@ class CSVLine {
 protected:
   const char *data, *end;
 
+  /**
+   * The beginning of the line; the positions in #separator are
+   * relative to it.
+   */
+  const char *start;
+
+  /**
+   * The known positions of the remaining commas, see NMEASentence.
+   * After the last one, skip() searches for more.
+   */
+  const uint16_t *separator, *separator_end;
+
 public:
   CSVLine(const char *line);
 
+protected:
+  CSVLine(const char *line, const char *_end,
+          const uint16_t *separators, unsigned n_separators)
+    :data(line), end(_end), start(line),
+     separator(separators), separator_end(separators + n_separators) {}
+
+public:
   const char *rest() const {
     return data;
   }
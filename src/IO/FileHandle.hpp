@@ -28,6 +28,12 @@ Copyright_License {
 #include <stddef.h>
 #include <stdio.h>
 
+#ifdef HAVE_POSIX
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
 #ifdef _UNICODE
 #include <tchar.h>
 #endif
@@ -71,6 +77,22 @@ public:
     return fflush(file) == 0;
   }
 
+  /**
+   * Like Flush(), but also waits until the data has been written to
+   * the physical device.  Where this is not supported, it is the same
+   * as Flush().
+   */
+  bool Sync() {
+    if (!Flush())
+      return false;
+
+#ifdef HAVE_POSIX
+    return fsync(fileno(file)) == 0;
+#else
+    return true;
+#endif
+  }
+
   bool Seek(long offset, int whence) {
     assert(file != NULL);
     return fseek(file, offset, whence) == 0;
@@ -81,6 +103,19 @@ public:
     return ftell(file);
   }
 
+  /**
+   * Cut off the file after the specified number of bytes.  Buffered
+   * data must have been flushed before.
+   */
+  bool Truncate(long size) {
+    assert(file != NULL);
+#ifdef HAVE_POSIX
+    return ftruncate(fileno(file), size) == 0;
+#else
+    return _chsize(_fileno(file), size) == 0;
+#endif
+  }
+
   size_t Read(void *ptr, size_t size, size_t nmemb) {
     assert(file != NULL);
     return fread(ptr, size, nmemb, file);
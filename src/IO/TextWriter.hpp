@@ -84,6 +84,35 @@ public:
     return file.Flush();
   }
 
+  /**
+   * Determine the size of the file, and move the file position to
+   * its end.
+   *
+   * @return the size in bytes, or -1 on error
+   */
+  long GetSize() {
+    assert(file.IsOpen());
+    return file.Seek(0, SEEK_END) ? file.Tell() : -1;
+  }
+
+  /**
+   * Flush buffered data, and cut off the file after the specified
+   * number of bytes.
+   */
+  bool Truncate(long size) {
+    assert(file.IsOpen());
+    return file.Flush() && file.Truncate(size);
+  }
+
+  /**
+   * Like flush(), but also waits until the data has been written to
+   * the physical device.
+   */
+  bool sync() {
+    assert(file.IsOpen());
+    return file.Sync();
+  }
+
   /**
    * Write one character.
    */
@@ -381,6 +381,7 @@ InputEvents::eventAutoLogger(const TCHAR *misc)
 // toggle ask: toggles between on and off, asking the user to confirm
 // show: displays a status message indicating whether the logger is active
 // nmea: turns on and off NMEA logging
+// ncap: turns on and off NMEA logging to a compact capture file
 // note: the text following the 'note' characters is added to the log file
 void
 InputEvents::eventLogger(const TCHAR *misc)
@@ -418,6 +419,13 @@ InputEvents::eventLogger(const TCHAR *misc)
     } else {
       Message::AddMessage(_("NMEA log off"));
     }
+  } else if (StringIsEqual(misc, _T("ncap"))) {
+    NMEALogger::capture_enabled = !NMEALogger::capture_enabled;
+    if (NMEALogger::capture_enabled) {
+      Message::AddMessage(_("NMEA capture on"));
+    } else {
+      Message::AddMessage(_("NMEA capture off"));
+    }
   } else if (StringIsEqual(misc, _T("show")))
     if (logger.IsLoggerActive()) {
       Message::AddMessage(_("Logger on"));
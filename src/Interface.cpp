@@ -53,6 +53,7 @@ bool CommonInterface::movement_detected = false;
 bool ActionInterface::force_shutdown = false;
 
 InterfaceBlackboard CommonInterface::blackboard;
+ExchangeStatistics XCSoarInterface::exchange_statistics(_T("interface"));
 StatusMessageList CommonInterface::status_messages;
 MainWindow CommonInterface::main_window(status_messages);
 
@@ -67,16 +68,21 @@ CommonInterface::IsPanning()
 void
 XCSoarInterface::ReceiveGPS()
 {
+  BasicSnapshot basic;
+
   {
-    ScopeLock protect(device_blackboard->mutex);
+    ExchangeLock protect(device_blackboard->mutex, exchange_statistics);
 
-    ReadBlackboardBasic(device_blackboard->Basic());
+    basic = device_blackboard->GetBasicSnapshot();
 
     const NMEAInfo &real = device_blackboard->RealState();
     movement_detected = real.alive && real.gps.real &&
       real.MovementDetected();
   }
 
+  ReadBlackboardBasic(*basic);
+  exchange_statistics.AddCopy(sizeof(*basic));
+
   BroadcastGPSUpdate();
 
   if (!Basic().flarm.traffic.empty())
@@ -87,13 +93,18 @@ XCSoarInterface::ReceiveGPS()
 void
 XCSoarInterface::ReceiveCalculated()
 {
+  CalculatedSnapshot calculated;
+
   {
-    ScopeLock protect(device_blackboard->mutex);
+    ExchangeLock protect(device_blackboard->mutex, exchange_statistics);
 
-    ReadBlackboardCalculated(device_blackboard->Calculated());
+    calculated = device_blackboard->GetCalculatedSnapshot();
     device_blackboard->ReadComputerSettings(GetComputerSettings());
   }
 
+  ReadBlackboardCalculated(*calculated);
+  exchange_statistics.AddCopy(sizeof(*calculated));
+
   BroadcastCalculatedUpdate();
 }
 
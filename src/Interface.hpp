@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_INTERFACE_HPP
 
 #include "Blackboard/InterfaceBlackboard.hpp"
+#include "Blackboard/ExchangeStatistics.hpp"
 #include "Compiler.h"
 
 struct UIState;
@@ -268,6 +269,11 @@ public:
   static void ExchangeDeviceBlackboard();
 
 private:
+  /**
+   * Instrumentation of ReceiveGPS() and ReceiveCalculated().
+   */
+  static ExchangeStatistics exchange_statistics;
+
   static bool LoadProfile();
 };
 
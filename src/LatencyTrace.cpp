@@ -0,0 +1,134 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "LatencyTrace.hpp"
+#include "IO/TextWriter.hpp"
+#include "OS/Clock.hpp"
+#include "Util/Macros.hpp"
+
+#include <atomic>
+#include <assert.h>
+
+namespace LatencyTrace {
+  static Event *events;
+  static unsigned capacity;
+
+  /**
+   * The total number of events recorded so far; the next event goes
+   * to this position modulo #capacity.
+   */
+  static std::atomic<unsigned> position;
+}
+
+void
+LatencyTrace::Enable(unsigned _capacity)
+{
+  assert(_capacity > 0);
+
+  Disable();
+
+  capacity = _capacity;
+  position = 0;
+  events = new Event[capacity];
+}
+
+void
+LatencyTrace::Disable()
+{
+  delete[] events;
+  events = NULL;
+}
+
+bool
+LatencyTrace::IsEnabled()
+{
+  return events != NULL;
+}
+
+void
+LatencyTrace::Record(Stage stage, fixed fix_time, uint64_t time)
+{
+  if (events == NULL)
+    return;
+
+  const unsigned i = position.fetch_add(1, std::memory_order_relaxed)
+    % capacity;
+
+  Event &event = events[i];
+  event.time = time;
+  event.fix_time = (int)(fix_time * 1000);
+  event.stage = (uint8_t)stage;
+}
+
+void
+LatencyTrace::Record(Stage stage, fixed fix_time)
+{
+  if (events == NULL)
+    return;
+
+  Record(stage, fix_time, MonotonicClockUS());
+}
+
+void
+LatencyTrace::Collect(std::vector<Event> &dest)
+{
+  dest.clear();
+
+  if (events == NULL)
+    return;
+
+  const unsigned end = position;
+  const unsigned begin = end > capacity ? end - capacity : 0;
+  for (unsigned i = begin; i != end; ++i)
+    dest.push_back(events[i % capacity]);
+}
+
+bool
+LatencyTrace::Dump(const TCHAR *path)
+{
+  std::vector<Event> events;
+  Collect(events);
+
+  TextWriter writer(path);
+  if (writer.error())
+    return false;
+
+  for (auto i = events.begin(), end = events.end(); i != end; ++i)
+    writer.printfln("%llu %s %d", (unsigned long long)i->time,
+                    GetStageName((Stage)i->stage), i->fix_time);
+
+  return writer.flush();
+}
+
+const char *
+LatencyTrace::GetStageName(Stage stage)
+{
+  static const char *const names[] = {
+    "received", "parsed", "merged", "calculated", "drawn",
+  };
+
+  static_assert(ARRAY_SIZE(names) == N_STAGES, "wrong array size");
+
+  assert(stage < N_STAGES);
+  return names[stage];
+}
@@ -0,0 +1,119 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LATENCY_TRACE_HPP
+#define XCSOAR_LATENCY_TRACE_HPP
+
+#include "Math/fixed.hpp"
+#include "Compiler.h"
+
+#include <vector>
+#include <stdint.h>
+#include <tchar.h>
+
+/**
+ * Records the time when a GPS fix passes each stage from the port to
+ * the screen, to measure the latency of the whole chain.  The events
+ * are stored in a ring buffer, which is allocated only when tracing
+ * is enabled; otherwise Record() costs just a pointer check.
+ *
+ * Events are tagged with the time of the fix, which is how the
+ * stages of one fix are matched by the LatencyReport tool.
+ */
+namespace LatencyTrace {
+  enum Stage {
+    /** the port has received the data containing the fix */
+    RECEIVED,
+
+    /** the device driver or the NMEA parser has parsed the fix */
+    PARSED,
+
+    /** the MergeThread has merged the fix */
+    MERGED,
+
+    /** the CalculationThread has processed the fix */
+    CALCULATED,
+
+    /** the map showing the fix has been drawn */
+    DRAWN,
+
+    N_STAGES
+  };
+
+  struct Event {
+    /** the time of this event [us], see MonotonicClockUS() */
+    uint64_t time;
+
+    /** the time of the fix [ms of the day] */
+    int fix_time;
+
+    uint8_t stage;
+  };
+
+  /**
+   * Allocate the ring buffer.  Must be called before the traced
+   * threads are started.
+   *
+   * @param capacity the number of events which are kept
+   */
+  void Enable(unsigned capacity=32768);
+
+  /**
+   * Free the ring buffer.  Must be called after the traced threads
+   * have been stopped.
+   */
+  void Disable();
+
+  gcc_pure
+  bool IsEnabled();
+
+  /**
+   * Record an event with the current time.  This method may be
+   * called by any thread.
+   */
+  void Record(Stage stage, fixed fix_time);
+
+  /**
+   * Record an event which has happened earlier.
+   *
+   * @param time the time of the event [us], see MonotonicClockUS()
+   */
+  void Record(Stage stage, fixed fix_time, uint64_t time);
+
+  /**
+   * Copy the events in the buffer, oldest first.  The traced threads
+   * should not be running.
+   */
+  void Collect(std::vector<Event> &events);
+
+  /**
+   * Write all events to a text file, one per line: the time [us],
+   * the stage name and the fix time [ms].
+   */
+  bool Dump(const TCHAR *path);
+
+  gcc_const
+  const char *GetStageName(Stage stage);
+}
+
+#endif
@@ -28,6 +28,7 @@ Copyright_License {
 #include "Formatter/TimeFormatter.hpp"
 #include "OS/Clock.hpp"
 #include "Util/StaticString.hpp"
+#include "Thread/FastMutex.hpp"
 
 #include <stdio.h>
 #include <stdarg.h>
@@ -37,6 +38,11 @@ Copyright_License {
 #include <android/log.h>
 #endif
 
+/**
+ * Serialises LogStartUp() calls: the startup jobs run in parallel,
+ * and each one logs its progress.
+ */
+static FastMutex log_mutex;
 
 void
 LogStartUp(const TCHAR *Str, ...)
@@ -44,10 +50,6 @@ LogStartUp(const TCHAR *Str, ...)
   static bool initialised = false;
   static TCHAR szFileName[MAX_PATH];
 
-  if (!initialised) {
-    LocalPath(szFileName, _T("xcsoar-startup.log"));
-  }
-
   TCHAR buf[MAX_PATH];
   va_list ap;
 
@@ -66,14 +68,21 @@ LogStartUp(const TCHAR *Str, ...)
   fprintf(stderr, "%s\n", buf);
 #endif
 
-  TextWriter writer(szFileName, initialised);
-  if (writer.error())
-    return;
-
   StaticString<MAX_PATH> output_buffer;
   output_buffer.Format(_T("[%s] %s"), time_buffer, buf);
-  writer.writeln(output_buffer);
+
+  log_mutex.Lock();
 
   if (!initialised)
-    initialised = true;
+    LocalPath(szFileName, _T("xcsoar-startup.log"));
+
+  {
+    TextWriter writer(szFileName, initialised);
+    if (!writer.error()) {
+      writer.writeln(output_buffer);
+      initialised = true;
+    }
+  }
+
+  log_mutex.Unlock();
 }
@@ -0,0 +1,154 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Logger/IGCFileWriter.hpp"
+#include "Logger/LoggerGRecord.hpp"
+#include "IO/TextWriter.hpp"
+#include "OS/Clock.hpp"
+
+IGCFileWriter::IGCFileWriter(const TCHAR *_path, GRecord &_grecord)
+  :path(_path), grecord(_grecord), batch_offset(-1), sync_pending(false)
+{
+  statistics.batches = 0;
+  statistics.syncs = 0;
+  statistics.stalls = 0;
+  statistics.stall_ms = 0;
+  statistics.max_write_ms = 0;
+}
+
+IGCFileWriter::~IGCFileWriter()
+{
+  ScopeLock protect(mutex);
+  WaitDone();
+  Stop();
+}
+
+bool
+IGCFileWriter::Submit(Batch &batch, bool sync)
+{
+  ScopeLock protect(mutex);
+
+  if (IsBusy()) {
+    /* the storage device is slower than the records arrive: wait
+       for the previous batch instead of dropping records */
+    const unsigned start = MonotonicClockMS();
+    WaitDone();
+
+    ++statistics.stalls;
+    statistics.stall_ms += MonotonicClockMS() - start;
+  }
+
+  if (!pending.IsEmpty()) {
+    /* writing the previous batch has failed; retry it before
+       accepting new records, which would not fit */
+    Trigger();
+    WaitDone();
+
+    if (!pending.IsEmpty())
+      return false;
+  }
+
+  if (batch.IsEmpty() && !sync)
+    return true;
+
+  /* pending is empty here, so this clears the caller's batch */
+  pending.Swap(batch);
+  batch_offset = -1;
+  sync_pending = sync;
+
+  Trigger();
+  return true;
+}
+
+bool
+IGCFileWriter::Wait()
+{
+  ScopeLock protect(mutex);
+  WaitDone();
+  return pending.IsEmpty();
+}
+
+IGCFileWriter::Statistics
+IGCFileWriter::GetStatistics()
+{
+  ScopeLock protect(mutex);
+  return statistics;
+}
+
+bool
+IGCFileWriter::Write(bool sync)
+{
+  TextWriter writer(path, true);
+  if (writer.error())
+    return false;
+
+  if (batch_offset < 0) {
+    batch_offset = writer.GetSize();
+    if (batch_offset < 0)
+      return false;
+  } else if (!writer.Truncate(batch_offset))
+    return false;
+
+  for (unsigned i = 0; i < pending.Length(); ++i)
+    if (!writer.writeln(pending[i]))
+      return false;
+
+  if (!(sync ? writer.sync() : writer.flush()))
+    return false;
+
+  /* the G record may only include records which have really been
+     written; a failed batch will be written again */
+  for (unsigned i = 0; i < pending.Length(); ++i)
+    grecord.AppendRecordToBuffer(pending[i]);
+
+  return true;
+}
+
+void
+IGCFileWriter::Tick()
+{
+  /* syncing is expensive on flash memory, so it is done only once in
+     a while, and when the caller asks for it */
+  bool sync = sync_clock.CheckUpdate(SYNC_INTERVAL);
+  if (sync_pending) {
+    sync = true;
+    sync_clock.Update();
+  }
+
+  mutex.Unlock();
+
+  const unsigned start = MonotonicClockMS();
+  const bool success = Write(sync);
+  const unsigned duration = MonotonicClockMS() - start;
+
+  mutex.Lock();
+
+  if (success)
+    pending.Clear();
+
+  ++statistics.batches;
+  if (sync)
+    ++statistics.syncs;
+  if (duration > statistics.max_write_ms)
+    statistics.max_write_ms = duration;
+}
@@ -0,0 +1,152 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IGC_FILE_WRITER_HPP
+#define XCSOAR_IGC_FILE_WRITER_HPP
+
+#include "Thread/StandbyThread.hpp"
+#include "BatchBuffer.hpp"
+#include "PeriodClock.hpp"
+
+#include <tchar.h>
+
+class GRecord;
+
+/**
+ * Appends batches of IGC records to a file in a background thread,
+ * and feeds them into the G record digest.  This keeps slow storage
+ * devices from blocking the thread which generates the records.
+ */
+class IGCFileWriter : private StandbyThread {
+public:
+  enum {
+    MAX_LINE_LENGTH = 255,
+
+    /** Number of records in one batch */
+    BATCH_SIZE = 10,
+  };
+
+  typedef BatchBuffer<char[MAX_LINE_LENGTH], BATCH_SIZE> Batch;
+
+  struct Statistics {
+    /** Number of batches that were written */
+    unsigned batches;
+
+    /** Number of batches that were synced to the storage device */
+    unsigned syncs;
+
+    /**
+     * Number of times Submit() had to wait for the previous batch to
+     * be written
+     */
+    unsigned stalls;
+
+    /** Total time spent waiting in Submit() [ms] */
+    unsigned stall_ms;
+
+    /** The longest time needed to write one batch [ms] */
+    unsigned max_write_ms;
+  };
+
+private:
+  /**
+   * Sync the file to the storage device at least this often [ms].
+   */
+  static const unsigned SYNC_INTERVAL = 60000;
+
+  const TCHAR *path;
+
+  GRecord &grecord;
+
+  /**
+   * The batch being written by the thread.  It may only be accessed
+   * while the thread is not busy.  It is cleared after it has been
+   * written successfully; if it is not empty while the thread is
+   * idle, then writing it has failed.
+   */
+  Batch pending;
+
+  /**
+   * The size of the file before #pending was written, or -1 if the
+   * first attempt has not determined it yet.  A retry truncates the
+   * file to this size, discarding whatever a failed attempt has left
+   * behind, and then writes the whole batch again.
+   */
+  long batch_offset;
+
+  /**
+   * Shall the thread sync the file after writing #pending?
+   */
+  bool sync_pending;
+
+  /**
+   * Only accessed by the thread.
+   */
+  PeriodClock sync_clock;
+
+  Statistics statistics;
+
+public:
+  /**
+   * @param path the file to append to; the string must remain valid
+   * as long as this object exists
+   * @param grecord the G record which receives all written records;
+   * the caller may only access it after Wait()
+   */
+  IGCFileWriter(const TCHAR *_path, GRecord &_grecord);
+
+  /**
+   * Waits for the pending batch to be written, and stops the thread.
+   */
+  ~IGCFileWriter();
+
+  /**
+   * Pass the records in the specified batch to the thread, and clear
+   * it.  If the thread is still busy with the previous batch, this
+   * method blocks until it is done.  If writing the previous batch
+   * has failed, it is retried first, and this method blocks until
+   * that is done.
+   *
+   * @param sync sync the file to the storage device after writing
+   * this batch
+   * @return false if the previous batch could still not be written;
+   * the specified batch is left untouched then
+   */
+  bool Submit(Batch &batch, bool sync=false);
+
+  /**
+   * Wait until all submitted records have been written.
+   *
+   * @return false if writing the last batch has failed
+   */
+  bool Wait();
+
+  Statistics GetStatistics();
+
+private:
+  bool Write(bool sync);
+
+  virtual void Tick();
+};
+
+#endif
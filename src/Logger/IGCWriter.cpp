@@ -64,7 +64,8 @@ igc_format_location(char *buffer, const GeoPoint &location)
 }
 
 IGCWriter::IGCWriter(const TCHAR *_path, const NMEAInfo &gps_info)
-  :simulator(gps_info.alive && !gps_info.gps.real)
+  :file_writer(path, grecord),
+   simulator(gps_info.alive && !gps_info.gps.real)
 {
   _tcscpy(path, _path);
 
@@ -78,25 +79,7 @@ IGCWriter::IGCWriter(const TCHAR *_path, const NMEAInfo &gps_info)
 bool
 IGCWriter::Flush()
 {
-  if (buffer.IsEmpty())
-    return true;
-
-  TextWriter writer(path, true);
-  if (writer.error())
-    return false;
-
-  for (unsigned i = 0; i < buffer.Length(); ++i) {
-    if (!writer.writeln(buffer[i]))
-      return false;
-
-    grecord.AppendRecordToBuffer(buffer[i]);
-  }
-
-  if (!writer.flush())
-    return false;
-
-  buffer.Clear();
-  return true;
+  return file_writer.Submit(buffer);
 }
 
 void
@@ -105,7 +88,8 @@ IGCWriter::Finish(const NMEAInfo &gps_info)
   if (gps_info.alive && !gps_info.gps.real)
     simulator = true;
 
-  Flush();
+  file_writer.Submit(buffer, true);
+  file_writer.Wait();
 }
 
 static void
@@ -123,6 +107,8 @@ IGCWriter::WriteLine(const char *line)
   assert(strchr(line, '\n') == NULL);
 
   if (buffer.IsFull() && !Flush())
+    /* the file writer is still stuck with an earlier batch, and the
+       buffer is still full */
     return false;
 
   assert(!buffer.IsFull());
@@ -376,6 +362,9 @@ IGCWriter::Sign()
   if (simulator)
     return;
 
+  /* the file writer thread must be done with the G record */
+  file_writer.Wait();
+
   // buffer is appended w/ each igc file write
   grecord.FinalizeBuffer();
   // read record built by individual file writes
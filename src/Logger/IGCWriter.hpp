@@ -26,7 +26,7 @@ Copyright_License {
 
 #include "Logger/LoggerFRecord.hpp"
 #include "Logger/LoggerGRecord.hpp"
-#include "BatchBuffer.hpp"
+#include "Logger/IGCFileWriter.hpp"
 #include "Math/fixed.hpp"
 #include "Engine/Navigation/GeoPoint.hpp"
 
@@ -40,17 +40,21 @@ struct GeoPoint;
 
 class IGCWriter {
   enum {
-    /** Number of records in disk buffer */
-    LOGGER_DISK_BUFFER_NUM_RECS = 10,
-    MAX_IGC_BUFF = 255,
+    MAX_IGC_BUFF = IGCFileWriter::MAX_LINE_LENGTH,
   };
 
   TCHAR path[MAX_PATH];
-  BatchBuffer<char[MAX_IGC_BUFF],LOGGER_DISK_BUFFER_NUM_RECS> buffer;
+  IGCFileWriter::Batch buffer;
 
   LoggerFRecord frecord;
   GRecord grecord;
 
+  /**
+   * Writes the records to the file in a separate thread.  It owns
+   * #grecord while it is busy.
+   */
+  IGCFileWriter file_writer;
+
   /**
    * If at least one GPS fix came from the simulator
    * (NMEA_INFO.Simulator), then this flag is true, and signing is
@@ -72,10 +76,33 @@ class IGCWriter {
 public:
   IGCWriter(const TCHAR *_path, const NMEAInfo &gps_info);
 
+  /**
+   * Pass the buffered records to the file writer thread.  This does
+   * not wait for them to be written.
+   *
+   * @return false if writing an earlier batch has failed
+   */
   bool Flush();
+
+  /**
+   * Write all buffered records to the file, and wait until they have
+   * reached the storage device.
+   */
   void Finish(const NMEAInfo &gps_info);
+
   void Sign();
 
+  IGCFileWriter::Statistics GetFileStatistics() {
+    return file_writer.GetStatistics();
+  }
+
+  /**
+   * Append a record to the buffer.  Passes the buffer to the file
+   * writer when it is full.
+   *
+   * @return false if the record was discarded, because the file
+   * writer has failed to write an earlier batch
+   */
   bool WriteLine(const char *line);
 
 private:
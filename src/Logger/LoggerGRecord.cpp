@@ -59,23 +59,21 @@ GRecord::AppendRecordToBuffer(const char *record)
 void
 GRecord::AppendStringToBuffer(const unsigned char *in)
 {
-  for (int i = 0; i < 4; i++)
-    // skip whitespace flag=1
-    md5[i].AppendString(in, 1);
+  // skip whitespace flag=1
+  md5.AppendString(in, 1);
 }
 
 void
 GRecord::FinalizeBuffer()
 {
-  for (int i = 0; i < 4; i++)
-    md5[i].Finalize();
+  md5.Finalize();
 }
 
 void
 GRecord::GetDigest(char *output)
 {
-  for (int i = 0; i <= 3; i++)
-    md5[i].GetDigest(output + i * 32);
+  for (unsigned i = 0; i < MD5x4::LANES; i++)
+    md5.GetDigest(i, output + i * 32);
 
   output[128] = '\0';
 }
@@ -86,35 +84,34 @@ GRecord::Initialize(int key_id)
   for (unsigned i = 0; i < BUFF_LEN; i++)
     filename[i] = 0;
 
-  for (unsigned i = 0; i < 3; i++)
-    md5[i].InitDigest();
+  md5.InitDigest();
 
   // 4 different 512 bit keys
   switch (key_id)
   {
   case 2:
     // key 2
-    md5[0].InitKey(0x1C80A301,0x9EB30b89,0x39CB2Afe,0x0D0FEA76);
-    md5[1].InitKey(0x48327203,0x3948ebea,0x9a9b9c9e,0xb3bed89a);
-    md5[2].InitKey(0x67452301,0xefcdab89,0x98badcfe,0x10325476);
-    md5[3].InitKey(0xc8e899e8,0x9321c28a,0x438eba12,0x8cbe0aee);
+    md5.InitKey(0, 0x1C80A301,0x9EB30b89,0x39CB2Afe,0x0D0FEA76);
+    md5.InitKey(1, 0x48327203,0x3948ebea,0x9a9b9c9e,0xb3bed89a);
+    md5.InitKey(2, 0x67452301,0xefcdab89,0x98badcfe,0x10325476);
+    md5.InitKey(3, 0xc8e899e8,0x9321c28a,0x438eba12,0x8cbe0aee);
     break;
 
   case 3:
     // key 3
-    md5[0].InitKey(0x7894abde,0x9cb4e90a,0x0bc8f0ea,0x03a9e01a);
-    md5[1].InitKey(0x3c4a4c93,0x9cbf7ae3,0xa9bcd0ea,0x9a8c2aaa);
-    md5[2].InitKey(0x3c9ae1f1,0x9fe02a1f,0x3fc9a497,0x93cad3ef);
-    md5[3].InitKey(0x41a0c8e8,0xf0e37acf,0xd8bcabe2,0x9bed015a);
+    md5.InitKey(0, 0x7894abde,0x9cb4e90a,0x0bc8f0ea,0x03a9e01a);
+    md5.InitKey(1, 0x3c4a4c93,0x9cbf7ae3,0xa9bcd0ea,0x9a8c2aaa);
+    md5.InitKey(2, 0x3c9ae1f1,0x9fe02a1f,0x3fc9a497,0x93cad3ef);
+    md5.InitKey(3, 0x41a0c8e8,0xf0e37acf,0xd8bcabe2,0x9bed015a);
     break;
 
   case 1:
   default:
     // key 1
-    md5[0].InitKey(0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476);
-    md5[1].InitKey(0x48327203, 0x3948ebea, 0x9a9b9c9e, 0xb3bed89a);
-    md5[2].InitKey(0x67452301, 0xefcdab89,  0x98badcfe, 0x10325476);
-    md5[3].InitKey( 0xc8e899e8, 0x9321c28a, 0x438eba12, 0x8cbe0aee);
+    md5.InitKey(0, 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476);
+    md5.InitKey(1, 0x48327203, 0x3948ebea, 0x9a9b9c9e, 0xb3bed89a);
+    md5.InitKey(2, 0x67452301, 0xefcdab89,  0x98badcfe, 0x10325476);
+    md5.InitKey(3, 0xc8e899e8, 0x9321c28a, 0x438eba12, 0x8cbe0aee);
     break;
   }
 }
@@ -34,11 +34,15 @@ class GRecord
 {
 public:
   enum {
-    DIGEST_LENGTH = 4 * MD5::DIGEST_LENGTH + 1,
+    /**
+     * The size of the buffer for GetDigest(): all lanes in
+     * hexadecimal, and the null terminator.
+     */
+    DIGEST_LENGTH = MD5x4::LANES * MD5::DIGEST_LENGTH * 2 + 1,
   };
 
 private:
-  MD5 md5[4];
+  MD5x4 md5;
 
   enum {
     BUFF_LEN = 255,
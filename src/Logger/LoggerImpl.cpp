@@ -110,6 +110,13 @@ LoggerImpl::StopLogger(const NMEAInfo &gps_info)
   writer->Finish(gps_info);
   writer->Sign();
 
+  const IGCFileWriter::Statistics statistics = writer->GetFileStatistics();
+  LogStartUp(_T("Logger file writer: %u batches, %u syncs, %u stalls (%u ms), "
+                "longest write %u ms"),
+             statistics.batches, statistics.syncs,
+             statistics.stalls, statistics.stall_ms,
+             statistics.max_write_ms);
+
   // Logger off
   delete writer;
   writer = NULL;
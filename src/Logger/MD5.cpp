@@ -23,9 +23,16 @@
 #include "Logger/MD5.hpp"
 #include "Compiler.h"
 
+#include <assert.h>
 #include <stdio.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 static gcc_constexpr_data uint32_t k[64] = {
   // k[i] := floor(abs(sin(i)) * (2 pow 32))
   // RLD should be sin(i + 1) but want compatibility
@@ -269,8 +276,9 @@ MD5::Process512(const unsigned char *s512in)
   h3 = h3 + d;
 }
 
-int
-MD5::GetDigest(char *buffer)
+static void
+FormatDigest(uint32_t h0, uint32_t h1, uint32_t h2, uint32_t h3,
+             char *buffer)
 {
   // extract 4 bytes from each uint32_t
   unsigned char digest[16];
@@ -297,6 +305,389 @@ MD5::GetDigest(char *buffer)
 
   for (int i = 0; i < 16; i++)
     sprintf(buffer + i * 2, "%02x", digest[i]);
+}
+
+int
+MD5::GetDigest(char *buffer)
+{
+  FormatDigest(h0, h1, h2, h3, buffer);
+  return 1;
+}
+
+/*
+ * Four lanes of 32 bit integers, and the operations needed by
+ * MD5x4::Process512().
+ */
+
+#if defined(__SSE2__)
+
+typedef __m128i Lanes;
+
+static inline Lanes
+LoadLanes(const uint32_t *p)
+{
+  return _mm_loadu_si128((const __m128i *)p);
+}
+
+static inline void
+StoreLanes(uint32_t *p, Lanes x)
+{
+  _mm_storeu_si128((__m128i *)p, x);
+}
+
+static inline Lanes
+SplatLanes(uint32_t value)
+{
+  return _mm_set1_epi32(value);
+}
+
+static inline Lanes
+AddLanes(Lanes x, Lanes y)
+{
+  return _mm_add_epi32(x, y);
+}
+
+static inline Lanes
+AndLanes(Lanes x, Lanes y)
+{
+  return _mm_and_si128(x, y);
+}
+
+/**
+ * Calculates (~x & y).
+ */
+static inline Lanes
+AndNotLanes(Lanes x, Lanes y)
+{
+  return _mm_andnot_si128(x, y);
+}
+
+static inline Lanes
+OrLanes(Lanes x, Lanes y)
+{
+  return _mm_or_si128(x, y);
+}
+
+static inline Lanes
+XorLanes(Lanes x, Lanes y)
+{
+  return _mm_xor_si128(x, y);
+}
+
+static inline Lanes
+NotLanes(Lanes x)
+{
+  return _mm_xor_si128(x, _mm_set1_epi32(-1));
+}
+
+static inline Lanes
+RotateLanes(Lanes x, uint32_t c)
+{
+  return _mm_or_si128(_mm_sll_epi32(x, _mm_cvtsi32_si128(c)),
+                      _mm_srl_epi32(x, _mm_cvtsi32_si128(32 - c)));
+}
+
+#elif defined(__ARM_NEON__)
+
+typedef uint32x4_t Lanes;
+
+static inline Lanes
+LoadLanes(const uint32_t *p)
+{
+  return vld1q_u32(p);
+}
+
+static inline void
+StoreLanes(uint32_t *p, Lanes x)
+{
+  vst1q_u32(p, x);
+}
+
+static inline Lanes
+SplatLanes(uint32_t value)
+{
+  return vdupq_n_u32(value);
+}
+
+static inline Lanes
+AddLanes(Lanes x, Lanes y)
+{
+  return vaddq_u32(x, y);
+}
+
+static inline Lanes
+AndLanes(Lanes x, Lanes y)
+{
+  return vandq_u32(x, y);
+}
+
+/**
+ * Calculates (~x & y).
+ */
+static inline Lanes
+AndNotLanes(Lanes x, Lanes y)
+{
+  return vbicq_u32(y, x);
+}
+
+static inline Lanes
+OrLanes(Lanes x, Lanes y)
+{
+  return vorrq_u32(x, y);
+}
+
+static inline Lanes
+XorLanes(Lanes x, Lanes y)
+{
+  return veorq_u32(x, y);
+}
+
+static inline Lanes
+NotLanes(Lanes x)
+{
+  return vmvnq_u32(x);
+}
+
+static inline Lanes
+RotateLanes(Lanes x, uint32_t c)
+{
+  /* a negative shift count shifts to the right */
+  return vorrq_u32(vshlq_u32(x, vdupq_n_s32(c)),
+                   vshlq_u32(x, vdupq_n_s32((int)c - 32)));
+}
+
+#else
+
+struct Lanes {
+  uint32_t v[MD5x4::LANES];
+};
+
+static inline Lanes
+LoadLanes(const uint32_t *p)
+{
+  Lanes result;
+  for (unsigned i = 0; i < MD5x4::LANES; ++i)
+    result.v[i] = p[i];
+  return result;
+}
+
+static inline void
+StoreLanes(uint32_t *p, Lanes x)
+{
+  for (unsigned i = 0; i < MD5x4::LANES; ++i)
+    p[i] = x.v[i];
+}
+
+static inline Lanes
+SplatLanes(uint32_t value)
+{
+  Lanes result;
+  for (unsigned i = 0; i < MD5x4::LANES; ++i)
+    result.v[i] = value;
+  return result;
+}
+
+static inline Lanes
+AddLanes(Lanes x, Lanes y)
+{
+  for (unsigned i = 0; i < MD5x4::LANES; ++i)
+    x.v[i] += y.v[i];
+  return x;
+}
+
+static inline Lanes
+AndLanes(Lanes x, Lanes y)
+{
+  for (unsigned i = 0; i < MD5x4::LANES; ++i)
+    x.v[i] &= y.v[i];
+  return x;
+}
+
+/**
+ * Calculates (~x & y).
+ */
+static inline Lanes
+AndNotLanes(Lanes x, Lanes y)
+{
+  for (unsigned i = 0; i < MD5x4::LANES; ++i)
+    x.v[i] = ~x.v[i] & y.v[i];
+  return x;
+}
+
+static inline Lanes
+OrLanes(Lanes x, Lanes y)
+{
+  for (unsigned i = 0; i < MD5x4::LANES; ++i)
+    x.v[i] |= y.v[i];
+  return x;
+}
+
+static inline Lanes
+XorLanes(Lanes x, Lanes y)
+{
+  for (unsigned i = 0; i < MD5x4::LANES; ++i)
+    x.v[i] ^= y.v[i];
+  return x;
+}
+
+static inline Lanes
+NotLanes(Lanes x)
+{
+  for (unsigned i = 0; i < MD5x4::LANES; ++i)
+    x.v[i] = ~x.v[i];
+  return x;
+}
+
+static inline Lanes
+RotateLanes(Lanes x, uint32_t c)
+{
+  for (unsigned i = 0; i < MD5x4::LANES; ++i)
+    x.v[i] = leftrotate(x.v[i], c);
+  return x;
+}
+
+#endif
+
+void
+MD5x4::InitKey(unsigned lane,
+               uint32_t h0in, uint32_t h1in, uint32_t h2in, uint32_t h3in)
+{
+  assert(lane < LANES);
+
+  h[0][lane] = h0in;
+  h[1][lane] = h1in;
+  h[2][lane] = h2in;
+  h[3][lane] = h3in;
+  message_length_bits = 0;
+}
+
+void
+MD5x4::InitDigest()
+{
+  memset(buff512bits, 0, sizeof(buff512bits));
+  memset(h, 0, sizeof(h));
+  message_length_bits = 0;
+}
+
+void
+MD5x4::AppendString(const unsigned char *in, int skip_invalid_igc_chars)
+{
+  size_t length = strlen((const char *)in);
+  int buffer_left_over = (message_length_bits / 8) % 64;
+
+  for (size_t i = 0; i < length; i++) {
+    if (skip_invalid_igc_chars == 1 && !MD5::IsValidIGCChar(in[i]))
+      continue;
+
+    message_length_bits += 8;
+    buff512bits[buffer_left_over++] = in[i];
+    if (buffer_left_over == 64) {
+      Process512(buff512bits);
+      buffer_left_over = 0;
+    }
+  }
+}
+
+void
+MD5x4::Finalize()
+{
+  int buffer_left_over = (message_length_bits / 8) % 64;
+
+  // append "1" bit and pad with zeros
+  buff512bits[buffer_left_over] = 0x80;
+  memset(buff512bits + buffer_left_over + 1, 0, 63 - buffer_left_over);
+
+  if (buffer_left_over >= 64 - 8) {
+    // no room for the length; pad an additional block
+    Process512(buff512bits);
+    memset(buff512bits, 0, sizeof(buff512bits));
+  }
+
+  // 32 bit message length, little-endian (see MD5::Finalize())
+  buff512bits[56] = (unsigned char)(message_length_bits & 0xFF);
+  buff512bits[57] = (unsigned char)((message_length_bits >> 8) & 0xFF);
+  buff512bits[58] = (unsigned char)((message_length_bits >> 16) & 0xFF);
+  buff512bits[59] = (unsigned char)((message_length_bits >> 24) & 0xFF);
+
+  Process512(buff512bits);
+}
+
+void
+MD5x4::Process512(const unsigned char *s512in)
+{
+  // the message words are the same for all lanes
+  Lanes w[16];
+  for (int j = 0; j < 16; j++)
+    w[j] = SplatLanes((((uint32_t)s512in[(j * 4) + 3]) << 24) |
+                      (((uint32_t)s512in[(j * 4) + 2]) << 16) |
+                      (((uint32_t)s512in[(j * 4) + 1]) << 8) |
+                      ((uint32_t)s512in[(j * 4)]));
+
+  Lanes a = LoadLanes(h[0]), b = LoadLanes(h[1]);
+  Lanes c = LoadLanes(h[2]), d = LoadLanes(h[3]);
+
+  /* one loop per round, to avoid branching on the round number in
+     the inner loop */
+
+  for (int i = 0; i < 16; i++) {
+    Lanes f = OrLanes(AndLanes(b, c), AndNotLanes(b, d));
+    Lanes temp = d;
+    d = c;
+    c = b;
+    b = AddLanes(b, RotateLanes(AddLanes(AddLanes(a, f),
+                                         AddLanes(SplatLanes(k[i]), w[i])),
+                                r[i]));
+    a = temp;
+  }
+
+  for (int i = 16; i < 32; i++) {
+    Lanes f = OrLanes(AndLanes(d, b), AndNotLanes(d, c));
+    Lanes temp = d;
+    d = c;
+    c = b;
+    b = AddLanes(b, RotateLanes(AddLanes(AddLanes(a, f),
+                                         AddLanes(SplatLanes(k[i]),
+                                                  w[(5 * i + 1) % 16])),
+                                r[i]));
+    a = temp;
+  }
+
+  for (int i = 32; i < 48; i++) {
+    Lanes f = XorLanes(XorLanes(b, c), d);
+    Lanes temp = d;
+    d = c;
+    c = b;
+    b = AddLanes(b, RotateLanes(AddLanes(AddLanes(a, f),
+                                         AddLanes(SplatLanes(k[i]),
+                                                  w[(3 * i + 5) % 16])),
+                                r[i]));
+    a = temp;
+  }
+
+  for (int i = 48; i < 64; i++) {
+    Lanes f = XorLanes(c, OrLanes(b, NotLanes(d)));
+    Lanes temp = d;
+    d = c;
+    c = b;
+    b = AddLanes(b, RotateLanes(AddLanes(AddLanes(a, f),
+                                         AddLanes(SplatLanes(k[i]),
+                                                  w[(7 * i) % 16])),
+                                r[i]));
+    a = temp;
+  }
+
+  // Add this chunk's hash to result so far:
+  StoreLanes(h[0], AddLanes(LoadLanes(h[0]), a));
+  StoreLanes(h[1], AddLanes(LoadLanes(h[1]), b));
+  StoreLanes(h[2], AddLanes(LoadLanes(h[2]), c));
+  StoreLanes(h[3], AddLanes(LoadLanes(h[3]), d));
+}
+
+int
+MD5x4::GetDigest(unsigned lane, char *buffer) const
+{
+  assert(lane < LANES);
 
+  FormatDigest(h[0][lane], h[1][lane], h[2][lane], h[3][lane], buffer);
   return 1;
 }
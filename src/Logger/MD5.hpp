@@ -53,4 +53,41 @@ public:
   static bool IsValidIGCChar(char c);
 };
 
+/**
+ * Four MD5 contexts with individual keys, which are fed with the
+ * same message.  The four lanes are computed in parallel (with SSE2
+ * or NEON if available), which is about four times as fast as four
+ * #MD5 instances.
+ */
+class MD5x4
+{
+public:
+  enum {
+    LANES = 4,
+  };
+
+private:
+  unsigned char buff512bits[64];
+
+  /**
+   * The hash state, stored word by word: h[i][lane] is word "hi" of
+   * the specified lane.
+   */
+  uint32_t h[4][LANES];
+
+  // see MD5::message_length_bits
+  uint32_t message_length_bits;
+
+  void Process512(const unsigned char *in);
+
+public:
+  void InitKey(unsigned lane,
+               uint32_t h0in, uint32_t h1in, uint32_t h2in, uint32_t h3in);
+
+  void InitDigest();
+  void AppendString(const unsigned char *in, int skip_invalid_igc_chars); // must be NULL-terminated string!
+  void Finalize();
+  int GetDigest(unsigned lane, char *buffer) const;
+};
+
 #endif
@@ -0,0 +1,338 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Logger/NMEACapture.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <string.h>
+
+using namespace NMEACapture;
+
+static uint8_t *
+WriteVarint(uint8_t *p, unsigned value)
+{
+  while (value >= 0x80) {
+    *p++ = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+
+  *p++ = (uint8_t)value;
+  return p;
+}
+
+/**
+ * @return the position after the number, or NULL if the buffer ends
+ * before the number does
+ */
+static const uint8_t *
+ReadVarint(const uint8_t *p, const uint8_t *end, unsigned &value_r)
+{
+  unsigned value = 0;
+  for (unsigned shift = 0; shift < 32; shift += 7) {
+    if (p == end)
+      return NULL;
+
+    const uint8_t b = *p++;
+    value |= (unsigned)(b & 0x7f) << shift;
+    if ((b & 0x80) == 0) {
+      value_r = value;
+      return p;
+    }
+  }
+
+  /* too long: treat as end of buffer, the caller will detect the
+     malformed record by its size */
+  return NULL;
+}
+
+/**
+ * Split the line at the commas.  The last field extends to the end
+ * of the line.
+ *
+ * @param starts receives the start offset of each field, followed by
+ * the line length plus one
+ * @return the number of fields
+ */
+static unsigned
+SplitFields(const char *line, unsigned length, unsigned *starts)
+{
+  unsigned n = 0;
+  starts[n++] = 0;
+
+  const char *end = line + length;
+  for (const char *p = line; n < MAX_FIELDS; ++p) {
+    p = (const char *)memchr(p, ',', end - p);
+    if (p == NULL)
+      break;
+
+    starts[n++] = p + 1 - line;
+  }
+
+  starts[n] = length + 1;
+  return n;
+}
+
+/**
+ * Choose the history slot for a line by its first field, which is
+ * the sentence name.
+ */
+gcc_pure
+static unsigned
+SelectSlot(const char *line, unsigned length)
+{
+  const char *comma = (const char *)memchr(line, ',', length);
+  const char *end = comma != NULL ? comma : line + length;
+
+  unsigned hash = 0;
+  for (const char *p = line; p != end; ++p)
+    hash = hash * 31 + (unsigned char)*p;
+
+  return (hash ^ (hash >> 4) ^ (hash >> 8)) % SLOTS;
+}
+
+History::History()
+{
+  std::fill(devices, devices + MAX_DEVICES, (Line *)NULL);
+}
+
+History::~History()
+{
+  Clear();
+}
+
+void
+History::Clear()
+{
+  for (unsigned i = 0; i < MAX_DEVICES; ++i) {
+    delete[] devices[i];
+    devices[i] = NULL;
+  }
+}
+
+History::Line &
+History::Get(unsigned device, unsigned slot)
+{
+  assert(device < MAX_DEVICES);
+  assert(slot < SLOTS);
+
+  if (devices[device] == NULL) {
+    devices[device] = new Line[SLOTS];
+    for (unsigned i = 0; i < SLOTS; ++i)
+      devices[device][i].length = 0;
+  }
+
+  return devices[device][slot];
+}
+
+size_t
+Encoder::Encode(uint8_t *dest, unsigned time, unsigned device,
+                const char *line, size_t _length)
+{
+  assert(dest != NULL);
+  assert(line != NULL);
+
+  device %= MAX_DEVICES;
+
+  const unsigned length = std::min(_length, (size_t)MAX_LINE_LENGTH);
+  const unsigned slot = SelectSlot(line, length);
+  Line &previous = Get(device, slot);
+
+  uint8_t *p = WriteVarint(dest, time - last_time);
+  last_time = time;
+
+  *p++ = (uint8_t)(device | (slot << 4));
+
+  unsigned starts[MAX_FIELDS + 1], previous_starts[MAX_FIELDS + 1];
+  const unsigned n = SplitFields(line, length, starts);
+  const unsigned previous_n = SplitFields(previous.data, previous.length,
+                                          previous_starts);
+
+  p = WriteVarint(p, n);
+
+  uint8_t *bitmap = p;
+  p += (n + 7) / 8;
+  std::fill(bitmap, p, 0);
+
+  for (unsigned i = 0; i < n; ++i) {
+    const char *field = line + starts[i];
+    const unsigned field_length = starts[i + 1] - 1 - starts[i];
+
+    if (i < previous_n &&
+        previous_starts[i + 1] - 1 - previous_starts[i] == field_length &&
+        memcmp(previous.data + previous_starts[i], field,
+               field_length) == 0) {
+      bitmap[i / 8] |= 1 << (i % 8);
+      continue;
+    }
+
+    /* numbers often share their leading digits with the previous
+       value */
+    unsigned prefix = 0;
+    if (i < previous_n) {
+      const char *previous_field = previous.data + previous_starts[i];
+      const unsigned previous_length =
+        previous_starts[i + 1] - 1 - previous_starts[i];
+      const unsigned max_prefix = std::min(field_length, previous_length);
+      while (prefix < max_prefix && field[prefix] == previous_field[prefix])
+        ++prefix;
+    }
+
+    p = WriteVarint(p, prefix);
+    p = WriteVarint(p, field_length - prefix);
+    memcpy(p, field + prefix, field_length - prefix);
+    p += field_length - prefix;
+  }
+
+  previous.length = length;
+  memcpy(previous.data, line, length);
+
+  assert(p <= dest + MAX_RECORD_SIZE);
+  return p - dest;
+}
+
+int
+Decoder::Decode(const uint8_t *src, size_t size, Record &record)
+{
+  const uint8_t *p = src, *const end = src + size;
+
+  unsigned delta;
+  p = ReadVarint(p, end, delta);
+  if (p == NULL || p == end)
+    return size >= MAX_RECORD_SIZE ? -1 : 0;
+
+  const unsigned device = *p & 0xf, slot = *p >> 4;
+  ++p;
+
+  unsigned n;
+  p = ReadVarint(p, end, n);
+  if (p == NULL)
+    return size >= MAX_RECORD_SIZE ? -1 : 0;
+
+  if (n == 0 || n > MAX_FIELDS)
+    return -1;
+
+  const uint8_t *bitmap = p;
+  p += (n + 7) / 8;
+  if (p > end)
+    return size >= MAX_RECORD_SIZE ? -1 : 0;
+
+  Line &previous = Get(device, slot);
+  unsigned previous_starts[MAX_FIELDS + 1];
+  const unsigned previous_n = SplitFields(previous.data, previous.length,
+                                          previous_starts);
+
+  unsigned length = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    if (i > 0) {
+      if (length >= MAX_LINE_LENGTH)
+        return -1;
+
+      record.line[length++] = ',';
+    }
+
+    const char *field;
+    unsigned field_length;
+    if (bitmap[i / 8] & (1 << (i % 8))) {
+      if (i >= previous_n)
+        return -1;
+
+      field = previous.data + previous_starts[i];
+      field_length = previous_starts[i + 1] - 1 - previous_starts[i];
+    } else {
+      unsigned prefix, suffix;
+      p = ReadVarint(p, end, prefix);
+      if (p != NULL)
+        p = ReadVarint(p, end, suffix);
+      if (p == NULL || (size_t)(end - p) < suffix)
+        return size >= MAX_RECORD_SIZE ? -1 : 0;
+
+      if (prefix > 0) {
+        if (i >= previous_n ||
+            prefix > previous_starts[i + 1] - 1 - previous_starts[i] ||
+            prefix > MAX_LINE_LENGTH - length)
+          return -1;
+
+        memcpy(record.line + length, previous.data + previous_starts[i],
+               prefix);
+        length += prefix;
+      }
+
+      field = (const char *)p;
+      field_length = suffix;
+      p += suffix;
+    }
+
+    if (field_length > MAX_LINE_LENGTH - length)
+      return -1;
+
+    memcpy(record.line + length, field, field_length);
+    length += field_length;
+  }
+
+  record.line[length] = 0;
+  record.length = length;
+  record.device = device;
+
+  time += delta;
+  record.time = time;
+
+  previous.length = length;
+  memcpy(previous.data, record.line, length);
+
+  return p - src;
+}
+
+bool
+Reader::Read(Record &record)
+{
+  if (!header) {
+    Source<char>::Range range = source.read();
+    if (range.length < sizeof(MAGIC) ||
+        memcmp(range.data, MAGIC, sizeof(MAGIC)) != 0)
+      return false;
+
+    source.consume(sizeof(MAGIC));
+    header = true;
+  }
+
+  unsigned previous_length = 0;
+  while (true) {
+    Source<char>::Range range = source.read();
+    if (range.IsEmpty() || range.length == previous_length)
+      /* end of file, possibly in the middle of a record */
+      return false;
+
+    int nbytes = decoder.Decode((const uint8_t *)range.data, range.length,
+                                record);
+    if (nbytes < 0)
+      return false;
+
+    if (nbytes > 0) {
+      source.consume(nbytes);
+      return true;
+    }
+
+    previous_length = range.length;
+  }
+}
@@ -0,0 +1,162 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_NMEA_CAPTURE_HPP
+#define XCSOAR_NMEA_CAPTURE_HPP
+
+#include "IO/Source.hpp"
+#include "Util/NonCopyable.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * A compact binary format for recording the lines received from all
+ * devices, with a time stamp for each line.
+ *
+ * The file begins with #MAGIC.  Each record contains:
+ *
+ * - the time since the previous record [ms] (varint)
+ * - one byte: the device index in the low nibble, the history slot
+ *   in the high nibble
+ * - the number of comma separated fields (varint)
+ * - a bitmap with one bit per field; a set bit means the field is
+ *   the same as in the previous line in the history slot
+ * - for all other fields: the number of leading characters shared
+ *   with the previous line's field (varint), the length of the rest
+ *   (varint) and the rest
+ *
+ * The history slot is chosen by the encoder, usually by the sentence
+ * name, so consecutive sentences of the same type share most of
+ * their fields.
+ */
+namespace NMEACapture {
+  static const char MAGIC[8] = { 'X', 'C', 'N', 'M', 'E', 'A', 'C', 1 };
+
+  enum {
+    /** Longer lines are truncated */
+    MAX_LINE_LENGTH = 255,
+
+    /** Lines with more fields are split only this often */
+    MAX_FIELDS = 64,
+
+    MAX_DEVICES = 16,
+    SLOTS = 16,
+
+    /** The upper limit for the size of one encoded record */
+    MAX_RECORD_SIZE = 5 + 1 + 1 + MAX_FIELDS / 8
+      + 4 * MAX_FIELDS + MAX_LINE_LENGTH,
+  };
+
+  struct Record {
+    /** Milliseconds since the first record */
+    unsigned time;
+
+    unsigned device;
+
+    /** The length of #line, not including the null terminator */
+    unsigned length;
+
+    char line[MAX_LINE_LENGTH + 1];
+  };
+
+  /**
+   * The previous line of each device and history slot, which is the
+   * reference for the field delta compression.  Encoder and decoder
+   * update it the same way.
+   */
+  class History : private NonCopyable {
+  protected:
+    struct Line {
+      unsigned length;
+      char data[MAX_LINE_LENGTH];
+    };
+
+  private:
+    /** Allocated on demand */
+    Line *devices[MAX_DEVICES];
+
+  public:
+    History();
+    ~History();
+
+    void Clear();
+
+  protected:
+    Line &Get(unsigned device, unsigned slot);
+  };
+
+  class Encoder : private History {
+    unsigned last_time;
+
+  public:
+    Encoder():last_time(0) {}
+
+    /**
+     * Encode one record.
+     *
+     * @param dest a buffer of at least #MAX_RECORD_SIZE bytes
+     * @param time a time stamp [ms]; the difference to the previous
+     * call is stored
+     * @return the number of bytes written to #dest
+     */
+    size_t Encode(uint8_t *dest, unsigned time, unsigned device,
+                  const char *line, size_t length);
+  };
+
+  class Decoder : private History {
+    unsigned time;
+
+  public:
+    Decoder():time(0) {}
+
+    /**
+     * Decode one record.
+     *
+     * @return the number of bytes consumed, 0 if the buffer does not
+     * contain a complete record, or -1 if the data is malformed
+     */
+    int Decode(const uint8_t *src, size_t length, Record &record);
+  };
+
+  /**
+   * Reads the records of a capture file from a #Source.
+   */
+  class Reader {
+    Source<char> &source;
+    Decoder decoder;
+    bool header;
+
+  public:
+    Reader(Source<char> &_source):source(_source), header(false) {}
+
+    /**
+     * Read the next record.
+     *
+     * @return false on end of file or if the file is malformed
+     */
+    bool Read(Record &record);
+  };
+}
+
+#endif
@@ -0,0 +1,121 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Logger/NMEACaptureWriter.hpp"
+#include "IO/BinaryWriter.hpp"
+#include "OS/Clock.hpp"
+
+#include <string.h>
+
+NMEACaptureWriter::NMEACaptureWriter(const TCHAR *_path)
+  :start_time(MonotonicClockMS()),
+   filling_size(sizeof(NMEACapture::MAGIC)), pending_size(0),
+   created(false), written(0), error(false)
+{
+  _tcscpy(path, _path);
+  memcpy(filling, NMEACapture::MAGIC, sizeof(NMEACapture::MAGIC));
+  flush_clock.Update();
+}
+
+NMEACaptureWriter::~NMEACaptureWriter()
+{
+  Flush();
+
+  ScopeLock protect(mutex);
+  WaitDone();
+  Stop();
+}
+
+bool
+NMEACaptureWriter::Write(unsigned device, const char *line)
+{
+  if (filling_size + NMEACapture::MAX_RECORD_SIZE > BUFFER_SIZE &&
+      !Flush())
+    return false;
+
+  filling_size += encoder.Encode(filling + filling_size,
+                                 MonotonicClockMS() - start_time,
+                                 device, line, strlen(line));
+
+  if (flush_clock.Check(FLUSH_INTERVAL))
+    return Flush();
+
+  return true;
+}
+
+bool
+NMEACaptureWriter::Flush()
+{
+  flush_clock.Update();
+
+  ScopeLock protect(mutex);
+
+  /* wait for the previous buffer instead of dropping records */
+  WaitDone();
+
+  if (error) {
+    /* the records in the filling buffer refer to the encoder history
+       of the failed one, so it must be written first */
+    Trigger();
+    WaitDone();
+
+    if (error)
+      return false;
+  }
+
+  if (filling_size == 0)
+    return true;
+
+  memcpy(pending, filling, filling_size);
+  pending_size = filling_size;
+  filling_size = 0;
+
+  Trigger();
+  return true;
+}
+
+void
+NMEACaptureWriter::Tick()
+{
+  const bool append = created;
+  created = true;
+
+  /* after a failure, remove what was written partially */
+  const bool retry = error;
+  const long offset = written;
+
+  mutex.Unlock();
+
+  BinaryWriter writer(path, append);
+  const bool success = !writer.HasError() &&
+    (!retry || writer.Truncate(offset)) &&
+    writer.Write(pending, 1, pending_size) && writer.Flush();
+
+  mutex.Lock();
+
+  error = !success;
+  if (success) {
+    written += pending_size;
+    pending_size = 0;
+  }
+}
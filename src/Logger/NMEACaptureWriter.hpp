@@ -0,0 +1,119 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_NMEA_CAPTURE_WRITER_HPP
+#define XCSOAR_NMEA_CAPTURE_WRITER_HPP
+
+#include "Logger/NMEACapture.hpp"
+#include "Thread/StandbyThread.hpp"
+#include "PeriodClock.hpp"
+
+#include <tchar.h>
+#include <windef.h> /* for MAX_PATH */
+
+/**
+ * Writes an #NMEACapture file.  Records are collected in a buffer,
+ * which is written by a background thread when it is full, or every
+ * few seconds.
+ *
+ * A buffer which could not be written is kept and written again
+ * before the next one, because the records which follow are delta
+ * compressed against it.
+ *
+ * The caller must serialise calls to Write().
+ */
+class NMEACaptureWriter : private StandbyThread {
+  enum {
+    BUFFER_SIZE = 16384,
+  };
+
+  /**
+   * Submit the buffer at least this often [ms], even if it is not
+   * full.
+   */
+  static const unsigned FLUSH_INTERVAL = 10000;
+
+  TCHAR path[MAX_PATH];
+
+  NMEACapture::Encoder encoder;
+
+  /** The time stamp of the first record */
+  unsigned start_time;
+
+  PeriodClock flush_clock;
+
+  uint8_t filling[BUFFER_SIZE];
+  size_t filling_size;
+
+  /**
+   * The buffer being written by the thread.  It may only be accessed
+   * while the thread is not busy.
+   */
+  uint8_t pending[BUFFER_SIZE];
+  size_t pending_size;
+
+  /** Has the thread created the file already? */
+  bool created;
+
+  /**
+   * The number of bytes which have been written to the file
+   * successfully.  A failed write is cut off at this position before
+   * it is repeated.
+   */
+  long written;
+
+  /**
+   * Has writing the #pending buffer failed?  It is then still there,
+   * to be retried.
+   */
+  bool error;
+
+public:
+  NMEACaptureWriter(const TCHAR *_path);
+
+  /**
+   * Writes the remaining records, and stops the thread.
+   */
+  ~NMEACaptureWriter();
+
+  /**
+   * Append a line received from the specified device.
+   *
+   * @return false if writing a previous buffer has failed
+   */
+  bool Write(unsigned device, const char *line);
+
+  /**
+   * Pass the buffer to the thread now.  If writing the previous
+   * buffer has failed, it is retried first, and the new one is kept
+   * until that has succeeded.
+   *
+   * @return false if writing a previous buffer has failed again
+   */
+  bool Flush();
+
+private:
+  virtual void Tick();
+};
+
+#endif
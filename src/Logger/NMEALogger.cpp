@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Logger/NMEALogger.hpp"
+#include "Logger/NMEACaptureWriter.hpp"
 #include "IO/BatchTextWriter.hpp"
 #include "LocalPath.hpp"
 #include "NMEA/Info.hpp"
@@ -36,49 +37,76 @@ namespace NMEALogger
 {
   Mutex mutex;
   BatchTextWriter *writer;
+  NMEACaptureWriter *capture_writer;
 
   bool enabled = false;
+  bool capture_enabled = false;
 
+  void GetPath(TCHAR *path, const TCHAR *suffix);
   bool Start();
+  bool StartCapture();
 }
 
-bool
-NMEALogger::Start()
+void
+NMEALogger::GetPath(TCHAR *path, const TCHAR *suffix)
 {
-  if (writer != NULL)
-    return true;
-
   BrokenDateTime dt = XCSoarInterface::Basic().date_time_utc;
   assert(dt.Plausible());
 
   StaticString<64> name;
-  name.Format(_T("%04u-%02u-%02u_%02u-%02u.nmea"),
+  name.Format(_T("%04u-%02u-%02u_%02u-%02u.%s"),
               dt.year, dt.month, dt.day,
-              dt.hour, dt.minute);
+              dt.hour, dt.minute, suffix);
 
-  TCHAR path[MAX_PATH];
   LocalPath(path, _T("logs"));
   Directory::Create(path);
 
   LocalPath(path, _T("logs"), name);
+}
+
+bool
+NMEALogger::Start()
+{
+  if (writer != NULL)
+    return true;
+
+  TCHAR path[MAX_PATH];
+  GetPath(path, _T("nmea"));
 
   writer = new BatchTextWriter(path, false);
   return writer != NULL;
 }
 
+bool
+NMEALogger::StartCapture()
+{
+  if (capture_writer != NULL)
+    return true;
+
+  TCHAR path[MAX_PATH];
+  GetPath(path, _T("ncap"));
+
+  capture_writer = new NMEACaptureWriter(path);
+  return capture_writer != NULL;
+}
+
 void
 NMEALogger::Shutdown()
 {
   delete writer;
+  delete capture_writer;
 }
 
 void
-NMEALogger::Log(const char *text)
+NMEALogger::Log(unsigned device, const char *text)
 {
-  if (!enabled)
+  if (!enabled && !capture_enabled)
     return;
 
   ScopeLock protect(mutex);
-  if (Start())
+  if (enabled && Start())
     writer->writeln(text);
+
+  if (capture_enabled && StartCapture())
+    capture_writer->Write(device, text);
 }
@@ -28,15 +28,24 @@ Copyright_License {
 
 namespace NMEALogger
 {
+  /** Write the plain text log (.nmea)? */
   extern bool enabled;
 
+  /**
+   * Write the compact capture file (.ncap, see #NMEACapture)?  This
+   * is independent of #enabled.
+   */
+  extern bool capture_enabled;
+
   void Shutdown();
 
   /**
-   * Logs NMEA string to log file
-   * @param text
+   * Logs NMEA string to the text log file and/or the capture file
+   *
+   * @param device the index of the device which has received the
+   * line
    */
-  void Log(const char *line);
+  void Log(unsigned device, const char *line);
 }
 
 #endif
@@ -37,7 +37,8 @@ GlueMapWindow::GlueMapWindow(const Look &look)
    DisplayMode(DM_CRUISE),
    thermal_band_renderer(look.thermal_band, look.chart),
    final_glide_bar_renderer(look.final_glide_bar, look.map.task),
-   map_item_timer(*this)
+   map_item_timer(*this),
+   exchange_statistics(_T("map"))
 {
 }
 
@@ -81,9 +82,18 @@ GlueMapWindow::ExchangeBlackboard()
 {
   /* copy device_blackboard to MapWindow */
 
-  device_blackboard->mutex.Lock();
-  ReadBlackboard(device_blackboard->Basic(), device_blackboard->Calculated());
-  device_blackboard->mutex.Unlock();
+  BasicSnapshot basic;
+  CalculatedSnapshot calculated;
+
+  {
+    ExchangeLock protect(device_blackboard->mutex, exchange_statistics);
+    basic = device_blackboard->GetBasicSnapshot();
+    calculated = device_blackboard->GetCalculatedSnapshot();
+  }
+
+  /* the snapshots are immutable, so the map can keep using them
+     without copying */
+  MapWindowBlackboard::ReadBlackboard(basic, calculated);
 
 #ifndef ENABLE_OPENGL
   next_mutex.Lock();
@@ -159,7 +169,7 @@ bool
 GlueMapWindow::Idle()
 {
   bool still_dirty;
-  bool topography_dirty = true; /* scan topography in every Idle() call */
+  bool topography_dirty = true;
   bool terrain_dirty = true;
   bool weather_dirty = true;
 
@@ -169,7 +179,9 @@ GlueMapWindow::Idle()
     idle_robin = (idle_robin + 1) % 3;
     switch (idle_robin) {
     case 0:
-      topography_dirty = UpdateTopography(1) > 0;
+      /* the shapes are loaded by the TopographyLoader thread */
+      UpdateTopography();
+      topography_dirty = false;
       break;
 
     case 1:
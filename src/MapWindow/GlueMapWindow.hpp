@@ -32,6 +32,7 @@ Copyright_License {
 #include "Screen/Timer.hpp"
 #include "Screen/Features.hpp"
 #include "DisplayMode.hpp"
+#include "Blackboard/ExchangeStatistics.hpp"
 
 #include <array>
 
@@ -131,6 +132,11 @@ class GlueMapWindow : public MapWindow {
 
   WindowTimer map_item_timer;
 
+  /**
+   * Instrumentation of ExchangeBlackboard().
+   */
+  ExchangeStatistics exchange_statistics;
+
 public:
   GlueMapWindow(const Look &look);
 
@@ -147,6 +153,10 @@ public:
    */
   void ExchangeBlackboard();
 
+  const ExchangeStatistics &GetExchangeStatistics() const {
+    return exchange_statistics;
+  }
+
   /**
    * Suspend threads that are owned by this object.
    */
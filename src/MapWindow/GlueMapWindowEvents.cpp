@@ -36,6 +36,7 @@ Copyright_License {
 #include "Math/FastMath.h"
 #include "Compiler.h"
 #include "Interface.hpp"
+#include "LatencyTrace.hpp"
 #include "Screen/Fonts.hpp"
 
 #include <algorithm>
@@ -316,6 +317,9 @@ GlueMapWindow::OnPaintBuffer(Canvas &canvas)
   DrawMapScale(canvas, get_client_rect(), render_projection);
   if (IsPanning())
     DrawPanInfo(canvas);
+
+  if (Basic().location_available)
+    LatencyTrace::Record(LatencyTrace::DRAWN, Basic().time);
 }
 
 bool
@@ -26,11 +26,14 @@ Copyright_License {
 #include "Screen/Layout.hpp"
 #include "Topography/TopographyStore.hpp"
 #include "Topography/TopographyRenderer.hpp"
+#include "Topography/TopographyLoader.hpp"
 #include "Terrain/RasterTerrain.hpp"
+#include "Terrain/TerrainLoader.hpp"
 #include "Terrain/RasterWeather.hpp"
 #include "Computer/GlideComputer.hpp"
 #include "Units/Units.hpp"
 #include "Operation/Operation.hpp"
+#include "Math/Earth.hpp"
 
 #include <tchar.h>
 
@@ -42,8 +45,8 @@ MapWindow::MapWindow(const MapLook &_look,
   :look(_look),
    follow_mode(FOLLOW_SELF),
    waypoints(NULL),
-   topography(NULL), topography_renderer(NULL),
-   terrain(NULL),
+   topography(NULL), topography_renderer(NULL), topography_loader(NULL),
+   terrain(NULL), terrain_loader(NULL),
    terrain_radius(fixed_zero),
    weather(NULL),
    traffic_look(_traffic_look),
@@ -61,7 +64,8 @@ MapWindow::MapWindow(const MapLook &_look,
 
 MapWindow::~MapWindow()
 {
-  delete topography_renderer;
+  SetTerrain(NULL);
+  SetTopography(NULL);
 }
 
 void
@@ -119,13 +123,11 @@ MapWindow::ReadBlackboard(const MoreData &nmea_info,
   ReadMapSettings(settings_map);
 }
 
-unsigned
-MapWindow::UpdateTopography(unsigned max_update)
+void
+MapWindow::UpdateTopography()
 {
   if (topography != NULL && GetMapSettings().topography_enabled)
-    return topography->ScanVisibility(visible_projection, max_update);
-  else
-    return 0;
+    topography_loader->SetProjection(visible_projection);
 }
 
 bool
@@ -140,18 +142,30 @@ MapWindow::UpdateTerrain()
       terrain_center.Distance(location) < fixed(1000))
     return false;
 
-  // always service terrain even if it's not used by the map,
-  // because it's used by other calculations
-  RasterTerrain::ExclusiveLease lease(*terrain);
-  lease->SetViewCenter(location, radius);
-  if (lease->IsDirty())
-    terrain_radius = fixed_zero;
-  else {
-    terrain_radius = radius;
-    terrain_center = location;
+  /* prefetch the tiles the aircraft is heading to, so they are
+     available before it gets there */
+  GeoPoint prefetch_location = location;
+  fixed prefetch_radius = fixed_zero;
+
+  const MoreData &basic = Basic();
+  if (basic.location_available && basic.track_available &&
+      basic.MovementDetected()) {
+    /* where will we be in five minutes? */
+    prefetch_location = FindLatitudeLongitude(basic.location, basic.track,
+                                              basic.ground_speed * 300);
+    prefetch_radius = radius;
   }
 
-  return lease->IsDirty();
+  // always service terrain even if it's not used by the map,
+  // because it's used by other calculations; the tiles are loaded
+  // by the TerrainLoader thread, which keeps going until all tiles
+  // in range are loaded
+  terrain_loader->SetViewCenter(location, radius,
+                                prefetch_location, prefetch_radius);
+  terrain_radius = radius;
+  terrain_center = location;
+
+  return false;
 }
 
 bool
@@ -198,7 +212,16 @@ MapWindow::OnPaintBuffer(Canvas &canvas)
 void
 MapWindow::SetTopography(TopographyStore *_topography)
 {
+  if (topography_loader != NULL) {
+    topography_loader->StopAsync();
+    topography_loader->WaitStopped();
+    delete topography_loader;
+  }
+
   topography = _topography;
+  topography_loader = topography != NULL
+    ? new TopographyLoader(*topography)
+    : NULL;
 
   delete topography_renderer;
   topography_renderer = topography != NULL
@@ -209,7 +232,16 @@ MapWindow::SetTopography(TopographyStore *_topography)
 void
 MapWindow::SetTerrain(RasterTerrain *_terrain)
 {
+  if (terrain_loader != NULL) {
+    terrain_loader->StopAsync();
+    terrain_loader->WaitStopped();
+    delete terrain_loader;
+  }
+
   terrain = _terrain;
+  terrain_loader = terrain != NULL
+    ? new TerrainLoader(*terrain)
+    : NULL;
   terrain_center = GeoPoint(Angle::Zero(),
                             Angle::Zero());
   background.SetTerrain(_terrain);
@@ -46,7 +46,9 @@ struct MapLook;
 struct TrafficLook;
 class TopographyStore;
 class TopographyRenderer;
+class TopographyLoader;
 class RasterTerrain;
+class TerrainLoader;
 class RasterWeather;
 class ProtectedMarkers;
 class Waypoints;
@@ -118,7 +120,20 @@ protected:
   TopographyStore *topography;
   TopographyRenderer *topography_renderer;
 
+  /**
+   * Loads the topography shapes in background.  It is created by
+   * SetTopography().
+   */
+  TopographyLoader *topography_loader;
+
   RasterTerrain *terrain;
+
+  /**
+   * Loads the terrain tiles in background.  It is created by
+   * SetTerrain().
+   */
+  TerrainLoader *terrain_loader;
+
   GeoPoint terrain_center;
   fixed terrain_radius;
 
@@ -263,7 +278,11 @@ public:
   virtual void Render(Canvas &canvas, const PixelRect &rc);
 
 protected:
-  unsigned UpdateTopography(unsigned max_update=1024);
+  /**
+   * Schedule loading the topography shapes for the current
+   * projection.  They are loaded by the #TopographyLoader thread.
+   */
+  void UpdateTopography();
 
   /**
    * @return true if UpdateTerrain() should be called again
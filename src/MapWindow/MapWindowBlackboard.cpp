@@ -23,6 +23,17 @@ Copyright_License {
 
 #include "MapWindowBlackboard.hpp"
 
+MapWindowBlackboard::MapWindowBlackboard()
+{
+  MoreData *basic = new MoreData();
+  basic->Reset();
+  gps_info = BasicSnapshot(basic);
+
+  DerivedInfo *calculated = new DerivedInfo();
+  calculated->Reset();
+  calculated_info = CalculatedSnapshot(calculated);
+}
+
 void
 MapWindowBlackboard::ReadComputerSettings(const ComputerSettings
 					      &settings)
@@ -40,6 +51,14 @@ MapWindowBlackboard::ReadMapSettings(const MapSettings
 void
 MapWindowBlackboard::ReadBlackboard(const MoreData &nmea_info,
 				    const DerivedInfo &derived_info)
+{
+  gps_info = BasicSnapshot(new MoreData(nmea_info));
+  calculated_info = CalculatedSnapshot(new DerivedInfo(derived_info));
+}
+
+void
+MapWindowBlackboard::ReadBlackboard(const BasicSnapshot &nmea_info,
+                                    const CalculatedSnapshot &derived_info)
 {
   gps_info = nmea_info;
   calculated_info = derived_info;
@@ -24,23 +24,45 @@ Copyright_License {
 #ifndef MAP_WINDOW_BLACKBOARD_H
 #define MAP_WINDOW_BLACKBOARD_H
 
-#include "Blackboard/BaseBlackboard.hpp"
+#include "Blackboard/BlackboardSnapshot.hpp"
 #include "Blackboard/ComputerSettingsBlackboard.hpp"
 #include "Blackboard/MapSettingsBlackboard.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+#include "Compiler.h"
 
 /**
  * Blackboard used by map window: provides read-only access to local
  * copies of data required by map window
- * 
+ *
+ * The NMEA and calculated data are shared, immutable snapshots of the
+ * DeviceBlackboard, which saves copying them for each frame.
  */
 class MapWindowBlackboard:
-  public BaseBlackboard,
   public ComputerSettingsBlackboard,
   public MapSettingsBlackboard
 {
+  BasicSnapshot gps_info;
+  CalculatedSnapshot calculated_info;
+
+public:
+  MapWindowBlackboard();
+
+  gcc_pure
+  const MoreData &Basic() const {
+    return *gps_info;
+  }
+
+  gcc_pure
+  const DerivedInfo &Calculated() const {
+    return *calculated_info;
+  }
+
 protected:
   void ReadBlackboard(const MoreData &nmea_info,
                       const DerivedInfo &derived_info);
+  void ReadBlackboard(const BasicSnapshot &nmea_info,
+                      const CalculatedSnapshot &derived_info);
   void ReadComputerSettings(const ComputerSettings &settings);
   void ReadMapSettings(const MapSettings &settings);
 };
@@ -25,6 +25,7 @@ Copyright_License {
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Protection.hpp"
 #include "NMEA/MoreData.hpp"
+#include "LatencyTrace.hpp"
 
 MergeThread::MergeThread(DeviceBlackboard &_device_blackboard)
   :WorkerThread(150, 50, 20),
@@ -54,13 +55,33 @@ MergeThread::Process()
 }
 
 void
-MergeThread::Tick()
+MergeThread::Publish()
 {
+  /* this thread is the only one which modifies Basic(), therefore it
+     may be copied without holding the lock; only the pointer
+     exchange needs it, and the previous snapshot is released after
+     unlocking */
+  BasicSnapshot snapshot(new MoreData(device_blackboard.Basic()));
+
   ScopeLock protect(device_blackboard.mutex);
+  device_blackboard.PublishBasic(snapshot);
+}
+
+void
+MergeThread::Tick()
+{
+  {
+    ScopeLock protect(device_blackboard.mutex);
+    Process();
+  }
 
-  Process();
+  Publish();
 
+  /* see Publish() why Basic() may be read without the lock */
   const MoreData &basic = device_blackboard.Basic();
+  if (basic.location_available.Modified(last_any.location_available))
+    LatencyTrace::Record(LatencyTrace::MERGED, basic.time);
+
   if (last_any.location_available != basic.location_available)
     // trigger update if gps has become available or dropped out
     TriggerGPSUpdate();
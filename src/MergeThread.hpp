@@ -64,6 +64,7 @@ public:
     assert(!IsDefined());
 
     Process();
+    Publish();
   }
 
   bool Start(bool suspended=false) {
@@ -77,6 +78,12 @@ public:
 private:
   void Process();
 
+  /**
+   * Publish a snapshot of DeviceBlackboard::Basic() for the other
+   * threads.  Must be called without holding the blackboard lock.
+   */
+  void Publish();
+
 protected:
   virtual void Tick();
 };
@@ -29,27 +29,79 @@ Copyright_License {
 #include <cstdio>
 #include <stdint.h>
 
-bool
-VerifyNMEAChecksum(const char *p)
+/**
+ * Parse one hexadecimal digit.
+ *
+ * @return the value, or -1 if the character is not a hexadecimal digit
+ */
+gcc_const
+static int
+ParseHexDigit(char ch)
 {
-  assert(p != NULL);
+  if (ch >= '0' && ch <= '9')
+    return ch - '0';
+  else if (ch >= 'A' && ch <= 'F')
+    return ch - 'A' + 10;
+  else if (ch >= 'a' && ch <= 'f')
+    return ch - 'a' + 10;
+  else
+    return -1;
+}
 
-  const char *asterisk = strrchr(p, '*');
-  if (asterisk == NULL)
-    return false;
+/**
+ * Parse the checksum after the asterisk.
+ *
+ * @return the checksum, or -1 on error
+ */
+gcc_pure
+static int
+ParseChecksum(const char *p)
+{
+  /* fast path for the usual two digits */
+  const int high = ParseHexDigit(p[0]);
+  if (high >= 0) {
+    const int low = ParseHexDigit(p[1]);
+    if (low >= 0 && p[2] == 0)
+      return (high << 4) | low;
+  }
 
-  const char *checksum_string = asterisk + 1;
+  /* everything else the way strtoul() parses it */
   char *endptr;
-  unsigned long ReadCheckSum2 = strtoul(checksum_string, &endptr, 16);
-  if (endptr == checksum_string || *endptr != 0 || ReadCheckSum2 >= 0x100)
+  unsigned long value = strtoul(p, &endptr, 16);
+  if (endptr == p || *endptr != 0 || value >= 0x100)
+    return -1;
+
+  return (int)value;
+}
+
+bool
+VerifyNMEAChecksum(const char *p, const char *asterisk)
+{
+  assert(p != NULL);
+  assert(asterisk >= p);
+  assert(*asterisk == '*');
+
+  const int ReadCheckSum = ParseChecksum(asterisk + 1);
+  if (ReadCheckSum < 0)
     return false;
 
-  uint8_t ReadCheckSum = (unsigned char)ReadCheckSum2;
   uint8_t CalcCheckSum = NMEAChecksum(p, asterisk - p);
 
   return CalcCheckSum == ReadCheckSum;
 }
 
+bool
+VerifyNMEAChecksum(const char *p)
+{
+  assert(p != NULL);
+
+  const char *asterisk = strrchr(p, '*');
+  if (asterisk == NULL)
+    return false;
+
+  return VerifyNMEAChecksum(p, asterisk);
+}
+
 void
 AppendNMEAChecksum(char *p)
 {
@@ -26,6 +26,9 @@ Copyright_License {
 
 #include "Compiler.h"
 
+#include <stddef.h>
+#include <string.h>
+
 /**
  * Calculates the checksum for the specified line (without the
  * asterisk and the newline character).
@@ -58,18 +61,31 @@ NMEAChecksum(const char *p)
 static inline unsigned char
 NMEAChecksum(const char *p, unsigned length)
 {
-  unsigned char checksum = 0;
-
-  unsigned i = 0;
-
   /* skip the dollar sign at the beginning (the exclamation mark is
      used by CAI302 */
   if (length > 0 && (*p == '$' || *p == '!')) {
-    ++i;
     ++p;
+    --length;
+  }
+
+  /* XOR whole machine words; since XOR is associative, the bytes of
+     the result only need to be folded at the end, regardless of the
+     byte order */
+  size_t word_checksum = 0;
+  for (; length >= sizeof(word_checksum);
+       p += sizeof(word_checksum), length -= sizeof(word_checksum)) {
+    size_t word;
+    memcpy(&word, p, sizeof(word));
+    word_checksum ^= word;
+  }
+
+  unsigned char checksum = 0;
+  for (unsigned i = 0; i < sizeof(word_checksum); ++i) {
+    checksum ^= (unsigned char)word_checksum;
+    word_checksum >>= 8;
   }
 
-  for (; i < length; ++i)
+  while (length-- > 0)
     checksum ^= *p++;
 
   return checksum;
@@ -83,6 +99,14 @@ gcc_pure
 bool
 VerifyNMEAChecksum(const char *p);
 
+/**
+ * Same as VerifyNMEAChecksum(const char *), but the caller has
+ * already located the last asterisk.
+ */
+gcc_pure
+bool
+VerifyNMEAChecksum(const char *p, const char *asterisk);
+
 /**
  * Caclulates the checksum of the specified string, and appends it at
  * the end, preceded by an asterisk ('*').
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "NMEA/InputLine.hpp"
+#include "NMEA/Sentence.hpp"
 
 #include <string.h>
 
@@ -32,3 +33,7 @@ NMEAInputLine::NMEAInputLine(const char* line):
   if (asterisk != NULL)
     end = asterisk;
 }
+
+NMEAInputLine::NMEAInputLine(const NMEASentence &sentence):
+  CSVLine(sentence.line, sentence.line + sentence.asterisk,
+          sentence.separators, sentence.n_separators) {}
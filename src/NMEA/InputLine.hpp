@@ -26,12 +26,20 @@ Copyright_License {
 
 #include "IO/CSVLine.hpp"
 
+struct NMEASentence;
+
 /**
  * A helper class which can dissect a NMEA input line.
  */
 class NMEAInputLine: public CSVLine {
 public:
   NMEAInputLine(const char* line);
+
+  /**
+   * Dissect a line which has been pre-tokenised by the NMEA
+   * splitter.  Skipping fields does not need to search for commas.
+   */
+  NMEAInputLine(const NMEASentence &sentence);
 };
 
 #endif
@@ -0,0 +1,204 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "NMEA/Sentence.hpp"
+#include "NMEA/Checksum.hpp"
+#include "Util/CharUtil.hpp"
+
+#include <assert.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * The state of one line while it is being scanned.
+ */
+struct SentenceScanner {
+  NMEASentence &sentence;
+
+  /**
+   * The position of the last asterisk, or -1.
+   */
+  ptrdiff_t last_asterisk;
+
+  /**
+   * The position of the first null byte, or -1.  Garbage received
+   * from the port may contain them; the line ends there.
+   */
+  ptrdiff_t first_null;
+
+  SentenceScanner(NMEASentence &_sentence, const char *line)
+    :sentence(_sentence), last_asterisk(-1), first_null(-1) {
+    sentence.line = line;
+    sentence.asterisk = (size_t)-1;
+    sentence.n_separators = 0;
+  }
+
+  /**
+   * Handle one of the special characters found by Scan().
+   *
+   * @return false if it is the end of the line
+   */
+  bool Special(size_t position, char ch) {
+    switch (ch) {
+    case ',':
+      if (sentence.asterisk == (size_t)-1 &&
+          sentence.n_separators < NMEASentence::MAX_SEPARATORS &&
+          position <= 0xffff)
+        sentence.separators[sentence.n_separators++] = position;
+      return true;
+
+    case '*':
+      if (sentence.asterisk == (size_t)-1)
+        sentence.asterisk = position;
+      last_asterisk = position;
+      return true;
+
+    case '\0':
+      if (first_null < 0)
+        first_null = position;
+      return true;
+
+    default:
+      return false;
+    }
+  }
+
+  /**
+   * Scan the line for commas, asterisks, null bytes and the newline
+   * character.
+   *
+   * @return the position of the newline character, or the length of
+   * the buffer if there is none
+   */
+  size_t Scan(size_t length) {
+    const char *p = sentence.line;
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    /* classify 16 bytes at a time, and visit only the special
+       characters */
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i asterisk = _mm_set1_epi8('*');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i null = _mm_setzero_si128();
+
+    for (; i + 16 <= length; i += 16) {
+      const __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+      const __m128i a = _mm_or_si128(_mm_cmpeq_epi8(v, comma),
+                                     _mm_cmpeq_epi8(v, asterisk));
+      const __m128i b = _mm_or_si128(_mm_cmpeq_epi8(v, newline),
+                                     _mm_cmpeq_epi8(v, null));
+      unsigned mask = _mm_movemask_epi8(_mm_or_si128(a, b));
+      while (mask != 0) {
+        const size_t position = i + __builtin_ctz(mask);
+        mask &= mask - 1;
+
+        if (!Special(position, p[position]))
+          return position;
+      }
+    }
+#endif
+
+    for (; i < length; ++i) {
+      const char ch = p[i];
+      if ((ch == ',' || ch == '*' || ch == '\n' || ch == '\0') &&
+          !Special(i, ch))
+        return i;
+    }
+
+    return length;
+  }
+
+  /**
+   * Finish the sentence after the line length is known.
+   */
+  void Finish(size_t length) {
+    if (first_null >= 0 && (size_t)first_null < length) {
+      /* the string ends at the null byte; forget everything after
+         it */
+      length = first_null;
+
+      while (sentence.n_separators > 0 &&
+             sentence.separators[sentence.n_separators - 1] >= length)
+        --sentence.n_separators;
+
+      if (last_asterisk >= first_null) {
+        last_asterisk = -1;
+        for (size_t i = 0; i < length; ++i)
+          if (sentence.line[i] == '*')
+            last_asterisk = i;
+      }
+    }
+
+    sentence.length = length;
+
+    if (sentence.asterisk == (size_t)-1 || sentence.asterisk > length)
+      sentence.asterisk = length;
+
+    sentence.checksum_valid = last_asterisk >= 0 &&
+      VerifyNMEAChecksum(sentence.line, sentence.line + last_asterisk);
+  }
+};
+
+void
+NMEASentence::Parse(const char *_line)
+{
+  SentenceScanner scanner(*this, _line);
+  const size_t _length = strlen(_line);
+  scanner.Scan(_length);
+  scanner.Finish(_length);
+}
+
+size_t
+SplitNMEA(char *data, size_t length, NMEASentenceHandler &handler)
+{
+  NMEASentence sentence;
+
+  size_t consumed = 0;
+  while (consumed < length) {
+    char *line = data + consumed;
+    SentenceScanner scanner(sentence, line);
+
+    const size_t newline = scanner.Scan(length - consumed);
+    if (newline == length - consumed)
+      /* no newline here: wait for more data */
+      break;
+
+    /* remove trailing whitespace, such as '\r' */
+    char *end = line + newline;
+    while (end > line && IsWhitespaceOrNull(end[-1]))
+      --end;
+
+    *end = '\0';
+    scanner.Finish(end - line);
+
+    handler.SentenceReceived(sentence);
+
+    consumed += newline + 1;
+  }
+
+  return consumed;
+}
@@ -0,0 +1,93 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_NMEA_SENTENCE_HPP
+#define XCSOAR_NMEA_SENTENCE_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * A NMEA line which has been dissected in advance: the positions of
+ * the field separators and of the asterisk are known, and the
+ * checksum has been verified.  NMEAInputLine uses this to skip
+ * fields without scanning for commas again.
+ */
+struct NMEASentence {
+  /**
+   * The maximum number of separator positions which are recorded.
+   * NMEAInputLine searches for the commas after that.
+   */
+  static const unsigned MAX_SEPARATORS = 48;
+
+  /**
+   * The null-terminated line, without the line ending.
+   */
+  const char *line;
+
+  size_t length;
+
+  /**
+   * The position of the first asterisk, which ends the last field;
+   * equals #length if there is none.
+   */
+  size_t asterisk;
+
+  /**
+   * Is there a checksum, and does it match?  The checksum follows
+   * the last asterisk, see VerifyNMEAChecksum().
+   */
+  bool checksum_valid;
+
+  unsigned n_separators;
+
+  /**
+   * The positions of the first #n_separators commas before
+   * #asterisk.
+   */
+  uint16_t separators[MAX_SEPARATORS];
+
+  /**
+   * Dissect a single line.  The line ending must have been removed
+   * already.
+   */
+  void Parse(const char *line);
+};
+
+class NMEASentenceHandler {
+public:
+  virtual void SentenceReceived(const NMEASentence &sentence) = 0;
+};
+
+/**
+ * Find all complete lines in the buffer, dissect them in one pass
+ * and pass them to the handler.  The line endings and the trailing
+ * whitespace of the lines are overwritten with null bytes.
+ *
+ * @return the number of bytes which were consumed; the rest is an
+ * incomplete line
+ */
+size_t
+SplitNMEA(char *data, size_t length, NMEASentenceHandler &handler);
+
+#endif
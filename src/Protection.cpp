@@ -31,11 +31,38 @@ Copyright_License {
 #include "MergeThread.hpp"
 #include "DrawThread.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
+#include "PeriodClock.hpp"
 
 #include <assert.h>
 
 Flag globalRunningEvent;
 
+/**
+ * This mutex protects #ui_update_interval and the clocks below.  The
+ * triggers are called by both the MergeThread and the
+ * CalculationThread.
+ */
+static Mutex ui_update_mutex;
+
+/**
+ * The minimum interval between two UI updates [ms] during a time
+ * warp replay.  Zero means every update is passed to the UI.
+ */
+static unsigned ui_update_interval;
+
+static PeriodClock vario_update_clock, calculated_update_clock;
+
+/**
+ * Check whether a UI update shall be sent now, or whether it shall
+ * be skipped because of the time warp rate limit.
+ */
+static bool
+CheckUIUpdate(PeriodClock &clock)
+{
+  ScopeLock protect(ui_update_mutex);
+  return ui_update_interval == 0 || clock.CheckUpdate(ui_update_interval);
+}
+
 void
 TriggerMergeThread()
 {
@@ -58,7 +85,8 @@ TriggerGPSUpdate()
 void
 TriggerVarioUpdate()
 {
-  CommonInterface::main_window.SendGPSUpdate();
+  if (CheckUIUpdate(vario_update_clock))
+    CommonInterface::main_window.SendGPSUpdate();
 }
 
 void
@@ -70,7 +98,8 @@ TriggerMapUpdate()
 void
 TriggerCalculatedUpdate()
 {
-  CommonInterface::main_window.SendCalculatedUpdate();
+  if (CheckUIUpdate(calculated_update_clock))
+    CommonInterface::main_window.SendCalculatedUpdate();
 }
 
 void
@@ -103,6 +132,39 @@ CreateCalculationThread()
   calculation_thread = new CalculationThread(*glide_computer);
 }
 
+void
+BeginTimeWarp(unsigned _ui_update_interval)
+{
+  assert(_ui_update_interval > 0);
+
+  {
+    ScopeLock protect(ui_update_mutex);
+    ui_update_interval = _ui_update_interval;
+    vario_update_clock.Update();
+    calculated_update_clock.Update();
+  }
+
+  merge_thread->SetThrottle(false);
+  calculation_thread->SetThrottle(false);
+}
+
+void
+EndTimeWarp()
+{
+  merge_thread->SetThrottle(true);
+  calculation_thread->SetThrottle(true);
+
+  {
+    ScopeLock protect(ui_update_mutex);
+    ui_update_interval = 0;
+  }
+
+  /* show the final state, which may have been skipped by the rate
+     limit */
+  TriggerVarioUpdate();
+  TriggerCalculatedUpdate();
+}
+
 void
 SuspendAllThreads()
 {
@@ -59,6 +59,24 @@ TriggerAirspaceWarning();
 
 void CreateCalculationThread();
 
+/**
+ * Remove the rate limits of the #MergeThread and the
+ * #CalculationThread, so a replay can feed fixes as fast as they can
+ * be processed.  Map and vario updates are sent to the UI only once
+ * per interval.
+ *
+ * @param ui_update_interval the minimum interval between two UI
+ * updates [ms]
+ */
+void
+BeginTimeWarp(unsigned ui_update_interval);
+
+/**
+ * Restore the normal operation after BeginTimeWarp().
+ */
+void
+EndTimeWarp();
+
 // changed only in config or by user interface
 // used in settings dialog
 extern bool DevicePortChanged;
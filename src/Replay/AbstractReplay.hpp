@@ -31,11 +31,18 @@ class AbstractReplay
 public:
   fixed time_scale;
 
+  /**
+   * If true, then the replay is not paced by the clock: each
+   * Update() call advances by #time_scale seconds of replay time.
+   */
+  bool time_warp;
+
 protected:
   bool enabled;
 
 public:
-  AbstractReplay(): time_scale(fixed_one), enabled(false) {}
+  AbstractReplay()
+    :time_scale(fixed_one), time_warp(false), enabled(false) {}
   virtual bool Update() = 0;
   virtual void Stop() = 0;
   virtual void Start() = 0;
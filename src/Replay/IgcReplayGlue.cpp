@@ -38,6 +38,9 @@ IgcReplayGlue::IgcReplayGlue(Logger *_logger)
 bool
 IgcReplayGlue::UpdateTime()
 {
+  if (time_warp)
+    return IgcReplay::UpdateTime();
+
   // Allow for poor time slicing, we never get called more
   // than 4 times per second, so this will yield 1 second updates
   if (!clock.Check(760))
@@ -23,22 +23,24 @@
 
 #include "Replay/NmeaReplay.hpp"
 #include "IO/FileLineReader.hpp"
+#include "IO/FileSource.hpp"
 
 #include <algorithm>
 
 #include "Navigation/GeoPoint.hpp"
 #include "StringUtil.hpp"
+#include "OS/PathName.hpp"
 
 NmeaReplay::NmeaReplay() :
   AbstractReplay(),
-  reader(NULL)
+  reader(NULL), capture_file(NULL), capture_reader(NULL)
 {
   file_name[0] = _T('\0');
 }
 
 NmeaReplay::~NmeaReplay()
 {
-  delete reader;
+  CloseFile();
 }
 
 void
@@ -86,7 +88,7 @@ NmeaReplay::ReadUntilRMC(bool ignore)
 
   while ((buffer = reader->read()) != NULL) {
     if (!ignore)
-      OnSentence(buffer);
+      OnSentence(buffer, 0);
 
     if (strstr(buffer, "$GPRMC") == buffer)
       return true;
@@ -104,6 +106,16 @@ NmeaReplay::Update()
   if (!UpdateTime())
     return true;
 
+  if (capture_reader != NULL) {
+    enabled = ReadCapture();
+    if (!enabled) {
+      Stop();
+      return false;
+    }
+
+    return true;
+  }
+
   for (fixed i = fixed_one; i <= time_scale; i += fixed_one) {
     enabled = ReadUntilRMC(i != time_scale);
     if (!enabled) {
@@ -116,15 +128,62 @@ NmeaReplay::Update()
   return true;
 }
 
+bool
+NmeaReplay::ReadCapture()
+{
+  if (!positive(time_scale))
+    return true;
+
+  unsigned until = capture_time + (unsigned)(time_scale * 1000);
+  bool delivered = false;
+
+  while (true) {
+    if (!capture_record_pending) {
+      if (!capture_reader->Read(capture_record))
+        return false;
+
+      capture_record_pending = true;
+    }
+
+    if (capture_record.time > until) {
+      if (delivered)
+        break;
+
+      /* skip periods without data */
+      until = capture_record.time;
+    }
+
+    OnSentence(capture_record.line, capture_record.device);
+    capture_record_pending = false;
+    delivered = true;
+  }
+
+  capture_time = until;
+  return true;
+}
+
 bool
 NmeaReplay::OpenFile()
 {
-  if (reader)
+  if (reader != NULL || capture_reader != NULL)
     return true;
 
   if (StringIsEmpty(file_name))
     return false;
 
+  if (MatchesExtension(file_name, _T(".ncap"))) {
+    capture_file = new FileSource(file_name);
+    if (capture_file->error()) {
+      CloseFile();
+      return false;
+    }
+
+    capture_reader = new NMEACapture::Reader(*capture_file);
+    capture_time = 0;
+    capture_record_pending = false;
+    return true;
+  }
+
   reader = new FileLineReaderA(file_name);
   if (reader->error()) {
     CloseFile();
@@ -139,6 +198,11 @@ NmeaReplay::CloseFile()
 {
   delete reader;
   reader = NULL;
+
+  delete capture_reader;
+  capture_reader = NULL;
+  delete capture_file;
+  capture_file = NULL;
 }
 
 bool
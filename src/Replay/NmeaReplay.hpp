@@ -25,17 +25,42 @@ Copyright_License {
 #define NMEA_REPLAY_HPP
 
 #include "AbstractReplay.hpp"
+#include "Logger/NMEACapture.hpp"
 
 #include <tchar.h>
 #include <windef.h> /* for MAX_PATH */
 
 class FileLineReaderA;
+class FileSource;
 
+/**
+ * Replays a text file with NMEA lines, or a capture file written by
+ * the #NMEALogger (see #NMEACapture).
+ */
 class NmeaReplay: public AbstractReplay
 {
   TCHAR file_name[MAX_PATH];
   FileLineReaderA *reader;
 
+  /**
+   * The capture file being replayed; used instead of #reader for
+   * files with the ".ncap" extension.
+   */
+  FileSource *capture_file;
+  NMEACapture::Reader *capture_reader;
+
+  /**
+   * The capture time up to which all records have been replayed
+   * [ms].
+   */
+  unsigned capture_time;
+
+  /**
+   * The record which was read, but is not yet due.
+   */
+  NMEACapture::Record capture_record;
+  bool capture_record_pending;
+
 public:
   NmeaReplay();
   ~NmeaReplay();
@@ -50,12 +75,22 @@ protected:
   virtual bool UpdateTime();
   virtual void ResetTime() = 0;
   virtual void OnBadFile() = 0;
-  virtual void OnSentence(const char *line) = 0;
+
+  /**
+   * @param device the index of the device which has received the
+   * line; always 0 for text files
+   */
+  virtual void OnSentence(const char *line, unsigned device) = 0;
 
 private:
   bool OpenFile();
   void CloseFile();
   bool ReadUntilRMC(bool ignore);
+
+  /**
+   * Replay the capture records of the next #time_scale seconds.
+   */
+  bool ReadCapture();
 };
 
 #endif
@@ -31,39 +31,51 @@
 #include "Components.hpp"
 #include "Interface.hpp"
 
+#include <algorithm>
+
 NmeaReplayGlue::NmeaReplayGlue()
-  :parser(NULL), device(NULL)
 {
+  std::fill(parsers, parsers + NUMDEV, (NMEAParser *)NULL);
+  std::fill(devices, devices + NUMDEV, (Device *)NULL);
 }
 
 NmeaReplayGlue::~NmeaReplayGlue()
 {
-  delete device;
-  delete parser;
+  for (unsigned i = 0; i < NUMDEV; ++i) {
+    delete devices[i];
+    delete parsers[i];
+  }
 }
 
 void
 NmeaReplayGlue::Start()
 {
-  assert(parser == NULL);
-  assert(device == NULL);
-
-  parser = new NMEAParser();
-  parser->SetReal(false);
-
-  /* get the device driver name from the profile */
-  const DeviceConfig &config =
-    CommonInterface::GetSystemSettings().devices[0];
-
-  parser->SetIgnoreChecksum(config.ignore_checksum);
-
-  /* instantiate it */
-  const struct DeviceRegister *driver = FindDriverByName(config.driver_name);
-  assert(driver != NULL);
-  if (driver->CreateOnPort != NULL) {
-    DeviceConfig config;
-    config.Clear();
-    device = driver->CreateOnPort(config, port);
+  assert(parsers[0] == NULL);
+  assert(devices[0] == NULL);
+
+  for (unsigned i = 0; i < NUMDEV; ++i) {
+    /* get the device driver name from the profile */
+    const DeviceConfig &config =
+      CommonInterface::GetSystemSettings().devices[i];
+
+    /* the first parser handles lines from text files, it is
+       always needed */
+    if (i > 0 && !config.IsAvailable())
+      continue;
+
+    parsers[i] = new NMEAParser();
+    parsers[i]->SetReal(false);
+    parsers[i]->SetIgnoreChecksum(config.ignore_checksum);
+
+    /* instantiate it */
+    const struct DeviceRegister *driver =
+      FindDriverByName(config.driver_name);
+    assert(driver != NULL || i > 0);
+    if (driver != NULL && driver->CreateOnPort != NULL) {
+      DeviceConfig config;
+      config.Clear();
+      devices[i] = driver->CreateOnPort(config, port);
+    }
   }
 
   NmeaReplay::Start();
@@ -74,18 +86,27 @@ NmeaReplayGlue::Stop()
 {
   NmeaReplay::Stop();
 
-  delete device;
-  device = NULL;
-  delete parser;
-  parser = NULL;
+  for (unsigned i = 0; i < NUMDEV; ++i) {
+    delete devices[i];
+    devices[i] = NULL;
+    delete parsers[i];
+    parsers[i] = NULL;
+  }
 
   device_blackboard->StopReplay();
 }
 
 void
-NmeaReplayGlue::OnSentence(const char *line)
+NmeaReplayGlue::OnSentence(const char *line, unsigned i)
 {
-  assert(device != NULL);
+  if (i >= NUMDEV || parsers[i] == NULL)
+    /* not configured anymore: fall back to the first device */
+    i = 0;
+
+  assert(parsers[i] != NULL);
+
+  Device *device = devices[i];
+  NMEAParser *parser = parsers[i];
 
   ScopeLock protect(device_blackboard->mutex);
   NMEAInfo &data = device_blackboard->SetReplayState();
@@ -108,6 +129,9 @@ NmeaReplayGlue::OnBadFile()
 bool
 NmeaReplayGlue::UpdateTime()
 {
+  if (time_warp)
+    return NmeaReplay::UpdateTime();
+
   return clock.CheckUpdate(1000);
 }
 
@@ -27,6 +27,7 @@ Copyright_License {
 #include "Replay/NmeaReplay.hpp"
 #include "PeriodClock.hpp"
 #include "Device/Port/NullPort.hpp"
+#include "Device/List.hpp"
 
 class Device;
 class NMEAParser;
@@ -35,8 +36,14 @@ class NmeaReplayGlue:
   public NmeaReplay
 {
   NullPort port;
-  NMEAParser *parser;
-  Device *device;
+
+  /**
+   * A parser and a driver for each configured device.  Lines from
+   * capture files are passed to the ones of the device which has
+   * received them.
+   */
+  NMEAParser *parsers[NUMDEV];
+  Device *devices[NUMDEV];
 
   PeriodClock clock;
 
@@ -51,7 +58,7 @@ protected:
   virtual bool UpdateTime();
   virtual void ResetTime();
   virtual void OnBadFile();
-  virtual void OnSentence(const char *line);
+  virtual void OnSentence(const char *line, unsigned device);
 };
 
 #endif
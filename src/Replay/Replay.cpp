@@ -24,6 +24,17 @@
 #include "Replay/Replay.hpp"
 #include "Util/StringUtil.hpp"
 #include "OS/PathName.hpp"
+#include "Protection.hpp"
+#include "CalculationThread.hpp"
+#include "Blackboard/DeviceBlackboard.hpp"
+#include "Components.hpp"
+#include "LogFile.hpp"
+#include "Message.hpp"
+#include "Language/Language.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <stdio.h>
 
 void
 Replay::Stop()
@@ -42,17 +53,28 @@ Replay::Stop()
   case MODE_NULL:
     break;
   };
+
+  if (warp_active)
+    FinishTimeWarp();
 }
 
 void
 Replay::Start()
 {
+  if (warp_active)
+    FinishTimeWarp();
+
+  igc_replay.time_warp = time_warp;
+  nmea_replay.time_warp = time_warp;
+
   switch (mode) {
   case MODE_IGC:
     igc_replay.Start();
+    warp_active = time_warp && igc_replay.IsEnabled();
     break;
   case MODE_NMEA:
     nmea_replay.Start();
+    warp_active = time_warp && nmea_replay.IsEnabled();
     break;
   case MODE_DEMO:
     demo_replay.Start();
@@ -62,6 +84,12 @@ Replay::Start()
     mode = MODE_DEMO;
     break;
   };
+
+  if (warp_active) {
+    warp_feeder.Reset();
+    warp_clock.Update();
+    BeginTimeWarp(redraw_interval);
+  }
 }
 
 const TCHAR*
@@ -91,7 +119,7 @@ Replay::SetFilename(const TCHAR *name)
 
 
 bool
-Replay::Update()
+Replay::UpdateOnce()
 {
   switch (mode) {
   case MODE_IGC:
@@ -106,6 +134,72 @@ Replay::Update()
   return false;
 }
 
+bool
+Replay::FeedFix(bool &fed)
+{
+  Validity previous;
+  {
+    ScopeLock protect(device_blackboard->mutex);
+    previous = device_blackboard->SetReplayState().location_available;
+  }
+
+  calculation_thread->ResetFixProcessed();
+
+  if (!UpdateOnce())
+    return false;
+
+  ScopeLock protect(device_blackboard->mutex);
+  fed = device_blackboard->SetReplayState().location_available.Modified(previous);
+  return true;
+}
+
+bool
+Replay::WaitFixProcessed(unsigned timeout_ms)
+{
+  return calculation_thread->WaitFixProcessed(timeout_ms);
+}
+
+bool
+Replay::UpdateTimeWarp()
+{
+  if (!warp_feeder.Update(*this)) {
+    FinishTimeWarp();
+    return false;
+  }
+
+  return true;
+}
+
+void
+Replay::FinishTimeWarp()
+{
+  assert(warp_active);
+
+  warp_active = false;
+  EndTimeWarp();
+
+  const unsigned elapsed = std::max(warp_clock.Elapsed(), 1);
+  const unsigned fixes = warp_feeder.GetFixCount();
+  const unsigned rate = (unsigned)((unsigned long long)fixes * 1000
+                                   / elapsed);
+
+  LogStartUp(_T("Time warp replay: %u fixes in %u ms (%u fixes/s)"),
+             fixes, elapsed, rate);
+
+  TCHAR buffer[64];
+  _stprintf(buffer, _T("%u fixes/s"), rate);
+  Message::AddMessage(_("Replay finished"), buffer);
+}
+
+bool
+Replay::Update()
+{
+  if (warp_active && positive(GetTimeScale()))
+    return UpdateTimeWarp();
+
+  return UpdateOnce();
+}
+
 fixed
 Replay::GetTimeScale()
 {
@@ -27,6 +27,8 @@ Copyright_License {
 #include "Replay/IgcReplayGlue.hpp"
 #include "Replay/NmeaReplayGlue.hpp"
 #include "Replay/DemoReplayGlue.hpp"
+#include "Replay/TimeWarpFeeder.hpp"
+#include "PeriodClock.hpp"
 
 #include <tchar.h>
 #include <windef.h> /* for MAX_PATH */
@@ -34,7 +36,7 @@ Copyright_License {
 
 class ProtectedTaskManager;
 
-class Replay
+class Replay : private TimeWarpFeeder::Handler
 {
   enum ReplayMode {
     MODE_NULL,
@@ -43,16 +45,57 @@ class Replay
     MODE_DEMO
   };
 
+  /**
+   * The maximum duration of one UpdateTimeWarp() call [ms].  It runs
+   * in the UI thread, which must remain responsive.
+   */
+  static const unsigned TIME_WARP_BUDGET = 250;
+
+  /**
+   * How long to wait for the CalculationThread to process one fix
+   * [ms].  After that, the next fix is fed.
+   */
+  static const unsigned TIME_WARP_TIMEOUT = 1000;
+
   ReplayMode mode;
   IgcReplayGlue igc_replay;
   NmeaReplayGlue nmea_replay;
   DemoReplayGlue demo_replay;
 
+  /**
+   * Feed fixes as fast as the CalculationThread can process them?
+   * See SetTimeWarp().
+   */
+  bool time_warp;
+
+  /**
+   * The minimum interval between two map redraws during a time warp
+   * replay [ms].
+   */
+  unsigned redraw_interval;
+
+  /**
+   * Is a time warp replay running, i.e. has BeginTimeWarp() been
+   * called?
+   */
+  bool warp_active;
+
+  TimeWarpFeeder warp_feeder;
+
+  /**
+   * The time the current time warp replay was started.
+   */
+  PeriodClock warp_clock;
+
 public:
   Replay(Logger *_logger, ProtectedTaskManager& task_manager):
     mode(MODE_NULL),
     igc_replay(_logger),
-    demo_replay(task_manager) {}
+    demo_replay(task_manager),
+    time_warp(false), redraw_interval(5000), warp_active(false),
+    warp_feeder(TIME_WARP_BUDGET, TIME_WARP_TIMEOUT) {}
+
+  virtual ~Replay() {}
 
   bool Update();
   void Stop();
@@ -62,6 +105,39 @@ public:
 
   fixed GetTimeScale();
   void SetTimeScale(const fixed time_scale);
+
+  bool GetTimeWarp() const {
+    return time_warp;
+  }
+
+  unsigned GetRedrawInterval() const {
+    return redraw_interval;
+  }
+
+  /**
+   * Enable or disable the time warp mode for IGC and NMEA files.
+   * Instead of being paced by the clock, fixes are fed as fast as
+   * the CalculationThread consumes them, each one advancing the
+   * replay by the time scale.  The map is redrawn only once per
+   * interval, and the achieved rate is reported when the replay
+   * stops.  Takes effect at the next Start().
+   *
+   * @param _redraw_interval the minimum interval between two map
+   * redraws [ms]
+   */
+  void SetTimeWarp(bool _time_warp, unsigned _redraw_interval) {
+    time_warp = _time_warp;
+    redraw_interval = _redraw_interval;
+  }
+
+private:
+  bool UpdateOnce();
+  bool UpdateTimeWarp();
+  void FinishTimeWarp();
+
+  /* virtual methods from class TimeWarpFeeder::Handler */
+  virtual bool FeedFix(bool &fed);
+  virtual bool WaitFixProcessed(unsigned timeout_ms);
 };
 
 #endif
@@ -0,0 +1,60 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Replay/TimeWarpFeeder.hpp"
+
+bool
+TimeWarpFeeder::Update(Handler &handler)
+{
+  PeriodClock clock;
+  clock.Update();
+
+  while (true) {
+    const int remaining = (int)budget - clock.Elapsed();
+    if (remaining <= 0)
+      return true;
+
+    if (waiting) {
+      /* don't feed the next fix before the previous one has been
+         processed, or the consumer would skip it; wait no longer
+         than the budget allows, and continue waiting in the next
+         call */
+      if (!handler.WaitFixProcessed(remaining) &&
+          !fed_clock.Check(timeout))
+        continue;
+
+      waiting = false;
+    }
+
+    bool fed;
+    if (!handler.FeedFix(fed))
+      /* end of file */
+      return false;
+
+    if (fed) {
+      ++n_fixes;
+      waiting = true;
+      fed_clock.Update();
+    }
+  }
+}
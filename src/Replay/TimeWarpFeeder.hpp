@@ -0,0 +1,106 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_REPLAY_TIME_WARP_FEEDER_HPP
+#define XCSOAR_REPLAY_TIME_WARP_FEEDER_HPP
+
+#include "PeriodClock.hpp"
+
+/**
+ * Feeds replay fixes as fast as they are processed, for a limited
+ * time per Update() call.  The next fix is fed only after the
+ * previous one has been processed, or after a timeout.
+ */
+class TimeWarpFeeder {
+public:
+  class Handler {
+  public:
+    /**
+     * Feed the next fix.
+     *
+     * @param fed set to true if a new fix has been submitted, which
+     * must be processed before the next one is fed
+     * @return false at the end of the file
+     */
+    virtual bool FeedFix(bool &fed) = 0;
+
+    /**
+     * Wait until the fix submitted by the last FeedFix() call has
+     * been processed.
+     *
+     * @return false if the timeout has expired
+     */
+    virtual bool WaitFixProcessed(unsigned timeout_ms) = 0;
+  };
+
+private:
+  /**
+   * The maximum duration of one Update() call [ms].
+   */
+  const unsigned budget;
+
+  /**
+   * Stop waiting for a fix which has not been processed after this
+   * duration [ms].
+   */
+  const unsigned timeout;
+
+  /**
+   * Has the last fix not been processed yet?
+   */
+  bool waiting;
+
+  /**
+   * The time when the last fix was fed.
+   */
+  PeriodClock fed_clock;
+
+  unsigned n_fixes;
+
+public:
+  TimeWarpFeeder(unsigned _budget, unsigned _timeout)
+    :budget(_budget), timeout(_timeout), waiting(false), n_fixes(0) {}
+
+  void Reset() {
+    waiting = false;
+    n_fixes = 0;
+  }
+
+  /**
+   * Returns the number of fixes fed since the last Reset() call.
+   */
+  unsigned GetFixCount() const {
+    return n_fixes;
+  }
+
+  /**
+   * Feed fixes until the budget is used up.  If the last fix has
+   * not been processed when it runs out, the next call continues
+   * waiting for it.
+   *
+   * @return false at the end of the file
+   */
+  bool Update(Handler &handler);
+};
+
+#endif
@@ -171,6 +171,17 @@ public:
 #endif
   }
 
+  /**
+   * Returns a pointer to the specified row (0 is the top-most one).
+   */
+  BGRColor *GetRow(unsigned y) {
+#ifndef USE_GDI
+    return buffer + y * corrected_width;
+#else
+    return buffer + (height - 1 - y) * corrected_width;
+#endif
+  }
+
   void SetDirty() {
 #ifdef ENABLE_OPENGL
     dirty = true;
@@ -24,9 +24,12 @@ Copyright_License {
 #include "HeightMatrix.hpp"
 #include "RasterMap.hpp"
 #include "Projection/WindowProjection.hpp"
+#include "Thread/ThreadPool.hpp"
 
 #include <algorithm>
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 void
 HeightMatrix::SetSize(size_t _size)
@@ -55,7 +58,8 @@ HeightMatrix::SetSize(unsigned width, unsigned height,
 
 void
 HeightMatrix::Fill(const RasterMap &map, const WindowProjection &projection,
-                   unsigned quantisation_pixels, bool interpolate)
+                   unsigned quantisation_pixels, bool interpolate,
+                   ThreadPool *pool)
 {
   const unsigned screen_width = projection.GetScreenWidth();
   const unsigned screen_height = projection.GetScreenHeight();
@@ -63,10 +67,91 @@ HeightMatrix::Fill(const RasterMap &map, const WindowProjection &projection,
   SetSize((screen_width + quantisation_pixels - 1) / quantisation_pixels,
           (screen_height + quantisation_pixels - 1) / quantisation_pixels);
 
-  for (unsigned y = 0; y < screen_height; y += quantisation_pixels) {
-    short *p = data.begin() + y * width / quantisation_pixels;
-    map.ScanLine(projection.ScreenToGeo(0, y),
-                 projection.ScreenToGeo(screen_width, y),
-                 p, width, interpolate);
+  Fill(map, projection, quantisation_pixels, interpolate,
+       0, 0, width, height, pool);
+}
+
+/**
+ * Scans a band of rows for HeightMatrix::Fill().
+ */
+class HeightMatrixFillJob : public ThreadPool::Job {
+  const RasterMap &map;
+  const WindowProjection &projection;
+  const unsigned quantisation_pixels;
+  const bool interpolate;
+  short *const data;
+  const unsigned width, left, right;
+
+public:
+  HeightMatrixFillJob(const RasterMap &_map,
+                      const WindowProjection &_projection,
+                      unsigned _quantisation_pixels, bool _interpolate,
+                      short *_data, unsigned _width,
+                      unsigned _left, unsigned _right)
+    :map(_map), projection(_projection),
+     quantisation_pixels(_quantisation_pixels), interpolate(_interpolate),
+     data(_data), width(_width), left(_left), right(_right) {}
+
+  virtual void Run(unsigned top, unsigned bottom) {
+    for (unsigned y = top; y < bottom; ++y) {
+      const int screen_y = y * quantisation_pixels;
+      map.ScanLine(projection.ScreenToGeo(left * quantisation_pixels,
+                                          screen_y),
+                   projection.ScreenToGeo((right - 1) * quantisation_pixels,
+                                          screen_y),
+                   data + y * width + left, right - left,
+                   interpolate);
+    }
+  }
+};
+
+void
+HeightMatrix::Fill(const RasterMap &map, const WindowProjection &projection,
+                   unsigned quantisation_pixels, bool interpolate,
+                   unsigned left, unsigned top,
+                   unsigned right, unsigned bottom,
+                   ThreadPool *pool)
+{
+  assert(left < right && right <= width);
+  assert(top < bottom && bottom <= height);
+
+  if (right - left < 2) {
+    /* RasterMap::ScanLine() needs at least two samples */
+    if (width < 2)
+      return;
+
+    if (right < width)
+      ++right;
+    else
+      --left;
+  }
+
+  HeightMatrixFillJob job(map, projection, quantisation_pixels, interpolate,
+                          data.begin(), width, left, right);
+  if (pool != NULL)
+    pool->Run(job, top, bottom);
+  else
+    job.Run(top, bottom);
+}
+
+void
+HeightMatrix::Shift(int dx, int dy)
+{
+  assert((unsigned)abs(dx) < width);
+  assert((unsigned)abs(dy) < height);
+
+  const unsigned n = width - abs(dx);
+  const unsigned src_x = dx < 0 ? -dx : 0, dest_x = dx > 0 ? dx : 0;
+  const unsigned rows = height - abs(dy);
+
+  for (unsigned i = 0; i < rows; ++i) {
+    /* when moving down, start at the bottom, to avoid overwriting
+       rows which have not been moved yet */
+    const unsigned dest_y = dy > 0 ? height - 1 - i : i;
+    const unsigned src_y = dest_y - dy;
+
+    memmove(data.begin() + dest_y * width + dest_x,
+            data.begin() + src_y * width + src_x,
+            n * sizeof(data[0]));
   }
 }
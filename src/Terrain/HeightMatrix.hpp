@@ -30,6 +30,7 @@ Copyright_License {
 
 class RasterMap;
 class WindowProjection;
+class ThreadPool;
 
 class HeightMatrix : private NonCopyable {
   AllocatedArray<short> data;
@@ -45,10 +46,34 @@ protected:
 
 public:
   /**
+   * Resize the matrix to the projection's screen size and fill it.
+   * The cell (x,y) contains the height at screen pixel
+   * (x*quantisation_pixels, y*quantisation_pixels).
+   *
    * @param interpolate true enables interpolation of sub-pixel values
+   * @param pool if not NULL, then the rows are scanned in parallel by
+   * the threads of this pool
    */
   void Fill(const RasterMap &map, const WindowProjection &map_projection,
-            unsigned quantisation_pixels, bool interpolate);
+            unsigned quantisation_pixels, bool interpolate,
+            ThreadPool *pool=NULL);
+
+  /**
+   * Fill only the specified range of cells; the matrix must already
+   * have the right size.
+   */
+  void Fill(const RasterMap &map, const WindowProjection &map_projection,
+            unsigned quantisation_pixels, bool interpolate,
+            unsigned left, unsigned top, unsigned right, unsigned bottom,
+            ThreadPool *pool=NULL);
+
+  /**
+   * Move the contents of the matrix by the specified number of cells
+   * (positive values move it to the right/bottom), e.g. after the map
+   * has been panned.  The cells which get exposed by this are
+   * undefined; they must be filled again.
+   */
+  void Shift(int dx, int dy);
 
   unsigned GetWidth() const {
     return width;
@@ -0,0 +1,49 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_JASPER_HANDLER_HPP
+#define XCSOAR_TERRAIN_JASPER_HANDLER_HPP
+
+/**
+ * Receives the results of XCSoar's libjasper extensions (see
+ * jpc_rtc.cpp).  Only one handler may be active at a time.
+ */
+class JasperHandler {
+public:
+  virtual long SkipMarkerSegment(long file_offset) = 0;
+  virtual void MarkerSegment(long file_offset, unsigned id) = 0;
+
+  virtual void SetSize(unsigned width, unsigned height,
+                       unsigned tile_width, unsigned tile_height,
+                       unsigned tile_columns, unsigned tile_rows) = 0;
+  virtual void SetTile(unsigned index,
+                       int xstart, int ystart, int xend, int yend) = 0;
+  virtual void SetLatLonBounds(double lon_min, double lon_max,
+                               double lat_min, double lat_max) = 0;
+  virtual void SetInitialised(bool val) = 0;
+
+  virtual short *GetImageBuffer(unsigned index) = 0;
+  virtual short *GetOverview() = 0;
+};
+
+#endif
@@ -22,17 +22,28 @@ Copyright_License {
 */
 
 #include "Terrain/RasterBuffer.hpp"
+#include "Terrain/RasterLocation.hpp"
 #include "Math/FastMath.h"
+#include "Util/Macros.hpp"
 
 #include <algorithm>
 #include <assert.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 void
 RasterBuffer::Resize(unsigned _width, unsigned _height)
 {
   assert(_width > 0 && _height > 0);
 
   data.GrowDiscard(_width, _height);
+  base = data.begin();
+  width = _width;
+  height = _height;
 }
 
 short
@@ -76,6 +87,179 @@ RasterBuffer::GetInterpolated(unsigned lx, unsigned ly) const
   return GetInterpolated(lx, ly, ix, iy);
 }
 
+/**
+ * Blend 8 samples bilinearly: each sample has the four neighbours a
+ * (top left), b (top right), c (bottom left), d (bottom right) and
+ * the sub-pixel fractions ix, iy (0..255).
+ *
+ * The result is bit-exact with the scalar formula in
+ * GetInterpolated(), which wraps around in 32 bit unsigned
+ * arithmetic.  Samples with a special (water or invalid) neighbour
+ * are not interpolated.
+ */
+static inline void
+BlendBilinear8(const short *gcc_restrict a, const short *gcc_restrict b,
+               const short *gcc_restrict c, const short *gcc_restrict d,
+               const short *gcc_restrict ix, const short *gcc_restrict iy,
+               short *gcc_restrict dest)
+{
+#if defined(__SSE2__)
+  const __m128i one = _mm_set1_epi16(0x100);
+  const __m128i vix = _mm_loadu_si128((const __m128i *)ix);
+  const __m128i viy = _mm_loadu_si128((const __m128i *)iy);
+  const __m128i vkx = _mm_sub_epi16(one, vix);
+  const __m128i vky = _mm_sub_epi16(one, viy);
+
+  const __m128i va = _mm_loadu_si128((const __m128i *)a);
+  const __m128i vb = _mm_loadu_si128((const __m128i *)b);
+  const __m128i vc = _mm_loadu_si128((const __m128i *)c);
+  const __m128i vd = _mm_loadu_si128((const __m128i *)d);
+
+  /* horizontal blend: r = left * kx + right * ix (32 bit) */
+  const __m128i wx_lo = _mm_unpacklo_epi16(vkx, vix);
+  const __m128i wx_hi = _mm_unpackhi_epi16(vkx, vix);
+  const __m128i r0_lo = _mm_madd_epi16(_mm_unpacklo_epi16(va, vb), wx_lo);
+  const __m128i r0_hi = _mm_madd_epi16(_mm_unpackhi_epi16(va, vb), wx_hi);
+  const __m128i r1_lo = _mm_madd_epi16(_mm_unpacklo_epi16(vc, vd), wx_lo);
+  const __m128i r1_hi = _mm_madd_epi16(_mm_unpackhi_epi16(vc, vd), wx_hi);
+
+  /* SSE2 has no 32 bit multiplication; split r = h * 256 + l, where
+     both h and l fit into 16 bit, and blend them separately */
+  const __m128i low_mask = _mm_set1_epi32(0xff);
+  const __m128i h0 = _mm_packs_epi32(_mm_srai_epi32(r0_lo, 8),
+                                     _mm_srai_epi32(r0_hi, 8));
+  const __m128i h1 = _mm_packs_epi32(_mm_srai_epi32(r1_lo, 8),
+                                     _mm_srai_epi32(r1_hi, 8));
+  const __m128i l0 = _mm_packs_epi32(_mm_and_si128(r0_lo, low_mask),
+                                     _mm_and_si128(r0_hi, low_mask));
+  const __m128i l1 = _mm_packs_epi32(_mm_and_si128(r1_lo, low_mask),
+                                     _mm_and_si128(r1_hi, low_mask));
+
+  /* vertical blend: r0 * ky + r1 * iy */
+  const __m128i wy_lo = _mm_unpacklo_epi16(vky, viy);
+  const __m128i wy_hi = _mm_unpackhi_epi16(vky, viy);
+  const __m128i sum_lo =
+    _mm_add_epi32(_mm_slli_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(h0, h1),
+                                                wy_lo), 8),
+                  _mm_madd_epi16(_mm_unpacklo_epi16(l0, l1), wy_lo));
+  const __m128i sum_hi =
+    _mm_add_epi32(_mm_slli_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(h0, h1),
+                                                wy_hi), 8),
+                  _mm_madd_epi16(_mm_unpackhi_epi16(l0, l1), wy_hi));
+
+  const __m128i result = _mm_packs_epi32(_mm_srai_epi32(sum_lo, 16),
+                                         _mm_srai_epi32(sum_hi, 16));
+
+  /* if one of the neighbours is special (water or invalid), use the
+     top left one without interpolation */
+  const __m128i min = _mm_min_epi16(_mm_min_epi16(va, vb),
+                                    _mm_min_epi16(vc, vd));
+  const __m128i special =
+    _mm_cmplt_epi16(min, _mm_set1_epi16(RasterBuffer::TERRAIN_WATER_THRESHOLD + 1));
+
+  _mm_storeu_si128((__m128i *)dest,
+                   _mm_or_si128(_mm_and_si128(special, va),
+                                _mm_andnot_si128(special, result)));
+#elif defined(__ARM_NEON__)
+  const int16x8_t one = vdupq_n_s16(0x100);
+  const int16x8_t vix = vld1q_s16(ix), viy = vld1q_s16(iy);
+  const int16x8_t vkx = vsubq_s16(one, vix), vky = vsubq_s16(one, viy);
+  const int16x8_t va = vld1q_s16(a), vb = vld1q_s16(b);
+  const int16x8_t vc = vld1q_s16(c), vd = vld1q_s16(d);
+
+  int32x4_t r0 = vmull_s16(vget_low_s16(va), vget_low_s16(vkx));
+  r0 = vmlal_s16(r0, vget_low_s16(vb), vget_low_s16(vix));
+  int32x4_t r1 = vmull_s16(vget_low_s16(vc), vget_low_s16(vkx));
+  r1 = vmlal_s16(r1, vget_low_s16(vd), vget_low_s16(vix));
+  int32x4_t sum = vmulq_s32(r0, vmovl_s16(vget_low_s16(vky)));
+  sum = vmlaq_s32(sum, r1, vmovl_s16(vget_low_s16(viy)));
+  const int16x4_t result_lo = vshrn_n_s32(sum, 16);
+
+  r0 = vmull_s16(vget_high_s16(va), vget_high_s16(vkx));
+  r0 = vmlal_s16(r0, vget_high_s16(vb), vget_high_s16(vix));
+  r1 = vmull_s16(vget_high_s16(vc), vget_high_s16(vkx));
+  r1 = vmlal_s16(r1, vget_high_s16(vd), vget_high_s16(vix));
+  sum = vmulq_s32(r0, vmovl_s16(vget_high_s16(vky)));
+  sum = vmlaq_s32(sum, r1, vmovl_s16(vget_high_s16(viy)));
+  const int16x4_t result_hi = vshrn_n_s32(sum, 16);
+
+  /* if one of the neighbours is special (water or invalid), use the
+     top left one without interpolation */
+  const int16x8_t min = vminq_s16(vminq_s16(va, vb), vminq_s16(vc, vd));
+  const uint16x8_t special =
+    vcleq_s16(min, vdupq_n_s16(RasterBuffer::TERRAIN_WATER_THRESHOLD));
+
+  vst1q_s16(dest, vbslq_s16(special, va,
+                            vcombine_s16(result_lo, result_hi)));
+#else
+  for (unsigned i = 0; i < 8; ++i) {
+    if (RasterBuffer::IsSpecial(a[i]) || RasterBuffer::IsSpecial(b[i]) ||
+        RasterBuffer::IsSpecial(c[i]) || RasterBuffer::IsSpecial(d[i])) {
+      dest[i] = a[i];
+      continue;
+    }
+
+    const unsigned kx = 0x100 - ix[i], ky = 0x100 - iy[i];
+    dest[i] = (a[i] * kx * ky + b[i] * ix[i] * ky +
+               c[i] * kx * iy[i] + d[i] * ix[i] * iy[i]) >> 16;
+  }
+#endif
+}
+
+void
+RasterBuffer::GetInterpolated(const RasterLocation *gcc_restrict locations,
+                              short *gcc_restrict dest, unsigned n) const
+{
+  assert(IsDefined());
+
+  /* gather the four neighbours of many samples into separate arrays
+     first, and then blend them 8 at a time; gathering a large block
+     before reading it back with vector loads avoids store forwarding
+     stalls */
+
+  enum { BLOCK = 64 };
+  short a[BLOCK], b[BLOCK], c[BLOCK], d[BLOCK], ix[BLOCK], iy[BLOCK];
+
+  const unsigned width = GetWidth(), height = GetHeight();
+
+  while (n >= 8) {
+    const unsigned block = std::min(n, (unsigned)BLOCK) & ~7u;
+
+    for (unsigned i = 0; i < block; ++i) {
+      unsigned lx = locations[i].x, ly = locations[i].y;
+      ix[i] = CombinedDivAndMod(lx);
+      iy[i] = CombinedDivAndMod(ly);
+
+      assert(lx < width);
+      assert(ly < height);
+
+      const unsigned int dx = (lx == width - 1) ? 0 : 1;
+      const unsigned int dy = (ly == height - 1) ? 0 : width;
+      const short *tm = GetDataAt(lx, ly);
+
+      a[i] = tm[0];
+      b[i] = tm[dx];
+      c[i] = tm[dy];
+      d[i] = tm[dx + dy];
+    }
+
+    for (unsigned i = 0; i < block; i += 8)
+      BlendBilinear8(a + i, b + i, c + i, d + i, ix + i, iy + i, dest + i);
+
+    locations += block;
+    dest += block;
+    n -= block;
+  }
+
+  for (; n > 0; --n, ++locations) {
+    unsigned lx = locations->x, ly = locations->y;
+    const unsigned int ix = CombinedDivAndMod(lx);
+    const unsigned int iy = CombinedDivAndMod(ly);
+
+    *dest++ = GetInterpolated(lx, ly, ix, iy);
+  }
+}
+
 /**
  * This class implements an algorithm to traverse pixels quickly with
  * only integer addition, no multiplication and division.
@@ -133,15 +317,16 @@ RasterBuffer::ScanHorizontalLine(unsigned ax, unsigned bx, unsigned y,
   if (interpolate && (unsigned)abs(dx) < (size << 8u)) {
     /* interpolate */
 
-    unsigned cy = y;
-    const unsigned int iy = CombinedDivAndMod(cy);
+    RasterLocation locations[64];
 
     --size;
-    for (int i = 0; (unsigned)i <= size; ++i) {
-      unsigned cx = ax + (i * dx) / (int)size;
-      const unsigned int ix = CombinedDivAndMod(cx);
+    for (int i = 0; (unsigned)i <= size;) {
+      unsigned n = 0;
+      for (; n < ARRAY_SIZE(locations) && (unsigned)i <= size; ++n, ++i)
+        locations[n] = RasterLocation(ax + (i * dx) / (int)size, y);
 
-      *buffer++ = GetInterpolated(cx, cy, ix, iy);
+      GetInterpolated(locations, buffer, n);
+      buffer += n;
     }
   } else if (gcc_likely(dx > 0)) {
     /* no interpolation needed, forward scan */
@@ -197,14 +382,16 @@ RasterBuffer::ScanLine(unsigned ax, unsigned ay, unsigned bx, unsigned by,
   if (interpolate && (unsigned)(abs(dx) + abs(dy)) < (size << 8u)) {
     /* interpolate */
 
-    for (int i = 0; (unsigned)i <= size; ++i) {
-      unsigned cx = ax + (i * dx) / (int)size;
-      unsigned cy = ay + (i * dy) / (int)size;
+    RasterLocation locations[64];
 
-      const unsigned int ix = CombinedDivAndMod(cx);
-      const unsigned int iy = CombinedDivAndMod(cy);
+    for (int i = 0; (unsigned)i <= size;) {
+      unsigned n = 0;
+      for (; n < ARRAY_SIZE(locations) && (unsigned)i <= size; ++n, ++i)
+        locations[n] = RasterLocation(ax + (i * dx) / (int)size,
+                                      ay + (i * dy) / (int)size);
 
-      *buffer++ = GetInterpolated(cx, cy, ix, iy);
+      GetInterpolated(locations, buffer, n);
+      buffer += n;
     }
   } else {
     /* no interpolation needed */
@@ -242,5 +429,5 @@ RasterBuffer::ScanLineChecked(unsigned ax, unsigned ay,
 short
 RasterBuffer::GetMaximum() const
 {
-  return IsDefined() ? *std::max_element(data.begin(), data.end()) : 0;
+  return IsDefined() ? *std::max_element(base, base + width * height) : 0;
 }
@@ -28,8 +28,13 @@ Copyright_License {
 #include "Util/AllocatedGrid.hpp"
 #include "Compiler.h"
 
+#include <algorithm>
 #include <cstddef>
 
+#include <assert.h>
+
+struct RasterLocation;
+
 class RasterBuffer : private NonCopyable {
 public:
   /** invalid value for terrain */
@@ -52,43 +57,93 @@ public:
   }
 
 private:
+  /**
+   * The allocated height data.  This is empty if the buffer refers to
+   * external memory, see SetExternal().
+   */
   AllocatedGrid<short> data;
 
+  /**
+   * The first height value; points either into #data or to external
+   * memory.  NULL if the buffer is undefined.
+   */
+  const short *base;
+
+  unsigned width, height;
+
 public:
-  RasterBuffer() = default;
+  RasterBuffer():base(NULL), width(0), height(0) {}
   RasterBuffer(unsigned _width, unsigned _height)
-    :data(_width, _height) {}
+    :data(_width, _height), base(data.begin()),
+     width(_width), height(_height) {}
 
   bool IsDefined() const {
-    return data.Defined();
+    return base != NULL;
   }
 
   unsigned GetWidth() const {
-    return data.GetWidth();
+    return width;
   }
 
   unsigned GetHeight() const {
-    return data.GetHeight();
+    return height;
   }
 
+  /**
+   * Returns a writable pointer to the allocated data.  Must not be
+   * used on a buffer which refers to external memory.
+   */
   short *GetData() {
+    assert(base == data.begin());
+
     return data.begin();
   }
 
   const short *GetData() const {
-    return data.begin();
+    return base;
   }
 
   const short *GetDataAt(unsigned x, unsigned y) const {
-    return data.GetPointerAt(x, y);
+    assert(x < width);
+    assert(y < height);
+
+    return base + y * width + x;
   }
 
   void Reset() {
     data.Reset();
+    base = NULL;
+    width = height = 0;
   }
 
   void Resize(unsigned _width, unsigned _height);
 
+  /**
+   * Refer to height data in external memory (e.g. a memory mapped
+   * file) instead of allocating a buffer.  The data must be laid out
+   * row by row, and must remain valid until Reset() is called.
+   */
+  void SetExternal(const short *_base, unsigned _width, unsigned _height) {
+    assert(_base != NULL);
+    assert(_width > 0 && _height > 0);
+
+    data.Reset();
+    base = _base;
+    width = _width;
+    height = _height;
+  }
+
+  /**
+   * Exchange the contents of this buffer with another one, without
+   * copying the data.
+   */
+  void Swap(RasterBuffer &other) {
+    data.Swap(other.data);
+    std::swap(base, other.base);
+    std::swap(width, other.width);
+    std::swap(height, other.height);
+  }
+
   gcc_pure
   short GetInterpolated(unsigned lx, unsigned ly,
                         unsigned ix, unsigned iy) const;
@@ -96,6 +151,16 @@ public:
   gcc_pure
   short GetInterpolated(unsigned lx, unsigned ly) const;
 
+  /**
+   * Batch version of GetInterpolated(): determine the interpolated
+   * heights at many sub-pixel locations, which must all be inside
+   * this buffer.  The bilinear blend is done with SIMD instructions
+   * where available, and gives exactly the same results as the
+   * scalar version.
+   */
+  void GetInterpolated(const RasterLocation *gcc_restrict locations,
+                       short *gcc_restrict dest, unsigned n) const;
+
   gcc_pure
   short Get(unsigned x, unsigned y) const {
     return *GetDataAt(x, y);
@@ -26,6 +26,7 @@ Copyright_License {
 #include "Geo/GeoClip.hpp"
 #include "OS/PathName.hpp"
 #include "IO/FileCache.hpp"
+#include "Util/Macros.hpp"
 
 #include <algorithm>
 #include <assert.h>
@@ -94,6 +95,35 @@ RasterMap::SetViewCenter(const GeoPoint &location, fixed radius)
                                 projection.distance_pixels(radius) / 256);
 }
 
+bool
+RasterMap::PollTiles(const GeoPoint &location, fixed radius,
+                     const GeoPoint &prefetch_location, fixed prefetch_radius)
+{
+  if (!raster_tile_cache.GetInitialised())
+    return false;
+
+  const GeoBounds &bounds = raster_tile_cache.GetBounds();
+
+  int x = angle_to_pixel(location.longitude, bounds.west, bounds.east,
+                         raster_tile_cache.GetWidth());
+
+  int y = angle_to_pixel(location.latitude, bounds.north, bounds.south,
+                         raster_tile_cache.GetHeight());
+
+  int prefetch_x = angle_to_pixel(prefetch_location.longitude,
+                                  bounds.west, bounds.east,
+                                  raster_tile_cache.GetWidth());
+
+  int prefetch_y = angle_to_pixel(prefetch_location.latitude,
+                                  bounds.north, bounds.south,
+                                  raster_tile_cache.GetHeight());
+
+  return raster_tile_cache.PollTiles(x, y,
+                                     projection.distance_pixels(radius) / 256,
+                                     prefetch_x, prefetch_y,
+                                     projection.distance_pixels(prefetch_radius) / 256);
+}
+
 short
 RasterMap::GetHeight(const GeoPoint &location) const
 {
@@ -108,6 +138,25 @@ RasterMap::GetInterpolatedHeight(const GeoPoint &location) const
   return raster_tile_cache.GetInterpolatedHeight(pt.x, pt.y);
 }
 
+void
+RasterMap::GetInterpolatedHeights(const GeoPoint *locations,
+                                  short *heights, unsigned n) const
+{
+  RasterLocation buffer[64];
+
+  while (n > 0) {
+    const unsigned chunk = std::min(n, (unsigned)ARRAY_SIZE(buffer));
+    for (unsigned i = 0; i < chunk; ++i)
+      buffer[i] = projection.project(locations[i]);
+
+    raster_tile_cache.GetInterpolatedHeights(buffer, heights, chunk);
+
+    locations += chunk;
+    heights += chunk;
+    n -= chunk;
+  }
+}
+
 void
 RasterMap::ScanLine(const GeoPoint &start, const GeoPoint &end,
                     short *buffer, unsigned size, bool interpolate) const
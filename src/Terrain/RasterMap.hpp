@@ -59,8 +59,54 @@ public:
     return raster_tile_cache.GetBounds().GetCenter();
   }
 
+  /**
+   * Use the uncompressed terrain file generated by
+   * GenerateRawTerrain instead of decoding tiles from the JPEG2000
+   * file.
+   *
+   * @return true on success, false if the file is missing or does not
+   * match this map
+   */
+  bool LoadRaw(const TCHAR *raw_path) {
+    return raster_tile_cache.LoadRaw(raw_path);
+  }
+
   void SetViewCenter(const GeoPoint &location, fixed radius);
 
+  /**
+   * The first step of an asynchronous SetViewCenter(): dispose tiles
+   * which are out of range and schedule the missing ones.  Tiles
+   * around the prefetch location are scheduled as well.  If this
+   * returns true, call LoadTiles() and then CommitTiles().
+   *
+   * Caller must hold an exclusive lock.
+   *
+   * @param prefetch_radius the radius around #prefetch_location; zero
+   * disables prefetching
+   */
+  bool PollTiles(const GeoPoint &location, fixed radius,
+                 const GeoPoint &prefetch_location, fixed prefetch_radius);
+
+  /**
+   * Decode the tiles scheduled by PollTiles().  Caller must hold a
+   * shared lock only.
+   *
+   * @return false if the file could not be opened
+   */
+  bool LoadTiles() const {
+    return raster_tile_cache.LoadTiles(path);
+  }
+
+  /**
+   * Activate the tiles decoded by LoadTiles().  Caller must hold an
+   * exclusive lock.
+   *
+   * @param loaded the return value of LoadTiles()
+   */
+  void CommitTiles(bool loaded=true) {
+    raster_tile_cache.CommitTiles(loaded);
+  }
+
   /**
    * Determines if SetViewCenter() should be called again to continue
    * loading.
@@ -96,6 +142,14 @@ public:
   gcc_pure
   short GetInterpolatedHeight(const GeoPoint &location) const;
 
+  /**
+   * Batch version of GetInterpolatedHeight(), which is much faster
+   * for many locations, especially if neighbouring locations are
+   * close to each other.
+   */
+  void GetInterpolatedHeights(const GeoPoint *locations,
+                              short *heights, unsigned n) const;
+
   /**
    * Scan a straight line and fill the buffer with the specified
    * number of samples along the line.
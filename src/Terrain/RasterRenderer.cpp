@@ -32,6 +32,8 @@ Copyright_License {
 
 #include <assert.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 //#define FAST_RSQRT
 
@@ -62,7 +64,10 @@ TerrainShading(const short illum, uint8_t &r, uint8_t &g, uint8_t &b)
 
 RasterRenderer::RasterRenderer()
   :quantisation_pixels(2),
-   image(NULL)
+   image(NULL),
+   matrix_valid(false), image_dirty(true),
+   shift_x(0), shift_y(0),
+   thread_pool(ThreadPool::GetDefaultWorkerCount())
 {
   // scale quantisation_pixels so resolution is not too high on old hardware
   // with large displays
@@ -108,7 +113,120 @@ RasterRenderer::ScanMap(const RasterMap &map, const WindowProjection &projection
     /* disable slope shading when zoomed out very far (too tiny) */
     quantisation_effective = 0;
 
-  height_matrix.Fill(map, projection, quantisation_pixels, true);
+  if (!ScanMapIncremental(map, projection)) {
+    height_matrix.Fill(map, projection, quantisation_pixels, true,
+                       &thread_pool);
+    matrix_projection = projection;
+    matrix_valid = true;
+    image_dirty = true;
+  }
+}
+
+/**
+ * Divide and round to the nearest integer.
+ */
+gcc_const
+static int
+RoundingDivide(int value, int divisor)
+{
+  return value >= 0
+    ? (value + divisor / 2) / divisor
+    : -((divisor / 2 - value) / divisor);
+}
+
+bool
+RasterRenderer::ScanMapIncremental(const RasterMap &map,
+                                   const WindowProjection &projection)
+{
+  if (!matrix_valid ||
+      projection.GetScreenWidth() != matrix_projection.GetScreenWidth() ||
+      projection.GetScreenHeight() != matrix_projection.GetScreenHeight() ||
+      projection.GetScale() != matrix_projection.GetScale() ||
+      projection.GetScreenAngle() != matrix_projection.GetScreenAngle())
+    /* zoomed, rotated or resized: everything has changed */
+    return false;
+
+  /* where is the top left cell of the matrix on the new screen? */
+  const RasterPoint origin =
+    projection.GeoToScreen(matrix_projection.ScreenToGeo(0, 0));
+
+  const int q = quantisation_pixels;
+  const int dx = RoundingDivide(origin.x, q);
+  const int dy = RoundingDivide(origin.y, q);
+
+  const unsigned width = height_matrix.GetWidth();
+  const unsigned height = height_matrix.GetHeight();
+  if ((unsigned)abs(dx) >= width || (unsigned)abs(dy) >= height)
+    /* panned too far, nothing can be reused */
+    return false;
+
+  if (dx == 0 && dy == 0)
+    /* less than one cell, keep the old matrix */
+    return true;
+
+  if (shift_x != 0 || shift_y != 0)
+    /* the previous shift has not been applied to the image yet */
+    image_dirty = true;
+
+  height_matrix.Shift(dx, dy);
+  shift_x = dx;
+  shift_y = dy;
+
+  /* move the projection along with the matrix contents; this way,
+     rounding errors do not accumulate */
+  const RasterPoint &screen_origin = matrix_projection.GetScreenOrigin();
+  matrix_projection.SetScreenOrigin(screen_origin.x + dx * q,
+                                    screen_origin.y + dy * q);
+
+  /* scan the cells which have become visible */
+
+  if (dx > 0)
+    height_matrix.Fill(map, matrix_projection, q, true,
+                       0, 0, dx, height, &thread_pool);
+  else if (dx < 0)
+    height_matrix.Fill(map, matrix_projection, q, true,
+                       width + dx, 0, width, height, &thread_pool);
+
+  if (dy > 0)
+    height_matrix.Fill(map, matrix_projection, q, true,
+                       0, 0, width, dy, &thread_pool);
+  else if (dy < 0)
+    height_matrix.Fill(map, matrix_projection, q, true,
+                       0, height + dy, width, height, &thread_pool);
+
+  return true;
+}
+
+gcc_const
+static PixelRect
+MakePixelRect(int left, int top, int right, int bottom)
+{
+  PixelRect rc;
+  rc.left = left;
+  rc.top = top;
+  rc.right = right;
+  rc.bottom = bottom;
+  return rc;
+}
+
+/**
+ * Move the contents of the image, like HeightMatrix::Shift().
+ */
+static void
+ShiftImage(RawBitmap &image, unsigned width, unsigned height,
+           int dx, int dy)
+{
+  const unsigned n = width - abs(dx);
+  const unsigned src_x = dx < 0 ? -dx : 0, dest_x = dx > 0 ? dx : 0;
+  const unsigned rows = height - abs(dy);
+
+  for (unsigned i = 0; i < rows; ++i) {
+    const unsigned dest_y = dy > 0 ? height - 1 - i : i;
+    const unsigned src_y = dest_y - dy;
+
+    memmove(image.GetRow(dest_y) + dest_x, image.GetRow(src_y) + src_x,
+            n * sizeof(BGRColor));
+  }
 }
 
 void
@@ -123,30 +241,152 @@ RasterRenderer::GenerateImage(bool do_shading,
     delete image;
     image = new RawBitmap(height_matrix.GetWidth(),
                           height_matrix.GetHeight());
+    image_dirty = true;
   }
 
   if (quantisation_effective == 0)
     do_shading = false;
 
-  if (do_shading)
-    GenerateSlopeImage(height_scale, contrast, brightness,
-                       sunazimuth);
-  else
-    GenerateUnshadedImage(height_scale);
+  ImageParameters parameters;
+  parameters.do_shading = do_shading;
+  parameters.height_scale = height_scale;
+  parameters.contrast = contrast;
+  parameters.brightness = brightness;
+  parameters.sunazimuth = sunazimuth;
+  parameters.quantisation_effective = quantisation_effective;
+  parameters.height_slope_factor = max(1, (int)pixel_size);
+  if (image_dirty || parameters != image_parameters) {
+    image_parameters = parameters;
+    image_dirty = true;
+  }
+
+  const int width = height_matrix.GetWidth();
+  const int height = height_matrix.GetHeight();
+
+  if (image_dirty) {
+    GenerateImage(MakePixelRect(0, 0, width, height), do_shading,
+                  height_scale, contrast, brightness, sunazimuth);
+  } else if (shift_x != 0 || shift_y != 0) {
+    ShiftImage(*image, width, height, shift_x, shift_y);
+
+    /* the slope of a cell depends on its neighbours: redraw the
+       cells next to the new ones, and those which are now at the
+       edge */
+    const int margin = do_shading ? quantisation_effective : 0;
+
+    if (shift_x > 0)
+      GenerateImage(MakePixelRect(0, 0, min(width, shift_x + margin), height),
+                    do_shading, height_scale, contrast, brightness,
+                    sunazimuth);
+    else if (shift_x < 0)
+      GenerateImage(MakePixelRect(max(0, width + shift_x - margin), 0,
+                                  width, height),
+                    do_shading, height_scale, contrast, brightness,
+                    sunazimuth);
+
+    if (shift_x != 0 && margin > 0) {
+      if (shift_x > 0)
+        GenerateImage(MakePixelRect(max(0, width - margin), 0, width, height),
+                      do_shading, height_scale, contrast, brightness,
+                      sunazimuth);
+      else
+        GenerateImage(MakePixelRect(0, 0, min(width, margin), height),
+                      do_shading, height_scale, contrast, brightness,
+                      sunazimuth);
+    }
+
+    if (shift_y > 0)
+      GenerateImage(MakePixelRect(0, 0, width, min(height, shift_y + margin)),
+                    do_shading, height_scale, contrast, brightness,
+                    sunazimuth);
+    else if (shift_y < 0)
+      GenerateImage(MakePixelRect(0, max(0, height + shift_y - margin),
+                                  width, height),
+                    do_shading, height_scale, contrast, brightness,
+                    sunazimuth);
+
+    if (shift_y != 0 && margin > 0) {
+      if (shift_y > 0)
+        GenerateImage(MakePixelRect(0, max(0, height - margin), width, height),
+                      do_shading, height_scale, contrast, brightness,
+                      sunazimuth);
+      else
+        GenerateImage(MakePixelRect(0, 0, width, min(height, margin)),
+                      do_shading, height_scale, contrast, brightness,
+                      sunazimuth);
+    }
+  }
+
+  image_dirty = false;
+  shift_x = shift_y = 0;
+}
+
+/**
+ * Converts a band of rows of the height matrix into the image.
+ */
+class RasterRenderer::ImageJob : public ThreadPool::Job {
+  RasterRenderer &renderer;
+  const PixelRect rc;
+  const bool do_shading;
+  const unsigned height_scale;
+  const int contrast;
+  int sx, sy, sz;
+
+public:
+  ImageJob(RasterRenderer &_renderer, const PixelRect &_rc, bool _do_shading,
+           unsigned _height_scale, int _contrast, int brightness,
+           const Angle sunazimuth)
+    :renderer(_renderer), rc(_rc), do_shading(_do_shading),
+     height_scale(_height_scale), contrast(_contrast) {
+    if (do_shading) {
+      const Angle fudgeelevation =
+        Angle::Degrees(fixed(10.0 + 80.0 * brightness / 255.0));
+
+      sx = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastsine());
+      sy = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastcosine());
+      sz = (int)(255 * fudgeelevation.fastsine());
+    }
+  }
+
+  virtual void Run(unsigned top, unsigned bottom) {
+    PixelRect band = rc;
+    band.top = top;
+    band.bottom = bottom;
+
+    if (do_shading)
+      renderer.GenerateSlopeImage(band, height_scale, contrast, sx, sy, sz);
+    else
+      renderer.GenerateUnshadedImage(band, height_scale);
+  }
+};
+
+void
+RasterRenderer::GenerateImage(const PixelRect &rc, bool do_shading,
+                              unsigned height_scale,
+                              int contrast, int brightness,
+                              const Angle sunazimuth)
+{
+  if (rc.top >= rc.bottom || rc.left >= rc.right)
+    return;
+
+  ImageJob job(*this, rc, do_shading, height_scale, contrast, brightness,
+               sunazimuth);
+  thread_pool.Run(job, rc.top, rc.bottom);
+
+  image->SetDirty();
 }
 
 void
-RasterRenderer::GenerateUnshadedImage(unsigned height_scale)
+RasterRenderer::GenerateUnshadedImage(const PixelRect &rc,
+                                      unsigned height_scale)
 {
-  const short *src = height_matrix.GetData();
   const BGRColor *oColorBuf = color_table + 64 * 256;
-  BGRColor *dest = image->GetTopRow();
 
-  for (unsigned y = height_matrix.GetHeight(); y > 0; --y) {
-    BGRColor *p = dest;
-    dest = image->GetNextRow(dest);
+  for (int y = rc.top; y < rc.bottom; ++y) {
+    const short *src = height_matrix.GetRow(y) + rc.left;
+    BGRColor *p = image->GetRow(y) + rc.left;
 
-    for (unsigned x = height_matrix.GetWidth(); x > 0; --x) {
+    for (int x = rc.left; x < rc.right; ++x) {
       short h = *src++;
       if (gcc_likely(!RasterBuffer::IsSpecial(h))) {
         if (h < 0)
@@ -163,8 +403,6 @@ RasterRenderer::GenerateUnshadedImage(unsigned height_scale)
       }
     }
   }
-
-  image->SetDirty();
 }
 
 // JMW: if zoomed right in (e.g. one unit is larger than terrain
@@ -173,7 +411,8 @@ RasterRenderer::GenerateUnshadedImage(unsigned height_scale)
 // (gridding of display) This is why quantisation_effective is used instead of 1
 // previously.  for large zoom levels, quantisation_effective=1
 void
-RasterRenderer::GenerateSlopeImage(unsigned height_scale,
+RasterRenderer::GenerateSlopeImage(const PixelRect &rc,
+                                   unsigned height_scale,
                                    int contrast,
                                    const int sx, const int sy, const int sz)
 {
@@ -187,7 +426,6 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
 
   const unsigned height_slope_factor = max(1, (int)pixel_size);
 
-  const short *src = height_matrix.GetData();
   const BGRColor *oColorBuf = color_table + 64 * 256;
 #ifdef FAST_RSQRT
   const short szindex = sz*contrast/128;
@@ -199,9 +437,7 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
   const int sz_c = sz*contrast>>7;
 #endif
 
-  BGRColor *dest = image->GetTopRow();
-
-  for (unsigned y = 0; y < height_matrix.GetHeight(); ++y) {
+  for (unsigned y = rc.top; y < (unsigned)rc.bottom; ++y) {
     const unsigned row_plus_index = y < (unsigned)border.bottom
       ? quantisation_effective
       : height_matrix.GetHeight() - 1 - y;
@@ -213,10 +449,10 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
 
     const unsigned p31 = row_plus_index + row_minus_index;
 
-    BGRColor *p = dest;
-    dest = image->GetNextRow(dest);
+    const short *src = height_matrix.GetRow(y) + rc.left;
+    BGRColor *p = image->GetRow(y) + rc.left;
 
-    for (unsigned x = 0; x < height_matrix.GetWidth(); ++x, ++src) {
+    for (unsigned x = rc.left; x < (unsigned)rc.right; ++x, ++src) {
       short h = *src;
       if (gcc_likely(!RasterBuffer::IsSpecial(h))) {
         if (h < 0)
@@ -302,24 +538,6 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
       }
     }
   }
-
-  image->SetDirty();
-}
-
-void
-RasterRenderer::GenerateSlopeImage(unsigned height_scale,
-                                   int contrast, int brightness,
-                                   const Angle sunazimuth)
-{
-  const Angle fudgeelevation =
-    Angle::Degrees(fixed(10.0 + 80.0 * brightness / 255.0));
-
-  const int sx = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastsine());
-  const int sy = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastcosine());
-  const int sz = (int)(255 * fudgeelevation.fastsine());
-
-  GenerateSlopeImage(height_scale, contrast,
-                     sx, sy, sz);
 }
 
 void
@@ -356,4 +574,6 @@ RasterRenderer::ColorTable(const ColorRamp *color_ramp, bool do_water,
       color_table[i + (mag + 64) * 256] = BGRColor(r, g, b);
     }
   }
+
+  image_dirty = true;
 }
@@ -26,6 +26,8 @@ Copyright_License {
 
 #include "Terrain/HeightMatrix.hpp"
 #include "Screen/RawBitmap.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "Thread/ThreadPool.hpp"
 #include "Util/NonCopyable.hpp"
 
 #define NUM_COLOR_RAMP_LEVELS 13
@@ -50,8 +52,68 @@ class RasterRenderer : private NonCopyable {
 
   fixed pixel_size;
 
+  /**
+   * The projection which #height_matrix was filled with: the cell
+   * (x,y) contains the height at the screen pixel
+   * (x*quantisation_pixels, y*quantisation_pixels).  When the map is
+   * only panned, the matrix is moved and only the exposed cells are
+   * scanned again.
+   */
+  WindowProjection matrix_projection;
+
+  /**
+   * Is #matrix_projection valid, i.e. may #height_matrix be reused
+   * by the next ScanMap() call?
+   */
+  bool matrix_valid;
+
+  /**
+   * Must GenerateImage() redraw the whole image?  If not, it only
+   * needs to move the image by #shift_x, #shift_y cells and redraw
+   * the exposed parts.
+   */
+  bool image_dirty;
+
+  int shift_x, shift_y;
+
+  /**
+   * The parameters of the last GenerateImage() call.  If one of
+   * them changes, the whole image is redrawn.
+   */
+  struct ImageParameters {
+    bool do_shading;
+    unsigned height_scale;
+    int contrast, brightness;
+    Angle sunazimuth;
+    unsigned quantisation_effective;
+    unsigned height_slope_factor;
+
+    bool operator==(const ImageParameters &other) const {
+      return do_shading == other.do_shading &&
+        height_scale == other.height_scale &&
+        contrast == other.contrast && brightness == other.brightness &&
+        sunazimuth == other.sunazimuth &&
+        quantisation_effective == other.quantisation_effective &&
+        height_slope_factor == other.height_slope_factor;
+    }
+
+    bool operator!=(const ImageParameters &other) const {
+      return !(*this == other);
+    }
+  };
+
+  ImageParameters image_parameters;
+
   BGRColor color_table[256 * 128];
 
+  /**
+   * Splits ScanMap() and GenerateImage() into bands of rows which
+   * are processed in parallel.
+   */
+  ThreadPool thread_pool;
+
+  class ImageJob;
+
 public:
   RasterRenderer();
   ~RasterRenderer();
@@ -72,6 +134,18 @@ public:
     return height_matrix.GetHeight();
   }
 
+  /**
+   * Set the number of threads which render the terrain, including
+   * the calling thread.
+   *
+   * @param n the number of threads; 0 means one for each CPU core
+   */
+  void SetThreads(unsigned n) {
+    thread_pool.SetWorkerCount(n > 0
+                               ? n - 1
+                               : ThreadPool::GetDefaultWorkerCount());
+  }
+
   /**
    * Generate the color table.
    */
@@ -79,7 +153,17 @@ public:
                   unsigned height_scale, int interp_levels);
 
   /**
-   * Scan the map and fill the height matrix.
+   * Discard the height matrix, because the map contents have
+   * changed.  The next ScanMap() call will scan the whole screen.
+   */
+  void Invalidate() {
+    matrix_valid = false;
+  }
+
+  /**
+   * Scan the map and fill the height matrix.  If the map has only
+   * been panned since the previous call, only the parts which have
+   * become visible are scanned.
    */
   void ScanMap(const RasterMap &map, const WindowProjection &projection);
 
@@ -96,22 +180,34 @@ public:
 
 protected:
   /**
-   * Convert the height matrix into the image, without shading.
+   * Try to reuse the height matrix after the map has been panned.
+   *
+   * @return false if the whole matrix needs to be scanned
    */
-  void GenerateUnshadedImage(unsigned height_scale);
+  bool ScanMapIncremental(const RasterMap &map,
+                          const WindowProjection &projection);
 
   /**
-   * Convert the height matrix into the image, with slope shading.
+   * Convert the specified part of the height matrix into the image,
+   * with or without shading.
    */
-  void GenerateSlopeImage(unsigned height_scale, int contrast,
-                          const int sx, const int sy, const int sz);
+  void GenerateImage(const PixelRect &rc, bool do_shading,
+                     unsigned height_scale, int contrast, int brightness,
+                     const Angle sunazimuth);
+
+  /**
+   * Convert the height matrix into the image, without shading.  This
+   * does not call RawBitmap::SetDirty().
+   */
+  void GenerateUnshadedImage(const PixelRect &rc, unsigned height_scale);
 
   /**
    * Convert the height matrix into the image, with slope shading.
+   * This does not call RawBitmap::SetDirty().
    */
-  void GenerateSlopeImage(unsigned height_scale,
-                          int contrast, int brightness,
-                          const Angle sunazimuth);
+  void GenerateSlopeImage(const PixelRect &rc,
+                          unsigned height_scale, int contrast,
+                          const int sx, const int sy, const int sz);
 };
 
 #endif
@@ -24,6 +24,7 @@ Copyright_License {
 #include "Terrain/RasterTerrain.hpp"
 #include "Profile/Profile.hpp"
 #include "OS/PathName.hpp"
+#include "OS/FileUtil.hpp"
 #include "Compatibility/path.h"
 
 #include <windef.h> /* for MAX_PATH */
@@ -34,11 +35,15 @@ RasterTerrain *
 RasterTerrain::OpenTerrain(FileCache *cache, OperationEnvironment &operation)
 {
   TCHAR szFile[MAX_PATH], world_file_buffer[MAX_PATH];
+  TCHAR source_file[MAX_PATH], raw_file[MAX_PATH];
   const TCHAR *world_file;
 
   if (Profile::GetPath(szProfileTerrainFile, szFile)) {
     world_file = NULL;
+    _tcscpy(source_file, szFile);
   } else if (Profile::GetPath(szProfileMapFile, szFile)) {
+    _tcscpy(source_file, szFile);
+
     _tcscpy(world_file_buffer, szFile);
     _tcscat(world_file_buffer, _T(DIR_SEPARATOR_S "terrain.j2w"));
     world_file = world_file_buffer;
@@ -53,5 +58,14 @@ RasterTerrain::OpenTerrain(FileCache *cache, OperationEnvironment &operation)
     return NULL;
   }
 
+  /* use the uncompressed tiles generated by GenerateRawTerrain,
+     unless the map file has been modified since */
+  _tcscpy(raw_file, source_file);
+  _tcscat(raw_file, _T(".raw"));
+  if (File::Exists(raw_file) &&
+      File::GetLastModification(raw_file) >=
+      File::GetLastModification(source_file))
+    rt->map.LoadRaw(raw_file);
+
   return rt;
 }
@@ -28,6 +28,7 @@ Copyright_License {
 #include "IO/ZipLineReader.hpp"
 #include "Operation/Operation.hpp"
 #include "Math/FastMath.h"
+#include "Util/Macros.hpp"
 
 #include <stdlib.h>
 #include <algorithm>
@@ -60,16 +61,6 @@ RasterTile::LoadCache(FILE *file)
   return true;
 }
 
-void
-RasterTile::Enable()
-{
-  if (!width || !height) {
-    Disable();
-  } else {
-    buffer.Resize(width, height);
-  }
-}
-
 short
 RasterTile::GetHeight(unsigned x, unsigned y) const
 {
@@ -105,23 +96,81 @@ RasterTile::GetInterpolatedHeight(unsigned lx, unsigned ly,
   return buffer.GetInterpolated(lx, ly, ix, iy);
 }
 
-bool
-RasterTile::CheckTileVisibility(int view_x, int view_y, unsigned view_radius)
+unsigned
+RasterTile::GetInterpolatedHeights(const RasterLocation *locations,
+                                   short *dest, unsigned n) const
 {
-  if (!width || !height) {
-    Disable();
-    return false;
+  assert(IsEnabled());
+
+  const unsigned x_offset = xstart << 8, y_offset = ystart << 8;
+  const unsigned fine_width = width << 8, fine_height = height << 8;
+
+  RasterLocation local[64];
+
+  unsigned done = 0;
+  while (done < n) {
+    /* translate to tile coordinates, until a location is outside */
+    unsigned chunk = 0;
+    for (; chunk < ARRAY_SIZE(local) && done + chunk < n; ++chunk) {
+      const unsigned x = locations[done + chunk].x - x_offset;
+      const unsigned y = locations[done + chunk].y - y_offset;
+      if (x >= fine_width || y >= fine_height)
+        break;
+
+      local[chunk] = RasterLocation(x, y);
+    }
+
+    if (chunk == 0)
+      break;
+
+    buffer.GetInterpolated(local, dest + done, chunk);
+    done += chunk;
+
+    if (chunk < ARRAY_SIZE(local))
+      break;
   }
 
+  return done;
+}
+
+unsigned
+RasterTile::CalculateDistance(int view_x, int view_y) const
+{
   const unsigned int dx1 = abs(view_x - (int)xstart);
   const unsigned int dx2 = abs((int)xend - view_x);
   const unsigned int dy1 = abs(view_y - (int)ystart);
   const unsigned int dy2 = abs((int)yend - view_y);
 
-  distance = std::max(std::min(dx1, dx2), std::min(dy1, dy2));
+  return std::max(std::min(dx1, dx2), std::min(dy1, dy2));
+}
+
+bool
+RasterTile::CheckTileVisibility(int view_x, int view_y, unsigned view_radius)
+{
+  if (!width || !height) {
+    Disable();
+    return false;
+  }
+
+  distance = CalculateDistance(view_x, view_y);
+  prefetch_distance = UINT_MAX;
   return distance <= view_radius || IsEnabled();
 }
 
+bool
+RasterTile::CheckPrefetchVisibility(int x, int y, unsigned radius)
+{
+  if (!width || !height)
+    return false;
+
+  const unsigned d = CalculateDistance(x, y);
+  if (d > radius)
+    return false;
+
+  prefetch_distance = d;
+  return true;
+}
+
 bool
 RasterTile::VisibilityChanged(int view_x, int view_y, unsigned view_radius)
 {
@@ -44,6 +44,14 @@ public:
    */
   unsigned distance;
 
+  /**
+   * The distance of this tile to the prefetch location, or UINT_MAX
+   * if it is not within the prefetch radius.  It is kept apart from
+   * #distance, so prefetching never pushes out tiles which are on
+   * the screen.
+   */
+  unsigned prefetch_distance;
+
   bool request;
 
   RasterBuffer buffer;
@@ -79,6 +87,10 @@ public:
     return distance;
   }
 
+  unsigned GetPrefetchDistance() const {
+    return prefetch_distance;
+  }
+
   bool IsRequested() const {
     return request;
   }
@@ -94,13 +106,43 @@ public:
   bool SaveCache(FILE *file) const;
   bool LoadCache(FILE *file);
 
+  /**
+   * Calculate the distance of the specified pixel location to this
+   * tile's boundary.
+   */
+  gcc_pure
+  unsigned CalculateDistance(int view_x, int view_y) const;
+
   bool CheckTileVisibility(int view_x, int view_y, unsigned view_radius);
 
+  /**
+   * Check whether this tile is within the specified prefetch radius,
+   * and update the "prefetch_distance" attribute.  Call this after
+   * VisibilityChanged().
+   */
+  bool CheckPrefetchVisibility(int x, int y, unsigned radius);
+
   void Disable() {
     buffer.Reset();
   }
 
-  void Enable();
+  /**
+   * Replace the (disabled) buffer of this tile with one that was
+   * decoded by RasterTileCache::LoadTiles().  The old buffer is
+   * returned in the #staging parameter.
+   */
+  void Swap(RasterBuffer &staging) {
+    buffer.Swap(staging);
+  }
+
+  /**
+   * Use height data in external memory (e.g. a memory mapped raw
+   * terrain file) instead of decoding this tile.
+   */
+  void SetExternal(const short *data) {
+    buffer.SetExternal(data, width, height);
+  }
+
   bool IsEnabled() const {
     return buffer.IsDefined();
   }
@@ -131,9 +173,15 @@ public:
   short GetInterpolatedHeight(unsigned x, unsigned y,
                               unsigned ix, unsigned iy) const;
 
-  inline short* GetImageBuffer() {
-    return buffer.GetData();
-  }
+  /**
+   * Batch version of GetInterpolatedHeight(): determine the
+   * interpolated heights at consecutive sub-pixel locations, until
+   * one is outside of this tile.  The tile must be enabled.
+   *
+   * @return the number of locations which were handled
+   */
+  unsigned GetInterpolatedHeights(const RasterLocation *locations,
+                                  short *dest, unsigned n) const;
 
   bool VisibilityChanged(int view_x, int view_y, unsigned view_radius);
 
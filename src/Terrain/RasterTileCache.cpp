@@ -28,6 +28,9 @@ Copyright_License {
 #include "IO/ZipLineReader.hpp"
 #include "Operation/Operation.hpp"
 #include "Math/FastMath.h"
+#include "Thread/FastMutex.hpp"
+#include "OS/FileMapping.hpp"
+#include "Util/AllocatedArray.hpp"
 
 #include <stdlib.h>
 #include <algorithm>
@@ -36,12 +39,141 @@ Copyright_License {
 using std::min;
 using std::max;
 
+/**
+ * Serialises access to libjasper, which passes its results to the
+ * global #raster_tile_current.  Terrain and weather maps may be
+ * decoded in different threads.
+ */
+static FastMutex jasper_mutex;
+
+extern JasperHandler *raster_tile_current;
+
+/**
+ * Decode a JPEG2000 file with libjasper, passing the results to the
+ * specified handler.
+ *
+ * @param overview true to scan the whole file and load the overview,
+ * false to decode only the tiles requested by the handler
+ * @return false if the file could not be opened
+ */
+static bool
+LoadJPG2000(JasperHandler &handler, const char *path, bool overview,
+            OperationEnvironment *operation)
+{
+  jasper_mutex.Lock();
+
+  jas_stream_t *in = jas_stream_fopen(path, "rb");
+  if (in == NULL) {
+    jasper_mutex.Unlock();
+    return false;
+  }
+
+  if (operation != NULL)
+    operation->SetProgressRange(jas_stream_length(in) / 65536);
+
+  raster_tile_current = &handler;
+  jp2_decode(in, overview ? "xcsoar=2" : "xcsoar=1");
+  raster_tile_current = NULL;
+
+  jas_stream_close(in);
+
+  jasper_mutex.Unlock();
+  return true;
+}
+
+class RasterTileCache::StagingHandler : public JasperHandler {
+  const RasterTileCache &cache;
+
+  /**
+   * The number of remaining segments after the current one.
+   */
+  unsigned remaining_segments;
+
+public:
+  StagingHandler(const RasterTileCache &_cache)
+    :cache(_cache), remaining_segments(0) {}
+
+  virtual long SkipMarkerSegment(long file_offset);
+
+  virtual void MarkerSegment(long file_offset, unsigned id) {
+    /* the segments were recorded while scanning the overview */
+  }
+
+  virtual void SetSize(unsigned width, unsigned height,
+                       unsigned tile_width, unsigned tile_height,
+                       unsigned tile_columns, unsigned tile_rows) {
+    /* already known; the cache must not be modified while other
+       threads may be reading */
+  }
+
+  virtual void SetTile(unsigned index,
+                       int xstart, int ystart, int xend, int yend) {
+    /* the tile geometry is already known */
+  }
+
+  virtual void SetLatLonBounds(double lon_min, double lon_max,
+                               double lat_min, double lat_max) {}
+  virtual void SetInitialised(bool val) {}
+
+  virtual short *GetImageBuffer(unsigned index);
+
+  virtual short *GetOverview() {
+    return NULL;
+  }
+};
+
+long
+RasterTileCache::StagingHandler::SkipMarkerSegment(long file_offset)
+{
+  if (remaining_segments > 0) {
+    /* enable the follow-up segment */
+    --remaining_segments;
+    return 0;
+  }
+
+  const MarkerSegmentInfo *segment = cache.FindMarkerSegment(file_offset);
+  if (segment == NULL)
+    /* past the end of the recorded segment list; shouldn't happen */
+    return 0;
+
+  long skip_to = segment->file_offset;
+  while (segment->IsTileSegment() &&
+         !cache.TileRequest(segment->tile)) {
+    ++segment;
+    if (segment >= cache.segments.end())
+      /* last segment is hidden; shouldn't happen either, because we
+         expect EOC there */
+      break;
+
+    skip_to = segment->file_offset;
+  }
+
+  remaining_segments = segment->count;
+  return skip_to - file_offset;
+}
+
+short *
+RasterTileCache::StagingHandler::GetImageBuffer(unsigned index)
+{
+  if (!cache.TileRequest(index))
+    return NULL;
+
+  const RasterTile &tile = cache.tiles.GetLinear(index);
+  for (auto it = cache.staged_tiles.begin(), end = cache.staged_tiles.end();
+       it != end; ++it) {
+    if (it->index == index) {
+      it->buffer.Resize(tile.width, tile.height);
+      return it->buffer.GetData();
+    }
+  }
+
+  return NULL;
+}
+
 short*
 RasterTileCache::GetImageBuffer(unsigned index)
 {
-  if (TileRequest(index))
-    return tiles.GetLinear(index).GetImageBuffer();
-
+  /* no tile is decoded while scanning the overview */
   return NULL;
 }
 
@@ -49,6 +181,8 @@ void
 RasterTileCache::SetTile(unsigned index,
                          int xstart, int ystart, int xend, int yend)
 {
+  assert(scan_overview);
+
   if (!segments.empty() && !segments.last().IsTileSegment())
     /* link current marker segment with this tile */
     segments.last().tile = index;
@@ -56,52 +190,82 @@ RasterTileCache::SetTile(unsigned index,
   tiles.GetLinear(index).Set(xstart, ystart, xend, yend);
 }
 
+/**
+ * Orders the tiles by their priority: first all tiles within the
+ * view radius, nearest first, then all others (loaded tiles which
+ * are out of range and prefetched tiles) by the distance to the
+ * nearer one of the view and the prefetch location.
+ */
 struct RTDistanceSort {
   const RasterTileCache &rtc;
+  const unsigned radius;
+
+  RTDistanceSort(RasterTileCache &_rtc, unsigned _radius)
+    :rtc(_rtc), radius(_radius) {}
 
-  RTDistanceSort(RasterTileCache &_rtc):rtc(_rtc) {}
+  gcc_pure
+  static unsigned GetNearestDistance(const RasterTile &tile) {
+    return std::min((unsigned)tile.GetDistance(),
+                    tile.GetPrefetchDistance());
+  }
 
   bool operator()(unsigned short ai, unsigned short bi) const {
     const RasterTile &a = rtc.tiles.GetLinear(ai);
     const RasterTile &b = rtc.tiles.GetLinear(bi);
 
-    return a.GetDistance() < b.GetDistance();
+    const bool a_view = (unsigned)a.GetDistance() <= radius;
+    const bool b_view = (unsigned)b.GetDistance() <= radius;
+    if (a_view != b_view)
+      return a_view;
+
+    if (a_view)
+      return a.GetDistance() < b.GetDistance();
+
+    return GetNearestDistance(a) < GetNearestDistance(b);
   }
 };
 
 bool
-RasterTileCache::PollTiles(int x, int y, unsigned radius)
+RasterTileCache::PollTiles(int x, int y, unsigned radius,
+                           int prefetch_x, int prefetch_y,
+                           unsigned prefetch_radius)
 {
-  if (scan_overview)
+  if (scan_overview || raw_file != NULL)
+    /* nothing to load: all tiles of a raw terrain file are always
+       enabled */
     return false;
 
+  assert(staged_tiles.empty());
+
   /* tiles are usually 256 pixels wide; with a radius smaller than
      that, the (optimized) tile distance calculations may fail;
      additionally, this ensures that tiles which are slightly out of
      the screen will be loaded in advance */
   radius += 256;
 
-  enum {
-    /**
-     * Maximum number of tiles loaded at a time, to reduce system load
-     * peaks.
-    */
-    MAX_ACTIVATE = MAX_ACTIVE_TILES > 32 ? 16 : MAX_ACTIVE_TILES / 2,
-  };
+  if (prefetch_radius > 0)
+    prefetch_radius += 256;
 
   /* query all tiles; all tiles which are either in range or already
      loaded are added to RequestTiles */
 
   request_tiles.clear();
-  for (int i = tiles.GetSize() - 1; i >= 0 && !request_tiles.full(); --i)
-    if (tiles.GetLinear(i).VisibilityChanged(x, y, radius))
+  for (int i = tiles.GetSize() - 1; i >= 0 && !request_tiles.full(); --i) {
+    RasterTile &tile = tiles.GetLinear(i);
+    bool visible = tile.VisibilityChanged(x, y, radius);
+    if (prefetch_radius > 0 &&
+        tile.CheckPrefetchVisibility(prefetch_x, prefetch_y, prefetch_radius))
+      visible = true;
+
+    if (visible)
       request_tiles.append(i);
+  }
 
   /* reduce if there are too many */
 
   if (request_tiles.size() > MAX_ACTIVE_TILES) {
-    /* sort by distance */
-    const RTDistanceSort sort(*this);
+    /* sort by distance, tiles on the screen first */
+    const RTDistanceSort sort(*this, radius);
     std::sort(request_tiles.begin(), request_tiles.end(), sort);
 
     /* dispose all tiles which are out of range */
@@ -123,10 +287,11 @@ RasterTileCache::PollTiles(int x, int y, unsigned radius)
     if (tile.IsEnabled())
       continue;
 
-    if (++num_activate <= MAX_ACTIVATE)
+    if (++num_activate <= MAX_ACTIVATE) {
       /* request the tile in the current iteration */
       tile.SetRequest();
-    else
+      staged_tiles.append().index = request_tiles[i];
+    } else
       /* this tile will be loaded in the next iteration */
       dirty = true;
   }
@@ -135,15 +300,9 @@ RasterTileCache::PollTiles(int x, int y, unsigned radius)
 }
 
 bool
-RasterTileCache::TileRequest(unsigned index)
+RasterTileCache::TileRequest(unsigned index) const
 {
-  RasterTile &tile = tiles.GetLinear(index);
-
-  if (!tile.IsRequested())
-    return false;
-
-  tile.Enable();
-  return true; // want to load this one!
+  return tiles.GetLinear(index).IsRequested();
 }
 
 short
@@ -182,11 +341,46 @@ RasterTileCache::GetInterpolatedHeight(unsigned int lx, unsigned int ly) const
                                    ly >> OVERVIEW_BITS);
 }
 
+void
+RasterTileCache::GetInterpolatedHeights(const RasterLocation *locations,
+                                        short *dest, unsigned n) const
+{
+  while (n > 0) {
+    const unsigned lx = locations->x, ly = locations->y;
+
+    unsigned done = 1;
+    if ((lx >= overview_width_fine) || (ly >= overview_height_fine))
+      // outside overall bounds
+      *dest = RasterBuffer::TERRAIN_INVALID;
+    else {
+      const RasterTile &tile = tiles.Get((lx >> SUBPIXEL_BITS) / tile_width,
+                                         (ly >> SUBPIXEL_BITS) / tile_height);
+      if (!tile.IsEnabled())
+        // go to overview
+        *dest = overview.GetInterpolated(lx >> OVERVIEW_BITS,
+                                         ly >> OVERVIEW_BITS);
+      else {
+        done = tile.GetInterpolatedHeights(locations, dest, n);
+        if (done == 0) {
+          *dest = RasterBuffer::TERRAIN_INVALID;
+          done = 1;
+        }
+      }
+    }
+
+    locations += done;
+    dest += done;
+    n -= done;
+  }
+}
+
 void
 RasterTileCache::SetSize(unsigned _width, unsigned _height,
                          unsigned _tile_width, unsigned _tile_height,
                          unsigned tile_columns, unsigned tile_rows)
 {
+  assert(scan_overview);
+
   width = _width;
   height = _height;
   tile_width = _tile_width;
@@ -218,12 +412,21 @@ RasterTileCache::Reset()
   initialised = false;
   bounds_initialised = false;
   segments.clear();
+  staged_tiles.clear();
   scan_overview = true;
 
   overview.Reset();
 
   for (auto it = tiles.begin(), end = tiles.end(); it != end; ++it)
     it->Disable();
+
+  delete raw_file;
+  raw_file = NULL;
+}
+
+RasterTileCache::~RasterTileCache()
+{
+  delete raw_file;
 }
 
 gcc_pure
@@ -238,37 +441,10 @@ RasterTileCache::FindMarkerSegment(uint32_t file_offset) const
 }
 
 long
-RasterTileCache::SkipMarkerSegment(long file_offset) const
+RasterTileCache::SkipMarkerSegment(long file_offset)
 {
-  if (scan_overview)
-    /* use all segments when loading the overview */
-    return 0;
-
-  if (remaining_segments > 0) {
-    /* enable the follow-up segment */
-    --remaining_segments;
-    return 0;
-  }
-
-  const MarkerSegmentInfo *segment = FindMarkerSegment(file_offset);
-  if (segment == NULL)
-    /* past the end of the recorded segment list; shouldn't happen */
-    return 0;
-
-  long skip_to = segment->file_offset;
-  while (segment->IsTileSegment() &&
-         !tiles.GetLinear(segment->tile).IsRequested()) {
-    ++segment;
-    if (segment >= segments.end())
-      /* last segment is hidden; shouldn't happen either, because we
-         expect EOC there */
-      break;
-
-    skip_to = segment->file_offset;
-  }
-
-  remaining_segments = segment->count;
-  return skip_to - file_offset;
+  /* use all segments when loading the overview */
+  return 0;
 }
 
 /**
@@ -293,7 +469,9 @@ is_tile_segment(unsigned id)
 void
 RasterTileCache::MarkerSegment(long file_offset, unsigned id)
 {
-  if (!scan_overview || segments.full())
+  assert(scan_overview);
+
+  if (segments.full())
     return;
 
   if (operation != NULL)
@@ -321,28 +499,6 @@ RasterTileCache::MarkerSegment(long file_offset, unsigned id)
                                       MarkerSegmentInfo::NO_TILE));
 }
 
-extern RasterTileCache *raster_tile_current;
-
-void
-RasterTileCache::LoadJPG2000(const char *jp2_filename)
-{
-  jas_stream_t *in;
-
-  raster_tile_current = this;
-
-  in = jas_stream_fopen(jp2_filename, "rb");
-  if (!in) {
-    Reset();
-    return;
-  }
-
-  if (operation != NULL)
-    operation->SetProgressRange(jas_stream_length(in) / 65536);
-
-  jp2_decode(in, scan_overview ? "xcsoar=2" : "xcsoar=1");
-  jas_stream_close(in);
-}
-
 bool
 RasterTileCache::LoadWorldFile(const TCHAR *path)
 {
@@ -412,7 +568,7 @@ RasterTileCache::LoadOverview(const char *path, const TCHAR *world_file,
 
   Reset();
 
-  LoadJPG2000(path);
+  LoadJPG2000(*this, path, true, operation);
   scan_overview = false;
 
   if (initialised && world_file != NULL)
@@ -434,20 +590,44 @@ RasterTileCache::UpdateTiles(const char *path, int x, int y, unsigned radius)
   if (!PollTiles(x, y, radius))
     return;
 
-  remaining_segments = 0;
+  CommitTiles(LoadTiles(path));
+}
 
-  LoadJPG2000(path);
+bool
+RasterTileCache::LoadTiles(const char *path) const
+{
+  assert(!scan_overview);
 
-  /* permanently disable the requested tiles which are still not
-     loaded, to prevent trying to reload them over and over in a busy
-     loop */
-  for (auto it = request_tiles.begin(), end = request_tiles.end();
-      it != end; ++it) {
-    RasterTile &tile = tiles.GetLinear(*it);
-    if (tile.IsRequested() && !tile.IsEnabled())
+  StagingHandler handler(*this);
+  return LoadJPG2000(handler, path, false, NULL);
+}
+
+void
+RasterTileCache::CommitTiles(bool loaded)
+{
+  if (!loaded) {
+    /* the file has vanished */
+    Reset();
+    return;
+  }
+
+  for (auto it = staged_tiles.begin(), end = staged_tiles.end();
+       it != end; ++it) {
+    RasterTile &tile = tiles.GetLinear(it->index);
+    if (it->buffer.IsDefined()) {
+      tile.Swap(it->buffer);
+      tile.ClearRequest();
+    } else
+      /* permanently disable the requested tiles which could not be
+         loaded, to prevent trying to reload them over and over in a
+         busy loop */
       tile.Clear();
+
+    it->buffer.Reset();
   }
 
+  staged_tiles.clear();
+
   ++serial;
 }
 
@@ -554,6 +734,106 @@ RasterTileCache::LoadCache(FILE *file)
   return true;
 }
 
+bool
+RasterTileCache::SaveRaw(const char *path, FILE *file)
+{
+  if (!initialised)
+    return false;
+
+  RawHeader header;
+  header.magic = RawHeader::MAGIC;
+  header.version = RawHeader::VERSION;
+  header.width = width;
+  header.height = height;
+  header.tile_width = tile_width;
+  header.tile_height = tile_height;
+  header.tile_columns = tiles.GetWidth();
+  header.tile_rows = tiles.GetHeight();
+
+  if (fwrite(&header, sizeof(header), 1, file) != 1)
+    return false;
+
+  const unsigned block_size = tile_width * tile_height;
+  AllocatedArray<short> padding(block_size);
+  std::fill(padding.begin(), padding.end(), 0);
+
+  for (auto it = tiles.begin(), end = tiles.end(); it != end; ++it)
+    it->ClearRequest();
+
+  for (unsigned i = 0; i < tiles.GetSize(); ++i) {
+    RasterTile &tile = tiles.GetLinear(i);
+
+    unsigned size = 0;
+    if (tile.IsDefined()) {
+      if (!tile.IsEnabled()) {
+        /* decode just this one tile, to keep memory usage low */
+        tile.SetRequest();
+        staged_tiles.append().index = i;
+        CommitTiles(LoadTiles(path));
+
+        if (!tile.IsEnabled())
+          return false;
+      }
+
+      size = tile.width * tile.height;
+      assert(size <= block_size);
+
+      if (fwrite(tile.buffer.GetData(), sizeof(short), size, file) != size)
+        return false;
+
+      tile.Disable();
+    }
+
+    if (fwrite(padding.begin(), sizeof(short), block_size - size,
+               file) != block_size - size)
+      return false;
+  }
+
+  return true;
+}
+
+bool
+RasterTileCache::LoadRaw(const TCHAR *path)
+{
+  if (!initialised)
+    return false;
+
+  FileMapping *mapping = new FileMapping(path);
+  if (mapping->error() || mapping->size() < sizeof(RawHeader)) {
+    delete mapping;
+    return false;
+  }
+
+  const RawHeader &header = *(const RawHeader *)mapping->data();
+  const size_t block_bytes = tile_width * tile_height * sizeof(short);
+  if (header.magic != RawHeader::MAGIC ||
+      header.version != RawHeader::VERSION ||
+      header.width != width || header.height != height ||
+      header.tile_width != tile_width || header.tile_height != tile_height ||
+      header.tile_columns != tiles.GetWidth() ||
+      header.tile_rows != tiles.GetHeight() ||
+      mapping->size() < sizeof(header) + tiles.GetSize() * block_bytes) {
+    delete mapping;
+    return false;
+  }
+
+  delete raw_file;
+  raw_file = mapping;
+
+  for (unsigned i = 0; i < tiles.GetSize(); ++i) {
+    RasterTile &tile = tiles.GetLinear(i);
+    if (tile.IsDefined())
+      tile.SetExternal((const short *)
+                       mapping->at(sizeof(header) + i * block_bytes));
+    else
+      tile.Disable();
+  }
+
+  dirty = false;
+  ++serial;
+  return true;
+}
+
 struct GridLocation : public RasterLocation {
   unsigned short tile_x, tile_y;
   unsigned remainder_x, remainder_y;
@@ -29,6 +29,7 @@ Copyright_License {
 #include "Util/NonCopyable.hpp"
 #include "Util/StaticArray.hpp"
 #include "Util/Serial.hpp"
+#include "Terrain/JasperHandler.hpp"
 
 #include <assert.h>
 #include <tchar.h>
@@ -41,8 +42,9 @@ Copyright_License {
 struct RasterLocation;
 struct GridLocation;
 class OperationEnvironment;
+class FileMapping;
 
-class RasterTileCache : private NonCopyable {
+class RasterTileCache : public JasperHandler, private NonCopyable {
   static const unsigned MAX_RTC_TILES = 4096;
 
   /**
@@ -62,6 +64,13 @@ class RasterTileCache : private NonCopyable {
   static const unsigned MAX_ACTIVE_TILES = 16;
 #endif
 
+  /**
+   * Maximum number of tiles loaded at a time, to reduce system load
+   * peaks.
+   */
+  static const unsigned MAX_ACTIVATE =
+    MAX_ACTIVE_TILES > 32 ? 16 : MAX_ACTIVE_TILES / 2;
+
   /**
    * The width and height of the terrain bitmap is shifted by this
    * number of bits to determine the overview size.
@@ -114,6 +123,20 @@ protected:
     }
   };
 
+  /**
+   * A tile which has been decoded by LoadTiles(), but which has not
+   * yet been activated by CommitTiles().
+   */
+  struct StagedTile {
+    unsigned index;
+
+    /**
+     * The decoded height data.  This remains undefined if libjasper
+     * did not deliver the tile.
+     */
+    RasterBuffer buffer;
+  };
+
   struct CacheHeader {
     enum {
 #ifdef FIXED_MATH
@@ -131,6 +154,25 @@ protected:
     GeoBounds bounds;
   };
 
+  /**
+   * The header of an uncompressed terrain file, see SaveRaw().  It
+   * is followed by one block of tile_width * tile_height heights per
+   * tile, in host byte order.  Each tile's rows are packed with its
+   * own width; the remainder of a block is padding.
+   */
+  struct RawHeader {
+    enum {
+      MAGIC = 0x7852544e,
+      VERSION = 1,
+    };
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width, height;
+    uint32_t tile_width, tile_height;
+    uint32_t tile_columns, tile_rows;
+  };
+
   bool initialised;
 
   /** is the "bounds" attribute valid? */
@@ -156,11 +198,6 @@ protected:
 
   StaticArray<MarkerSegmentInfo, 8192> segments;
 
-  /**
-   * The number of remaining segments after the current one.
-   */
-  mutable unsigned remaining_segments;
-
   /**
    * An array that is used to sort the requested tiles by distance.
    * This is only used by PollTiles() internally, but is stored in the
@@ -168,16 +205,39 @@ protected:
    */
   StaticArray<uint16_t, MAX_RTC_TILES> request_tiles;
 
+  /**
+   * The tiles which were requested by PollTiles().  LoadTiles()
+   * decodes into these buffers (via #StagingHandler) instead of the
+   * live tiles, so other threads may keep reading the map meanwhile;
+   * CommitTiles() swaps them in.
+   */
+  mutable StaticArray<StagedTile, MAX_ACTIVATE> staged_tiles;
+
+  /**
+   * Receives the tiles decoded by LoadTiles().  It writes only to
+   * #staged_tiles.
+   */
+  class StagingHandler;
+
+  /**
+   * The memory mapped uncompressed terrain file, if one was loaded
+   * by LoadRaw().  All tiles point into this mapping, and no tile is
+   * ever decoded from the JPEG2000 file.
+   */
+  FileMapping *raw_file;
+
   /**
    * Progress callbacks for loading the file during startup.
    */
   OperationEnvironment *operation;
 
 public:
-  RasterTileCache():operation(NULL) {
+  RasterTileCache():raw_file(NULL), operation(NULL) {
     Reset();
   }
 
+  ~RasterTileCache();
+
 protected:
   void ScanTileLine(GridLocation start, GridLocation end,
                     short *buffer, unsigned size, bool interpolate) const;
@@ -204,6 +264,17 @@ public:
   short GetInterpolatedHeight(unsigned int lx,
                               unsigned int ly) const;
 
+  /**
+   * Batch version of GetInterpolatedHeight().  The tile is looked up
+   * only once for each run of locations inside the same tile, so
+   * this is fastest when neighbouring locations are close to each
+   * other.
+   *
+   * @param locations sub-pixel locations
+   */
+  void GetInterpolatedHeights(const RasterLocation *locations,
+                              short *dest, unsigned n) const;
+
   /**
    * Scan a straight line and fill the buffer with the specified
    * number of samples along the line.
@@ -229,8 +300,6 @@ public:
                short h_origin, const int slope_fact) const;
 
 protected:
-  void LoadJPG2000(const char *path);
-
   /**
    * Load a world file (*.tfw or *.j2w).
    */
@@ -251,8 +320,65 @@ public:
   bool SaveCache(FILE *file) const;
   bool LoadCache(FILE *file);
 
+  /**
+   * Decode all tiles one by one and write them uncompressed to the
+   * specified file, which can later be used by LoadRaw().  This takes
+   * a long time; it is meant to be done once by the
+   * GenerateRawTerrain tool.
+   *
+   * @param path the path of the JPEG2000 file
+   */
+  bool SaveRaw(const char *path, FILE *file);
+
+  /**
+   * Map a file generated by SaveRaw() into memory, and enable all
+   * tiles from it.  This replaces the JPEG2000 decoder for this map:
+   * loading a tile is just a page fault, and the number of active
+   * tiles is not limited by #MAX_ACTIVE_TILES.
+   */
+  bool LoadRaw(const TCHAR *path);
+
+  /**
+   * Load all tiles around the specified location synchronously.  This
+   * is a shortcut for PollTiles(), LoadTiles() and CommitTiles().
+   */
   void UpdateTiles(const char *path, int x, int y, unsigned radius);
 
+  /**
+   * Determine which tiles shall be loaded, dispose tiles which are
+   * out of range, and schedule the nearest missing tiles for
+   * LoadTiles().  The caller must hold an exclusive lock.
+   *
+   * @param prefetch_radius if non-zero, then tiles within this radius
+   * around (prefetch_x, prefetch_y) are loaded as well, e.g. the
+   * region the aircraft is heading to
+   * @return true if LoadTiles() and CommitTiles() need to be called
+   */
+  bool PollTiles(int x, int y, unsigned radius,
+                 int prefetch_x=0, int prefetch_y=0,
+                 unsigned prefetch_radius=0);
+
+  /**
+   * Decode the tiles scheduled by PollTiles() into a staging area.
+   * This does not modify anything which is visible to readers, so
+   * the caller needs only a shared lock, and other threads may
+   * continue to use the map.  It must not be called concurrently
+   * with PollTiles() or CommitTiles().
+   *
+   * @return false if the file could not be opened; pass this to
+   * CommitTiles()
+   */
+  bool LoadTiles(const char *path) const;
+
+  /**
+   * Activate the tiles which were decoded by LoadTiles().  The caller
+   * must hold an exclusive lock.
+   *
+   * @param loaded the return value of LoadTiles(); if false, the
+   * map is reset
+   */
+  void CommitTiles(bool loaded=true);
+
   /**
    * Determines if there are still tiles scheduled to be loaded.  Call
    * this after UpdateTiles() to determine if UpdateTiles() should be
@@ -284,33 +410,32 @@ private:
   FindMarkerSegment(uint32_t file_offset) const;
 
 public:
-  /* callback methods for libjasper (via jas_rtc.cpp) */
+  /* callback methods for libjasper (via jas_rtc.cpp), used while
+     scanning the overview */
 
-  long SkipMarkerSegment(long file_offset) const;
-  void MarkerSegment(long file_offset, unsigned id);
+  virtual long SkipMarkerSegment(long file_offset);
+  virtual void MarkerSegment(long file_offset, unsigned id);
 
-  bool TileRequest(unsigned index);
+  gcc_pure
+  bool TileRequest(unsigned index) const;
 
-  short *GetOverview() {
+  virtual short *GetOverview() {
     return overview.GetData();
   }
 
-  void SetSize(unsigned width, unsigned height,
-               unsigned tile_width, unsigned tile_height,
-               unsigned tile_columns, unsigned tile_rows);
-  short* GetImageBuffer(unsigned index);
-  void SetLatLonBounds(double lon_min, double lon_max,
-                       double lat_min, double lat_max);
-  void SetTile(unsigned index, int xstart, int ystart, int xend, int yend);
+  virtual void SetSize(unsigned width, unsigned height,
+                       unsigned tile_width, unsigned tile_height,
+                       unsigned tile_columns, unsigned tile_rows);
+  virtual short *GetImageBuffer(unsigned index);
+  virtual void SetLatLonBounds(double lon_min, double lon_max,
+                               double lat_min, double lat_max);
+  virtual void SetTile(unsigned index,
+                       int xstart, int ystart, int xend, int yend);
 
-  void SetInitialised(bool val) {
+  virtual void SetInitialised(bool val) {
     initialised = val;
   }
 
-protected:
-  bool PollTiles(int x, int y, unsigned radius);
-
-public:
   short GetMaxElevation() const {
     return overview.GetMaximum();
   }
@@ -0,0 +1,107 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Terrain/TerrainLoader.hpp"
+#include "Terrain/RasterTerrain.hpp"
+
+TerrainLoader::TerrainLoader(RasterTerrain &_terrain)
+  :terrain(_terrain), modified(false) {}
+
+void
+TerrainLoader::StopAsync()
+{
+  ScopeLock protect(mutex);
+  modified = false;
+  StandbyThread::StopAsync();
+}
+
+void
+TerrainLoader::WaitStopped()
+{
+  ScopeLock protect(mutex);
+  StandbyThread::WaitStopped();
+}
+
+void
+TerrainLoader::SetViewCenter(const GeoPoint &_location, fixed _radius,
+                             const GeoPoint &_prefetch_location,
+                             fixed _prefetch_radius)
+{
+  ScopeLock protect(mutex);
+
+  center = _location;
+  radius = _radius;
+  prefetch_location = _prefetch_location;
+  prefetch_radius = _prefetch_radius;
+
+  if (IsBusy())
+    /* Tick() will pick up the new location when it's done */
+    modified = true;
+  else
+    Trigger();
+}
+
+void
+TerrainLoader::Tick()
+{
+  bool dirty;
+
+  do {
+    modified = false;
+
+    const GeoPoint _center = center;
+    const fixed _radius = radius;
+    const GeoPoint _prefetch_location = prefetch_location;
+    const fixed _prefetch_radius = prefetch_radius;
+
+    mutex.Unlock();
+
+    bool load;
+
+    {
+      RasterTerrain::ExclusiveLease lease(terrain);
+      load = lease->PollTiles(_center, _radius,
+                              _prefetch_location, _prefetch_radius);
+      dirty = load && lease->IsDirty();
+    }
+
+    if (load) {
+      bool loaded;
+
+      {
+        /* decode with a shared lock, so the other threads can
+           continue to use the terrain meanwhile */
+        RasterTerrain::Lease lease(terrain);
+        loaded = lease->LoadTiles();
+      }
+
+      RasterTerrain::ExclusiveLease lease(terrain);
+      lease->CommitTiles(loaded);
+    }
+
+    mutex.Lock();
+
+    /* continue with the next batch of tiles until everything within
+       range is loaded */
+  } while ((dirty || modified) && !IsStopped());
+}
@@ -0,0 +1,79 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_LOADER_HPP
+#define XCSOAR_TERRAIN_LOADER_HPP
+
+#include "Thread/StandbyThread.hpp"
+#include "Navigation/GeoPoint.hpp"
+#include "Math/fixed.hpp"
+
+class RasterTerrain;
+
+/**
+ * A thread which loads terrain tiles in background.  The JPEG2000
+ * tiles are decoded while other threads continue to read the
+ * terrain; the exclusive lock is only held for a short time while
+ * the new tiles are swapped in.
+ *
+ * Besides the tiles around the screen center, the tiles around a
+ * "prefetch" location (e.g. where the aircraft will be in a few
+ * minutes) are loaded in advance.
+ */
+class TerrainLoader : protected StandbyThread {
+  RasterTerrain &terrain;
+
+  GeoPoint center;
+  fixed radius;
+
+  GeoPoint prefetch_location;
+  fixed prefetch_radius;
+
+  /**
+   * Has a new location been submitted while the thread was busy?
+   */
+  bool modified;
+
+public:
+  TerrainLoader(RasterTerrain &_terrain);
+
+  void StopAsync();
+  void WaitStopped();
+
+  /**
+   * Schedule loading the tiles around the specified location, and
+   * return immediately.  If the thread is still busy, it picks up the
+   * new location as soon as the current batch of tiles is done.
+   *
+   * @param prefetch_radius the radius around #prefetch_location;
+   * zero disables prefetching
+   */
+  void SetViewCenter(const GeoPoint &location, fixed radius,
+                     const GeoPoint &prefetch_location,
+                     fixed prefetch_radius);
+
+protected:
+  virtual void Tick();
+};
+
+#endif
@@ -169,6 +169,7 @@ TerrainRenderer::TerrainRenderer(const RasterTerrain *_terrain)
 {
   assert(terrain != NULL);
   settings.SetDefaults();
+  raster_renderer.SetThreads(settings.threads);
 }
 
 void
@@ -226,6 +227,7 @@ TerrainRenderer::SetSettings(const TerrainRendererSettings &_settings)
 
   settings = _settings;
   compare_projection.Clear();
+  raster_renderer.SetThreads(settings.threads);
 }
 
 void
@@ -238,7 +240,11 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
     /* no change since previous frame */
     return;
 
-  terrain_serial = terrain->GetSerial();
+  if (terrain_serial != terrain->GetSerial()) {
+    /* new tiles have been loaded: don't reuse the old height matrix */
+    terrain_serial = terrain->GetSerial();
+    raster_renderer.Invalidate();
+  }
 
   last_sun_azimuth = sunazimuth;
 
@@ -50,6 +50,12 @@ struct TerrainRendererSettings {
 
   short ramp;
 
+  /**
+   * The number of threads which render the terrain.  0 means one for
+   * each CPU core.
+   */
+  unsigned threads;
+
   /**
    * Set all attributes to the default values.
    */
@@ -60,7 +66,8 @@ struct TerrainRendererSettings {
       slope_shading == other.slope_shading &&
       contrast == other.contrast &&
       brightness == other.brightness &&
-      ramp == other.ramp;
+      ramp == other.ramp &&
+      threads == other.threads;
   }
 
   bool operator!=(const TerrainRendererSettings &other) const {
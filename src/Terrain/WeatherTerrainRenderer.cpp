@@ -202,7 +202,12 @@ WeatherTerrainRenderer::Generate(const WindowProjection &projection,
     last_color_ramp = color_ramp;
   }
 
+  /* the weather map may have changed at any time; always scan it
+     completely, and don't let the terrain renderer reuse the weather
+     data afterwards */
+  raster_renderer.Invalidate();
   raster_renderer.ScanMap(*map, projection);
+  raster_renderer.Invalidate();
 
   raster_renderer.GenerateImage(do_shading, height_scale,
                                 settings.contrast, settings.brightness,
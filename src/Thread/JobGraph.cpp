@@ -0,0 +1,255 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thread/JobGraph.hpp"
+#include "OS/Clock.hpp"
+#include "OS/Sleep.h"
+
+unsigned
+JobGraph::Add(const TCHAR *name, Job &job, unsigned weight)
+{
+  assert(n_jobs < MAX_JOBS);
+
+  Entry &entry = entries[n_jobs];
+  entry.name = name;
+  entry.job = &job;
+  entry.weight = weight;
+  entry.dependencies = 0;
+  entry.state = WAITING;
+  entry.text.clear();
+  entry.progress_range = entry.progress_position = 0;
+  entry.errors.clear();
+  entry.start_time = entry.duration = 0;
+
+  return n_jobs++;
+}
+
+bool
+JobGraph::Environment::IsCancelled() const
+{
+  return false;
+}
+
+void
+JobGraph::Environment::Sleep(unsigned ms)
+{
+  ::Sleep(ms);
+}
+
+void
+JobGraph::Environment::SetErrorMessage(const TCHAR *text)
+{
+  ScopeLock protect(graph.mutex);
+  if (!entry.errors.full())
+    entry.errors.append() = text;
+}
+
+void
+JobGraph::Environment::SetText(const TCHAR *text)
+{
+  ScopeLock protect(graph.mutex);
+  entry.text = text;
+  entry.progress_range = entry.progress_position = 0;
+}
+
+void
+JobGraph::Environment::SetProgressRange(unsigned range)
+{
+  ScopeLock protect(graph.mutex);
+  entry.progress_range = range;
+  entry.progress_position = 0;
+}
+
+void
+JobGraph::Environment::SetProgressPosition(unsigned position)
+{
+  ScopeLock protect(graph.mutex);
+  entry.progress_position = position;
+}
+
+void
+JobGraph::Worker::Run()
+{
+  graph->RunWorker();
+}
+
+int
+JobGraph::FindReady() const
+{
+  unsigned done = 0;
+  for (unsigned i = 0; i < n_jobs; ++i)
+    if (entries[i].state == DONE)
+      done |= 1u << i;
+
+  for (unsigned i = 0; i < n_jobs; ++i)
+    if (entries[i].state == WAITING &&
+        (entries[i].dependencies & ~done) == 0)
+      return i;
+
+  return -1;
+}
+
+bool
+JobGraph::HasWaiting() const
+{
+  for (unsigned i = 0; i < n_jobs; ++i)
+    if (entries[i].state == WAITING)
+      return true;
+
+  return false;
+}
+
+void
+JobGraph::RunJob(Entry &entry, OperationEnvironment &env)
+{
+  assert(entry.state == WAITING);
+
+  entry.state = RUNNING;
+  const unsigned start = MonotonicClockMS();
+  entry.start_time = start - start_clock;
+
+  mutex.Unlock();
+  entry.job->Run(env);
+  mutex.Lock();
+
+  entry.duration = MonotonicClockMS() - start;
+  entry.state = DONE;
+  ++n_done;
+  cond.Broadcast();
+}
+
+void
+JobGraph::RunWorker()
+{
+  ScopeLock protect(mutex);
+
+  while (HasWaiting()) {
+    const int i = FindReady();
+    if (i < 0) {
+      /* wait for a running job to finish */
+      cond.Wait(mutex);
+      continue;
+    }
+
+    Environment env(*this, entries[i]);
+    RunJob(entries[i], env);
+  }
+}
+
+void
+JobGraph::GetProgress(StaticString<128> &text, unsigned &position) const
+{
+  text.clear();
+
+  unsigned total_weight = 0;
+  unsigned long progress = 0;
+
+  for (unsigned i = 0; i < n_jobs; ++i) {
+    const Entry &entry = entries[i];
+    total_weight += entry.weight;
+
+    if (entry.state == DONE)
+      progress += (unsigned long)entry.weight * PROGRESS_RANGE;
+    else if (entry.state == RUNNING) {
+      if (text.empty() && !entry.text.empty())
+        text = entry.text;
+
+      if (entry.progress_range > 0 &&
+          entry.progress_position <= entry.progress_range)
+        progress += (unsigned long)entry.weight * PROGRESS_RANGE
+          * entry.progress_position / entry.progress_range;
+    }
+  }
+
+  position = total_weight > 0
+    ? unsigned(progress / total_weight)
+    : PROGRESS_RANGE;
+}
+
+void
+JobGraph::Run(OperationEnvironment &env, unsigned n_threads)
+{
+  start_clock = MonotonicClockMS();
+
+  if (n_threads > MAX_THREADS)
+    n_threads = MAX_THREADS;
+  if (n_threads > n_jobs)
+    n_threads = n_jobs;
+
+  Worker workers[MAX_THREADS];
+  unsigned n_started = 0;
+  for (unsigned i = 0; i < n_threads; ++i) {
+    workers[n_started].SetGraph(*this);
+    if (workers[n_started].Start())
+      ++n_started;
+  }
+
+  mutex.Lock();
+
+  if (n_started == 0) {
+    /* no threads: run all jobs in the order they were added */
+    for (unsigned i = 0; i < n_jobs; ++i) {
+      assert(FindReady() == (int)i);
+      RunJob(entries[i], env);
+    }
+
+    mutex.Unlock();
+    return;
+  }
+
+  StaticString<128> text, new_text;
+  text.clear();
+
+  unsigned position;
+  while (n_done < n_jobs) {
+    GetProgress(new_text, position);
+    mutex.Unlock();
+
+    if (!new_text.empty() && new_text != text) {
+      text = new_text;
+      env.SetText(text);
+      env.SetProgressRange(PROGRESS_RANGE);
+    }
+
+    env.SetProgressPosition(position);
+
+    mutex.Lock();
+    if (n_done < n_jobs)
+      cond.Wait(mutex, 200);
+  }
+
+  mutex.Unlock();
+
+  for (unsigned i = 0; i < n_started; ++i)
+    workers[i].Join();
+
+  ReplayErrors(env);
+}
+
+void
+JobGraph::ReplayErrors(OperationEnvironment &env)
+{
+  for (unsigned i = 0; i < n_jobs; ++i)
+    for (unsigned j = 0; j < entries[i].errors.size(); ++j)
+      env.SetErrorMessage(entries[i].errors[j]);
+}
@@ -0,0 +1,265 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_JOB_GRAPH_HPP
+#define XCSOAR_THREAD_JOB_GRAPH_HPP
+
+#include "Thread/Thread.hpp"
+#include "Thread/Mutex.hpp"
+#include "Thread/Cond.hpp"
+#include "Operation/Operation.hpp"
+#include "Util/NonCopyable.hpp"
+#include "Util/StaticString.hpp"
+#include "Util/StaticArray.hpp"
+#include "Compiler.h"
+
+#include <assert.h>
+#include <tchar.h>
+
+/**
+ * Runs a set of jobs on a number of threads, honouring the
+ * dependencies between them: a job is started only after all jobs it
+ * depends on have finished.  The progress of all running jobs is
+ * combined and forwarded to the caller's #OperationEnvironment, from
+ * the calling thread only.  Error messages are queued and passed on
+ * after all jobs have finished.
+ *
+ * Jobs must be added in a valid order (a job can only depend on jobs
+ * added before it), which is the order they are run in if no thread
+ * can be launched.
+ */
+class JobGraph : private NonCopyable {
+public:
+  static const unsigned MAX_JOBS = 16;
+  static const unsigned MAX_THREADS = 8;
+
+  /**
+   * The number of error messages queued per job; further ones are
+   * discarded.
+   */
+  static const unsigned MAX_ERRORS = 3;
+
+  class Job {
+  public:
+    virtual ~Job() {}
+
+    /**
+     * Run the job.  This gets called in a worker thread; the
+     * #OperationEnvironment may be used from there.
+     */
+    virtual void Run(OperationEnvironment &env) = 0;
+  };
+
+private:
+  enum State {
+    WAITING,
+    RUNNING,
+    DONE,
+  };
+
+  struct Entry {
+    const TCHAR *name;
+    Job *job;
+    unsigned weight;
+
+    /**
+     * A bit mask of the jobs which must be finished before this one
+     * may start.
+     */
+    unsigned dependencies;
+
+    State state;
+
+    StaticString<128> text;
+    unsigned progress_range, progress_position;
+
+    /**
+     * Error messages reported by the job, to be replayed on the
+     * calling thread when Run() returns.
+     */
+    StaticArray<StaticString<256>, MAX_ERRORS> errors;
+
+    /**
+     * Start time and duration [ms]; the start time is relative to
+     * the beginning of Run().
+     */
+    unsigned start_time, duration;
+  };
+
+  /**
+   * The #OperationEnvironment passed to a job.  It records text,
+   * progress and errors in the #Entry, and the calling thread picks
+   * them up.
+   */
+  class Environment : public OperationEnvironment {
+    JobGraph &graph;
+    Entry &entry;
+
+  public:
+    Environment(JobGraph &_graph, Entry &_entry)
+      :graph(_graph), entry(_entry) {}
+
+    virtual bool IsCancelled() const;
+    virtual void Sleep(unsigned ms);
+    virtual void SetErrorMessage(const TCHAR *text);
+    virtual void SetText(const TCHAR *text);
+    virtual void SetProgressRange(unsigned range);
+    virtual void SetProgressPosition(unsigned position);
+  };
+
+  class Worker : public Thread {
+    JobGraph *graph;
+
+  public:
+    void SetGraph(JobGraph &_graph) {
+      graph = &_graph;
+    }
+
+  protected:
+    virtual void Run();
+  };
+
+  Entry entries[MAX_JOBS];
+  unsigned n_jobs;
+
+  /**
+   * Protects the state, text, progress and errors of all entries.
+   */
+  Mutex mutex;
+
+  /**
+   * Broadcast whenever a job has finished.
+   */
+  Cond cond;
+
+  unsigned n_done;
+
+  unsigned start_clock;
+
+public:
+  JobGraph():n_jobs(0), n_done(0) {}
+
+  /**
+   * Add a new job.
+   *
+   * @param weight the share of this job in the combined progress bar
+   * @return the job's index, to be passed to AddDependency()
+   */
+  unsigned Add(const TCHAR *name, Job &job, unsigned weight=1);
+
+  /**
+   * Declare that a job may start only after another one has finished.
+   * The other job must have been added before.
+   */
+  void AddDependency(unsigned job, unsigned dependency) {
+    assert(job < n_jobs);
+    assert(dependency < job);
+
+    entries[job].dependencies |= 1u << dependency;
+  }
+
+  /**
+   * Run all jobs and return after all of them have finished.  Error
+   * messages of jobs which ran in a worker thread are passed to the
+   * given #OperationEnvironment before this method returns.
+   *
+   * @param n_threads the number of worker threads; 0 runs all jobs in
+   * the calling thread
+   */
+  void Run(OperationEnvironment &env, unsigned n_threads);
+
+  unsigned GetJobCount() const {
+    return n_jobs;
+  }
+
+  const TCHAR *GetName(unsigned i) const {
+    assert(i < n_jobs);
+
+    return entries[i].name;
+  }
+
+  /**
+   * Returns the time [ms] when the job was started, relative to the
+   * beginning of Run().
+   */
+  unsigned GetStartTime(unsigned i) const {
+    assert(i < n_jobs);
+    assert(entries[i].state == DONE);
+
+    return entries[i].start_time;
+  }
+
+  /**
+   * Returns the time [ms] the job took.
+   */
+  unsigned GetDuration(unsigned i) const {
+    assert(i < n_jobs);
+    assert(entries[i].state == DONE);
+
+    return entries[i].duration;
+  }
+
+private:
+  /**
+   * Find a job which waits for nothing but finished jobs.  Caller
+   * must hold the mutex.
+   *
+   * @return the job's index or -1 if there is none
+   */
+  gcc_pure
+  int FindReady() const;
+
+  /**
+   * Are there jobs which have not been started yet?  Caller must hold
+   * the mutex.
+   */
+  gcc_pure
+  bool HasWaiting() const;
+
+  /**
+   * Run one job in the current thread.  Caller must hold the mutex,
+   * which is released while the job runs.
+   */
+  void RunJob(Entry &entry, OperationEnvironment &env);
+
+  /**
+   * The main loop of a worker thread: run jobs until none is left.
+   */
+  void RunWorker();
+
+  /**
+   * Determine the text of the first running job which has one, and
+   * the combined progress of all jobs.  Caller must hold the mutex.
+   */
+  void GetProgress(StaticString<128> &text, unsigned &position) const;
+
+  /**
+   * Pass the queued error messages of all jobs to the given
+   * #OperationEnvironment, in the order the jobs were added.
+   */
+  void ReplayErrors(OperationEnvironment &env);
+
+  static const unsigned PROGRESS_RANGE = 1000;
+};
+
+#endif
@@ -130,6 +130,17 @@ protected:
     return pending || busy;
   }
 
+  /**
+   * Has the thread been asked to stop?  A Tick() implementation which
+   * runs for a long time should check this periodically.
+   *
+   * Caller must lock the mutex.
+   */
+  gcc_pure
+  bool IsStopped() const {
+    return stop;
+  }
+
   /**
    * Send the "stop" command to the thread.
    *
@@ -0,0 +1,134 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thread/ThreadPool.hpp"
+
+#ifdef HAVE_POSIX
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+#include <assert.h>
+
+void
+ThreadPool::Worker::Start(Job &_job, unsigned _begin, unsigned _end)
+{
+  ScopeLock protect(mutex);
+  job = &_job;
+  begin = _begin;
+  end = _end;
+  done = false;
+  Trigger();
+}
+
+void
+ThreadPool::Worker::Wait()
+{
+  mutex.Lock();
+  WaitDone();
+  const bool was_done = done;
+  mutex.Unlock();
+
+  if (!was_done)
+    /* the thread has failed to start; do it here */
+    job->Run(begin, end);
+}
+
+void
+ThreadPool::Worker::Stop()
+{
+  ScopeLock protect(mutex);
+  StandbyThread::Stop();
+}
+
+void
+ThreadPool::Worker::Tick()
+{
+  mutex.Unlock();
+  job->Run(begin, end);
+  mutex.Lock();
+
+  done = true;
+}
+
+ThreadPool::ThreadPool(unsigned _n_workers)
+  :n_workers(_n_workers < MAX_WORKERS ? _n_workers : MAX_WORKERS) {}
+
+ThreadPool::~ThreadPool()
+{
+  for (unsigned i = 0; i < MAX_WORKERS; ++i)
+    workers[i].Stop();
+}
+
+unsigned
+ThreadPool::GetDefaultWorkerCount()
+{
+#ifdef HAVE_POSIX
+  const long n = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  const long n = info.dwNumberOfProcessors;
+#endif
+
+  if (n <= 1)
+    return 0;
+
+  return n - 1 < (long)MAX_WORKERS ? n - 1 : MAX_WORKERS;
+}
+
+void
+ThreadPool::SetWorkerCount(unsigned n)
+{
+  if (n > MAX_WORKERS)
+    n = MAX_WORKERS;
+
+  for (unsigned i = n; i < n_workers; ++i)
+    workers[i].Stop();
+
+  n_workers = n;
+}
+
+void
+ThreadPool::Run(Job &job, unsigned begin, unsigned end)
+{
+  assert(begin <= end);
+
+  const unsigned n = end - begin;
+  const unsigned n_bands = n < n_workers + 1 ? n : n_workers + 1;
+  if (n_bands <= 1) {
+    if (n > 0)
+      job.Run(begin, end);
+    return;
+  }
+
+  for (unsigned i = 1; i < n_bands; ++i)
+    workers[i - 1].Start(job, begin + n * i / n_bands,
+                         begin + n * (i + 1) / n_bands);
+
+  job.Run(begin, begin + n / n_bands);
+
+  for (unsigned i = 1; i < n_bands; ++i)
+    workers[i - 1].Wait();
+}
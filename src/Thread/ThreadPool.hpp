@@ -0,0 +1,118 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_THREAD_POOL_HPP
+#define XCSOAR_THREAD_THREAD_POOL_HPP
+
+#include "Thread/StandbyThread.hpp"
+#include "Util/NonCopyable.hpp"
+
+/**
+ * A small pool of threads which splits a range of work items (e.g.
+ * the rows of an image) into bands and processes them in parallel.
+ * The calling thread processes the first band itself, and waits
+ * until the other bands are finished.
+ *
+ * The threads are launched on demand.
+ */
+class ThreadPool : private NonCopyable {
+public:
+  /**
+   * The maximum number of worker threads.
+   */
+  static const unsigned MAX_WORKERS = 15;
+
+  class Job {
+  public:
+    /**
+     * Process the items [begin, end).  This gets called by several
+     * threads at a time, each with a different range.
+     */
+    virtual void Run(unsigned begin, unsigned end) = 0;
+  };
+
+private:
+  class Worker : protected StandbyThread {
+    Job *job;
+    unsigned begin, end;
+
+    /**
+     * Has the thread processed the current band?
+     */
+    bool done;
+
+  public:
+    void Start(Job &job, unsigned begin, unsigned end);
+
+    /**
+     * Wait until the thread has processed its band.  If the thread
+     * could not be launched, the band is processed by the calling
+     * thread.
+     */
+    void Wait();
+
+    void Stop();
+
+  protected:
+    virtual void Tick();
+  };
+
+  Worker workers[MAX_WORKERS];
+
+  unsigned n_workers;
+
+public:
+  /**
+   * @param n_workers the number of worker threads (in addition to the
+   * calling thread); 0 disables multi-threading
+   */
+  explicit ThreadPool(unsigned n_workers=0);
+
+  ~ThreadPool();
+
+  /**
+   * Returns the default number of worker threads: one less than the
+   * number of CPU cores, because the calling thread does its share
+   * of the work.
+   */
+  static unsigned GetDefaultWorkerCount();
+
+  unsigned GetWorkerCount() const {
+    return n_workers;
+  }
+
+  /**
+   * Change the number of worker threads.  Threads which are not
+   * needed anymore are stopped.
+   */
+  void SetWorkerCount(unsigned n);
+
+  /**
+   * Split the range [begin, end) into bands, one for each thread,
+   * and run the job on them.  Returns after all bands have been
+   * processed.
+   */
+  void Run(Job &job, unsigned begin, unsigned end);
+};
+
+#endif
@@ -0,0 +1,117 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_TRIPLE_BUFFER_HPP
+#define XCSOAR_THREAD_TRIPLE_BUFFER_HPP
+
+#include "Util/NonCopyable.hpp"
+
+#include <atomic>
+
+/**
+ * Passes snapshots of an object from one producer thread to one
+ * consumer thread without locking.  The producer fills the "back"
+ * buffer and publishes it; the consumer picks up the most recently
+ * published buffer.  Neither side ever waits for the other; if the
+ * producer publishes faster than the consumer reads, intermediate
+ * snapshots are skipped.
+ *
+ * There may be only one producer thread and one consumer thread at a
+ * time.
+ */
+template<typename T>
+class TripleBuffer : private NonCopyable {
+  /**
+   * This bit is set in #middle when it contains a snapshot which
+   * has not been consumed yet.
+   */
+  static const unsigned FRESH = 0x4;
+
+  static const unsigned INDEX_MASK = 0x3;
+
+  T buffers[3];
+
+  /**
+   * The index of the buffer which is currently exchanged between the
+   * two threads, plus the #FRESH flag.
+   */
+  std::atomic<unsigned> middle;
+
+  /** the buffer owned by the producer */
+  unsigned back;
+
+  /** the buffer owned by the consumer */
+  unsigned front;
+
+public:
+  TripleBuffer():middle(1), back(0), front(2) {}
+
+  /**
+   * Returns the buffer which the producer may fill.  Its contents
+   * are undefined.
+   */
+  T &GetBack() {
+    return buffers[back];
+  }
+
+  /**
+   * Publish the back buffer to the consumer.  Called by the
+   * producer.
+   */
+  void Publish() {
+    back = middle.exchange(back | FRESH) & INDEX_MASK;
+  }
+
+  /**
+   * Publish a copy of the specified object.  Called by the producer.
+   */
+  void Publish(const T &value) {
+    GetBack() = value;
+    Publish();
+  }
+
+  /**
+   * Pick up the most recently published snapshot.  Called by the
+   * consumer.
+   *
+   * @return true if a new snapshot is available via GetFront(),
+   * false if nothing has been published since the last call
+   */
+  bool Consume() {
+    if ((middle.load() & FRESH) == 0)
+      return false;
+
+    front = middle.exchange(front) & INDEX_MASK;
+    return true;
+  }
+
+  /**
+   * Returns the snapshot obtained by the last successful Consume()
+   * call.
+   */
+  const T &GetFront() const {
+    return buffers[front];
+  }
+};
+
+#endif
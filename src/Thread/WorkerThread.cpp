@@ -27,7 +27,8 @@ Copyright_License {
 
 WorkerThread::WorkerThread(unsigned _period_min, unsigned _idle_min,
                            unsigned _delay)
-  :period_min(_period_min), idle_min(_idle_min), delay(_delay) {
+  :period_min(_period_min), idle_min(_idle_min), delay(_delay),
+   throttle(true) {
 }
 
 void
@@ -39,6 +40,11 @@ WorkerThread::Run()
     /* wait for work */
     event_trigger.Wait();
 
+    const bool throttled = throttle;
+    const unsigned period_min = throttled ? this->period_min : 0;
+    const unsigned idle_min = throttled ? this->idle_min : 0;
+    const unsigned delay = throttled ? this->delay : 0;
+
     /* got the "stop" trigger? */
     if (delay > 0
         ? WaitForStopped(delay)
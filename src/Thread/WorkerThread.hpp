@@ -27,6 +27,8 @@ Copyright_License {
 #include "Thread/SuspensibleThread.hpp"
 #include "Thread/Trigger.hpp"
 
+#include <atomic>
+
 /**
  * A thread which performs regular work in background.
  */
@@ -35,6 +37,13 @@ class WorkerThread : public SuspensibleThread {
 
   unsigned period_min, idle_min, delay;
 
+  /**
+   * If false, then #period_min, #idle_min and #delay are ignored.
+   * See SetThrottle().  It is written by other threads, and read by
+   * this one.
+   */
+  std::atomic<bool> throttle;
+
 public:
   /**
    * @param period_min the minimum duration of one period [ms].  If
@@ -49,6 +58,16 @@ public:
   WorkerThread(unsigned period_min=0, unsigned idle_min=0,
                unsigned delay=0);
 
+  /**
+   * Enable or disable the rate-limiting parameters passed to the
+   * constructor.  Disabling them lets the thread run as fast as it
+   * gets triggered, e.g. during a time warp replay.  The new value
+   * takes effect at the next iteration.
+   */
+  void SetThrottle(bool _throttle) {
+    throttle = _throttle;
+  }
+
   /**
    * Wakes up the thread to do work, calls tick().
    */
@@ -0,0 +1,212 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Topography/ShapeIndex.hpp"
+#include "Util/STRTree.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+
+void
+ShapeIndex::Rectangle::Merge(const Rectangle &other)
+{
+  west = std::min(west, other.west);
+  south = std::min(south, other.south);
+  east = std::max(east, other.east);
+  north = std::max(north, other.north);
+}
+
+ShapeIndex::Rectangle
+ShapeIndex::Rectangle::FromDegrees(double west, double south,
+                                   double east, double north)
+{
+  Rectangle r;
+  r.west = (int32_t)floor(west * UNITS_PER_DEGREE);
+  r.south = (int32_t)floor(south * UNITS_PER_DEGREE);
+  r.east = (int32_t)ceil(east * UNITS_PER_DEGREE);
+  r.north = (int32_t)ceil(north * UNITS_PER_DEGREE);
+  return r;
+}
+
+/**
+ * Twice the horizontal center of the rectangle.
+ */
+gcc_pure
+static int64_t
+CenterX(const ShapeIndex::Rectangle &r)
+{
+  return (int64_t)r.west + r.east;
+}
+
+gcc_pure
+static int64_t
+CenterY(const ShapeIndex::Rectangle &r)
+{
+  return (int64_t)r.south + r.north;
+}
+
+struct CompareCenterX {
+  bool operator()(const ShapeIndex::Rectangle &a,
+                  const ShapeIndex::Rectangle &b) const {
+    return CenterX(a) < CenterX(b);
+  }
+};
+
+struct CompareCenterY {
+  bool operator()(const ShapeIndex::Rectangle &a,
+                  const ShapeIndex::Rectangle &b) const {
+    return CenterY(a) < CenterY(b);
+  }
+};
+
+void
+ShapeIndex::Add(unsigned shape, const Rectangle &bounds)
+{
+  assert(shape < n_shapes);
+
+  entries.push_back(Entry(bounds, shape));
+  nodes.clear();
+}
+
+void
+ShapeIndex::Build()
+{
+  n_leaves = STRTreeBuilder<Node, CompareCenterX, CompareCenterY, NODE_SIZE>
+    ::Build(entries.begin(), entries.end(), nodes);
+}
+
+void
+ShapeIndex::Query(unsigned index, const Rectangle &rectangle,
+                  std::vector<unsigned> &dest) const
+{
+  const Node &node = nodes[index];
+  if (!node.Overlaps(rectangle))
+    return;
+
+  const unsigned end = node.first + node.count;
+  if (index < n_leaves) {
+    for (unsigned i = node.first; i < end; ++i)
+      if (entries[i].Overlaps(rectangle))
+        dest.push_back(entries[i].shape);
+  } else {
+    for (unsigned i = node.first; i < end; ++i)
+      Query(i, rectangle, dest);
+  }
+}
+
+void
+ShapeIndex::Query(const Rectangle &rectangle,
+                  std::vector<unsigned> &dest) const
+{
+  assert(nodes.empty() == entries.empty());
+
+  dest.clear();
+
+  if (nodes.empty())
+    return;
+
+  Query(nodes.size() - 1, rectangle, dest);
+  std::sort(dest.begin(), dest.end());
+}
+
+struct ShapeIndexHeader {
+  static const uint32_t MAGIC = 0x58444e49;
+
+  /**
+   * Increment this when the format changes.
+   */
+  static const uint32_t VERSION = 1;
+
+  uint32_t magic, version;
+
+  uint32_t n_shapes, n_entries, n_nodes, n_leaves;
+};
+
+bool
+ShapeIndex::Save(FILE *file) const
+{
+  assert(nodes.empty() == entries.empty());
+
+  ShapeIndexHeader header;
+  header.magic = ShapeIndexHeader::MAGIC;
+  header.version = ShapeIndexHeader::VERSION;
+  header.n_shapes = n_shapes;
+  header.n_entries = entries.size();
+  header.n_nodes = nodes.size();
+  header.n_leaves = n_leaves;
+
+  return fwrite(&header, sizeof(header), 1, file) == 1 &&
+    (entries.empty() ||
+     fwrite(&entries.front(), sizeof(entries.front()), entries.size(),
+            file) == entries.size()) &&
+    (nodes.empty() ||
+     fwrite(&nodes.front(), sizeof(nodes.front()), nodes.size(),
+            file) == nodes.size());
+}
+
+bool
+ShapeIndex::Load(FILE *file, unsigned _n_shapes)
+{
+  Clear(_n_shapes);
+
+  ShapeIndexHeader header;
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      header.magic != ShapeIndexHeader::MAGIC ||
+      header.version != ShapeIndexHeader::VERSION ||
+      header.n_shapes != _n_shapes ||
+      header.n_entries > _n_shapes ||
+      header.n_nodes > header.n_entries ||
+      header.n_leaves > header.n_nodes ||
+      (header.n_entries > 0) != (header.n_leaves > 0))
+    return false;
+
+  entries.resize(header.n_entries);
+  nodes.resize(header.n_nodes);
+  n_leaves = header.n_leaves;
+
+  bool valid = (entries.empty() ||
+                fread(&entries.front(), sizeof(entries.front()),
+                      entries.size(), file) == entries.size()) &&
+    (nodes.empty() ||
+     fread(&nodes.front(), sizeof(nodes.front()), nodes.size(),
+           file) == nodes.size());
+
+  for (auto i = entries.begin(), end = entries.end(); valid && i != end; ++i)
+    valid = i->shape < n_shapes;
+
+  /* check the references, so a corrupt file cannot make Query() read
+     out of bounds: leaf nodes refer to entries, the others to nodes
+     of a lower level, i.e. with a smaller index */
+  for (unsigned i = 0, n = nodes.size(); valid && i < n; ++i) {
+    const Node &node = nodes[i];
+    const unsigned limit = i < n_leaves ? entries.size() : i;
+    valid = node.count > 0 && node.first < limit &&
+      node.count <= limit - node.first;
+  }
+
+  if (!valid)
+    Clear(_n_shapes);
+
+  return valid;
+}
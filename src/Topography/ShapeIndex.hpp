@@ -0,0 +1,170 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TOPOGRAPHY_SHAPE_INDEX_HPP
+#define XCSOAR_TOPOGRAPHY_SHAPE_INDEX_HPP
+
+#include "Compiler.h"
+
+#include <vector>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * A spatial index of the shapes of one shapefile: a static R-tree
+ * over the bounding boxes of the shapes, bulk loaded with
+ * #STRTreeBuilder (like #FlatRTree).  Once it is built,
+ * finding the shapes within the screen does not touch the shapefile
+ * at all.
+ *
+ * The coordinates are degrees in fixed point, rounded outwards, so
+ * a query never misses a shape, but may return one which is at most
+ * #UNITS_PER_DEGREE away from the query rectangle.
+ *
+ * The index can be stored with Save() and loaded with Load(), so the
+ * bounds of all shapes need to be read from the shapefile only once.
+ * The format depends on the byte order and is meant to be used with
+ * #FileCache only.
+ */
+class ShapeIndex {
+public:
+  static const int UNITS_PER_DEGREE = 1 << 22;
+
+  struct Rectangle {
+    int32_t west, south, east, north;
+
+    gcc_pure
+    bool Overlaps(const Rectangle &other) const {
+      return west <= other.east && east >= other.west &&
+        south <= other.north && north >= other.south;
+    }
+
+    void Merge(const Rectangle &other);
+
+    /**
+     * Convert a rectangle in degrees, rounding outwards.
+     */
+    gcc_const
+    static Rectangle FromDegrees(double west, double south,
+                                 double east, double north);
+  };
+
+private:
+  static const unsigned NODE_SIZE = 16;
+
+  struct Entry : public Rectangle {
+    uint32_t shape;
+
+    Entry() = default;
+    Entry(const Rectangle &bounds, unsigned _shape)
+      :Rectangle(bounds), shape(_shape) {}
+  };
+
+  /**
+   * It covers the entries [first, first + count) of #entries if it is
+   * a leaf node, and of #nodes otherwise.
+   */
+  struct Node : public Rectangle {
+    uint32_t first, count;
+
+    Node() = default;
+    Node(const Rectangle &bounds, unsigned _first)
+      :Rectangle(bounds), first(_first), count(1) {}
+  };
+
+  /**
+   * The number of shapes in the shapefile.  Shapes without bounds
+   * (null shapes) are not in the index.
+   */
+  unsigned n_shapes;
+
+  std::vector<Entry> entries;
+
+  /**
+   * All nodes of the tree, level by level.  The leaf nodes come
+   * first, and the last one is the root.
+   */
+  std::vector<Node> nodes;
+
+  /**
+   * The number of leaf nodes at the beginning of #nodes.
+   */
+  unsigned n_leaves;
+
+public:
+  ShapeIndex():n_shapes(0), n_leaves(0) {}
+
+  unsigned GetShapeCount() const {
+    return n_shapes;
+  }
+
+  /**
+   * Returns the number of indexed shapes.
+   */
+  unsigned size() const {
+    return entries.size();
+  }
+
+  void Clear(unsigned _n_shapes=0) {
+    n_shapes = _n_shapes;
+    entries.clear();
+    nodes.clear();
+    n_leaves = 0;
+  }
+
+  /**
+   * Add a shape.  Call Build() after all shapes have been added.
+   */
+  void Add(unsigned shape, const Rectangle &bounds);
+
+  /**
+   * Build the tree from the shapes which have been added.
+   */
+  void Build();
+
+  /**
+   * Find the shapes whose bounding box overlaps the specified one.
+   *
+   * @param dest the shape numbers are stored here, in ascending order
+   */
+  void Query(const Rectangle &rectangle, std::vector<unsigned> &dest) const;
+
+  /**
+   * @return false on I/O error
+   */
+  bool Save(FILE *file) const;
+
+  /**
+   * Load a file written by Save().  The index is cleared if the file
+   * is malformed or was built for a different number of shapes.
+   *
+   * @param n_shapes the number of shapes in the shapefile
+   */
+  bool Load(FILE *file, unsigned n_shapes);
+
+private:
+  void Query(unsigned node, const Rectangle &rectangle,
+             std::vector<unsigned> &dest) const;
+};
+
+#endif
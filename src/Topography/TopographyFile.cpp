@@ -24,6 +24,7 @@ Copyright_License {
 #include "Topography/TopographyFile.hpp"
 #include "Topography/XShape.hpp"
 #include "Projection/WindowProjection.hpp"
+#include "IO/FileCache.hpp"
 
 #include <zzip/lib.h>
 
@@ -31,13 +32,15 @@ Copyright_License {
 #include <stdlib.h>
 
 TopographyFile::TopographyFile(struct zzip_dir *_dir, const char *filename,
+                               FileCache *cache, const TCHAR *cache_name,
+                               const TCHAR *original_path,
                                fixed _threshold,
                                fixed _label_threshold,
                                fixed _important_label_threshold,
                                const Color thecolor,
                                int _label_field, int _icon,
                                int _pen_width)
-  :dir(_dir), first(NULL),
+  :dir(_dir), first(NULL), lru(ListHead::empty()), n_loaded(0),
    label_field(_label_field), icon(_icon),
    pen_width(_pen_width),
    color(thecolor), scale_threshold(_threshold),
@@ -55,6 +58,8 @@ TopographyFile::TopographyFile(struct zzip_dir *_dir, const char *filename,
   shapes.ResizeDiscard(file.numshapes);
   std::fill(shapes.begin(), shapes.end(), ShapeList(NULL));
 
+  LoadIndex(cache, cache_name, original_path);
+
   if (dir != NULL)
     ++dir->refcount;
 
@@ -78,27 +83,74 @@ TopographyFile::~TopographyFile()
   }
 }
 
+void
+TopographyFile::BuildIndex()
+{
+  index.Clear(file.numshapes);
+
+  for (int i = 0; i < file.numshapes; ++i) {
+    rectObj bounds;
+    if (msSHPReadBounds(file.hSHP, i, &bounds) == MS_SUCCESS)
+      index.Add(i, ShapeIndex::Rectangle::FromDegrees(bounds.minx,
+                                                      bounds.miny,
+                                                      bounds.maxx,
+                                                      bounds.maxy));
+  }
+
+  index.Build();
+}
+
+void
+TopographyFile::LoadIndex(FileCache *cache, const TCHAR *cache_name,
+                          const TCHAR *original_path)
+{
+  if (cache != NULL) {
+    /* load the cache file */
+    FILE *cache_file = cache->Load(cache_name, original_path);
+    if (cache_file != NULL) {
+      bool cache_loaded = index.Load(cache_file, file.numshapes);
+      fclose(cache_file);
+      if (cache_loaded)
+        return;
+    }
+  }
+
+  BuildIndex();
+
+  if (cache != NULL) {
+    /* save the cache file */
+    FILE *cache_file = cache->Save(cache_name, original_path);
+    if (cache_file != NULL) {
+      if (index.Save(cache_file))
+        cache->Commit(cache_name, cache_file);
+      else
+        cache->Cancel(cache_name, cache_file);
+    }
+  }
+}
+
 void
 TopographyFile::ClearCache()
 {
-  for (auto i = shapes.begin(), end = shapes.end(); i != end; ++i) {
-    delete i->shape;
-    i->shape = NULL;
+  while (!lru.IsEmpty()) {
+    ShapeList &item = *static_cast<ShapeList *>(lru.GetNext());
+    item.Remove();
+    delete item.shape;
+    item.shape = NULL;
   }
 
+  n_loaded = 0;
   first = NULL;
 }
 
 gcc_pure
-static rectObj
+static ShapeIndex::Rectangle
 ConvertRect(const GeoBounds &br)
 {
-  rectObj dest;
-  dest.minx = (double)br.west.Degrees();
-  dest.maxx = (double)br.east.Degrees();
-  dest.miny = (double)br.south.Degrees();
-  dest.maxy = (double)br.north.Degrees();
-  return dest;
+  return ShapeIndex::Rectangle::FromDegrees((double)br.west.Degrees(),
+                                            (double)br.south.Degrees(),
+                                            (double)br.east.Degrees(),
+                                            (double)br.north.Degrees());
 }
 
 bool
@@ -119,42 +171,58 @@ TopographyFile::Update(const WindowProjection &map_projection)
 
   cache_bounds = map_projection.GetScreenBounds().Scale(fixed_two);
 
-  rectObj deg_bounds = ConvertRect(cache_bounds);
-
-  // Test which shapes are inside the given bounds and save the
-  // status to file.status
-  msShapefileWhichShapes(&file, dir, deg_bounds, 0);
-
-  // If not a single shape is inside the bounds
-  if (!file.status) {
-    // ... clear the whole buffer
-    ClearCache();
-    return false;
-  }
+  // Find the shapes which are inside the given bounds
+  index.Query(ConvertRect(cache_bounds), visible);
+
+  // Decode the shapes which aren't cached yet.  This is the expensive
+  // part, and it is done without the lock, so the renderers can
+  // continue to use the current list meanwhile.
+  decoded.resize(visible.size());
+  for (unsigned i = 0, n = visible.size(); i < n; ++i)
+    decoded[i] = shapes[visible[i]].shape == NULL
+      ? new XShape(&file, visible[i], label_field)
+      : NULL;
+
+  {
+    Poco::ScopedRWLock protect(lock, true);
+
+    // Iterate through the visible shapes, in file order
+    const ShapeList **current = &first;
+    for (unsigned i = 0, n = visible.size(); i < n; ++i) {
+      ShapeList &item = shapes[visible[i]];
+      if (decoded[i] != NULL) {
+        // cache the new shape
+        item.shape = decoded[i];
+        item.InsertAfter(lru);
+        ++n_loaded;
+      } else
+        // mark it as recently used
+        item.MoveAfter(lru);
 
-  // Iterate through the shapefile entries
-  const ShapeList **current = &first;
-  auto it = shapes.begin();
-  for (int i = 0; i < file.numshapes; ++i, ++it) {
-    if (!msGetBit(file.status, i)) {
-      // If the shape is outside the bounds
-      // delete the shape from the cache
-      delete it->shape;
-      it->shape = NULL;
-    } else {
-      // is inside the bounds
-      if (it->shape == NULL)
-        // shape isn't cached yet -> cache the shape
-        it->shape = new XShape(&file, i, label_field);
       // update list pointer
-      *current = it;
-      current = &it->next;
+      *current = &item;
+      current = &item.next;
+    }
+    // end of list marker
+    *current = NULL;
+
+    // Remove the shapes which have been outside the bounds for the
+    // longest time; they are deleted after the lock is released
+    decoded.clear();
+    while (n_loaded > visible.size() + POOL_SIZE) {
+      ShapeList &item = *static_cast<ShapeList *>(lru.GetPrevious());
+      item.Remove();
+      decoded.push_back(item.shape);
+      item.shape = NULL;
+      --n_loaded;
     }
+
+    ++serial;
   }
-  // end of list marker
-  *current = NULL;
 
-  ++serial;
+  for (auto i = decoded.begin(), end = decoded.end(); i != end; ++i)
+    delete *i;
+
   return true;
 }
 
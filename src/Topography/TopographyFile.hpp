@@ -25,15 +25,20 @@ Copyright_License {
 #ifndef TOPOGRAPHY_HPP
 #define TOPOGRAPHY_HPP
 
+#include "ShapeIndex.hpp"
 #include "shapelib/mapserver.h"
 #include "Geo/GeoBounds.hpp"
 #include "Util/NonCopyable.hpp"
 #include "Util/AllocatedArray.hpp"
+#include "Util/ListHead.hpp"
 #include "Util/Serial.hpp"
+#include "Poco/RWLock.h"
 #include "Math/fixed.hpp"
 #include "Screen/Color.hpp"
 
+#include <vector>
 #include <assert.h>
+#include <tchar.h>
 
 struct GeoPoint;
 class Canvas;
@@ -42,10 +47,21 @@ struct GeoBounds;
 class LabelBlock;
 struct MapSettings;
 class XShape;
+class FileCache;
 struct zzip_dir;
 
+/**
+ * One layer of the vector topography, i.e. one shapefile.  The shapes
+ * near the screen are loaded by Update(), which may run in a separate
+ * thread (see #TopographyLoader).  Other threads which iterate over
+ * the shapes must hold a read lock on GetLock() while they use them.
+ */
 class TopographyFile : private NonCopyable {
-  struct ShapeList {
+  /**
+   * One slot per shape.  While the shape is loaded, the #ListHead
+   * base links it into #lru.
+   */
+  struct ShapeList : public ListHead {
     const ShapeList *next;
 
     const XShape *shape;
@@ -54,6 +70,12 @@ class TopographyFile : private NonCopyable {
     ShapeList(const XShape *_shape):shape(_shape) {}
   };
 
+  /**
+   * Protects #first, #serial and the loaded shapes.  Update() holds
+   * the write lock only while it publishes the new list.
+   */
+  mutable Poco::RWLock lock;
+
   /**
    * This gets incremented by Update().
    */
@@ -63,9 +85,37 @@ class TopographyFile : private NonCopyable {
 
   shapefileObj file;
 
+  /**
+   * The bounding boxes of all shapes.
+   */
+  ShapeIndex index;
+
   AllocatedArray<ShapeList> shapes;
+
+  /**
+   * The shapes inside #cache_bounds, linked with ShapeList::next.
+   */
   const ShapeList *first;
 
+  /**
+   * All loaded shapes, the ones which have been inside #cache_bounds
+   * most recently first.  Shapes which have left #cache_bounds are
+   * kept for a while, because the map is likely to return there; see
+   * #POOL_SIZE.
+   */
+  ListHead lru;
+
+  /**
+   * The number of loaded shapes (the length of #lru).
+   */
+  unsigned n_loaded;
+
+  /**
+   * Buffers for Update(), kept to avoid reallocating them each time.
+   */
+  std::vector<unsigned> visible;
+  std::vector<const XShape *> decoded;
+
   int label_field, icon, pen_width;
 
   Color color;
@@ -96,6 +146,11 @@ class TopographyFile : private NonCopyable {
   GeoBounds cache_bounds;
 
 public:
+  /**
+   * The maximum number of loaded shapes outside of #cache_bounds.
+   */
+  static const unsigned POOL_SIZE = 256;
+
   class const_iterator {
     friend class TopographyFile;
 
@@ -137,6 +192,10 @@ public:
   /**
    * The constructor opens the given shapefile and clears the cache
    * @param shpname The shapefile to open (*.shp)
+   * @param cache a cache for the spatial index; may be NULL
+   * @param cache_name the name of the cache file
+   * @param original_path the file which is checked to validate the
+   * cache file (the shapefile or the archive containing it)
    * @param threshold the zoom threshold for displaying this object
    * @param thecolor The color to use for drawing
    * @param label_field The field in which the labels should be searched
@@ -148,6 +207,8 @@ public:
    * @return
    */
   TopographyFile(struct zzip_dir *dir, const char *shpname,
+                 FileCache *cache, const TCHAR *cache_name,
+                 const TCHAR *original_path,
                  fixed threshold, fixed label_threshold,
                  fixed important_label_threshold,
                  const Color color,
@@ -159,6 +220,13 @@ public:
    */
   ~TopographyFile();
 
+  Poco::RWLock &GetLock() const {
+    return lock;
+  }
+
+  /**
+   * Caller must hold a read lock.
+   */
   const Serial &GetSerial() const {
     return serial;
   }
@@ -191,6 +259,9 @@ public:
     return pen_width;
   }
 
+  /**
+   * Caller must hold a read lock while iterating.
+   */
   const_iterator begin() const {
     return const_iterator(first);
   }
@@ -217,11 +288,23 @@ public:
 #endif
 
   /**
+   * Load the shapes near the screen and publish the new list.  Only
+   * one thread may call this method.
+   *
    * @return true if new data from the topography file has been loaded
    */
   bool Update(const WindowProjection &map_projection);
 
 protected:
+  /**
+   * Load the spatial index from the cache, or read the bounds of all
+   * shapes from the shapefile and store the index in the cache.
+   */
+  void LoadIndex(FileCache *cache, const TCHAR *cache_name,
+                 const TCHAR *original_path);
+
+  void BuildIndex();
+
   void ClearCache();
 };
 
@@ -136,6 +136,7 @@ TopographyFileRenderer::Paint(Canvas &canvas,
   if (!file.IsVisible(map_scale))
     return;
 
+  Poco::ScopedRWLock protect(file.GetLock(), false);
   UpdateVisibleShapes(projection);
 
   if (visible_shapes.empty())
@@ -339,6 +340,7 @@ TopographyFileRenderer::PaintLabels(Canvas &canvas,
   if (!file.IsVisible(map_scale) || !file.IsLabelVisible(map_scale))
     return;
 
+  Poco::ScopedRWLock protect(file.GetLock(), false);
   UpdateVisibleShapes(projection);
 
   if (visible_labels.empty())
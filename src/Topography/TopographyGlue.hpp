@@ -26,9 +26,14 @@ Copyright_License {
 
 class TopographyStore;
 class OperationEnvironment;
+class FileCache;
 
+/**
+ * @param cache a cache for the spatial indexes of the shapefiles;
+ * may be NULL
+ */
 bool
-LoadConfiguredTopography(TopographyStore &store,
+LoadConfiguredTopography(TopographyStore &store, FileCache *cache,
                          OperationEnvironment &operation);
 
 #endif
@@ -0,0 +1,85 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Topography/TopographyLoader.hpp"
+#include "Topography/TopographyStore.hpp"
+
+TopographyLoader::TopographyLoader(TopographyStore &_store)
+  :store(_store), defined(false), modified(false) {}
+
+void
+TopographyLoader::StopAsync()
+{
+  ScopeLock protect(mutex);
+  modified = false;
+  StandbyThread::StopAsync();
+}
+
+void
+TopographyLoader::WaitStopped()
+{
+  ScopeLock protect(mutex);
+  StandbyThread::WaitStopped();
+}
+
+gcc_pure
+static bool
+IsSameScreen(const WindowProjection &a, const WindowProjection &b)
+{
+  const GeoBounds &a_bounds = a.GetScreenBounds();
+  const GeoBounds &b_bounds = b.GetScreenBounds();
+  return a.GetMapScale() == b.GetMapScale() &&
+    a_bounds.IsInside(b_bounds) && b_bounds.IsInside(a_bounds);
+}
+
+void
+TopographyLoader::SetProjection(const WindowProjection &_projection)
+{
+  ScopeLock protect(mutex);
+
+  if (defined && IsSameScreen(projection, _projection))
+    return;
+
+  projection = _projection;
+  defined = true;
+
+  if (IsBusy())
+    /* Tick() will pick up the new projection when it's done */
+    modified = true;
+  else
+    Trigger();
+}
+
+void
+TopographyLoader::Tick()
+{
+  do {
+    modified = false;
+
+    const WindowProjection _projection = projection;
+
+    mutex.Unlock();
+    store.ScanVisibility(_projection);
+    mutex.Lock();
+  } while (modified && !IsStopped());
+}
@@ -0,0 +1,71 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TOPOGRAPHY_LOADER_HPP
+#define XCSOAR_TOPOGRAPHY_LOADER_HPP
+
+#include "Thread/StandbyThread.hpp"
+#include "Projection/WindowProjection.hpp"
+
+class TopographyStore;
+
+/**
+ * A thread which loads the topography shapes near the screen in
+ * background, so decoding the shapefiles does not delay drawing the
+ * map.  Each #TopographyFile publishes its new shape list with a new
+ * serial, which makes the renderers pick it up.
+ */
+class TopographyLoader : protected StandbyThread {
+  TopographyStore &store;
+
+  WindowProjection projection;
+
+  /**
+   * Has SetProjection() been called yet?
+   */
+  bool defined;
+
+  /**
+   * Has a new projection been submitted while the thread was busy?
+   */
+  bool modified;
+
+public:
+  TopographyLoader(TopographyStore &_store);
+
+  void StopAsync();
+  void WaitStopped();
+
+  /**
+   * Schedule an update for the specified projection, and return
+   * immediately.  If the thread is still busy, it picks up the new
+   * projection as soon as the current update is done.  Nothing is
+   * scheduled if the screen has not changed since the last call.
+   */
+  void SetProjection(const WindowProjection &projection);
+
+protected:
+  virtual void Tick();
+};
+
+#endif
@@ -70,7 +70,8 @@ TopographyStore::~TopographyStore()
 
 void
 TopographyStore::Load(OperationEnvironment &operation, NLineReader &reader,
-                      const TCHAR *directory, struct zzip_dir *zdir)
+                      const TCHAR *directory, struct zzip_dir *zdir,
+                      FileCache *cache, const TCHAR *archive)
 {
   Reset();
 
@@ -173,8 +174,22 @@ TopographyStore::Load(OperationEnvironment &operation, NLineReader &reader,
     if (*p == _T(','))
       labelImportantRange = fixed(strtod(p + 1, &p)) * 1000;
 
+    // The spatial index of each shapefile is cached; it is validated
+    // with the shapefile or with the archive containing it
+    char narrow_cache_name[MAX_PATH + 16];
+    strcpy(narrow_cache_name, "topography_");
+    strcat(narrow_cache_name, shape_filename_end);
+
+    const PathName cache_name(narrow_cache_name);
+    const PathName shape_path(shape_filename);
+    const TCHAR *original_path =
+      zdir != NULL ? archive : (const TCHAR *)shape_path;
+
     // Create TopographyFile instance from parsed line
     TopographyFile *file = new TopographyFile(zdir, shape_filename,
+                                              original_path != NULL
+                                              ? cache : NULL,
+                                              cache_name, original_path,
                                               shape_range, label_range,
                                               labelImportantRange,
                                               Color(red, green, blue),
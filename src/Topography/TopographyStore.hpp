@@ -33,6 +33,7 @@ class WindowProjection;
 class TopographyFile;
 class NLineReader;
 class OperationEnvironment;
+class FileCache;
 struct zzip_dir;
 
 /**
@@ -67,8 +68,15 @@ public:
   unsigned ScanVisibility(const WindowProjection &m_projection,
                           unsigned max_update=1024);
 
+  /**
+   * @param cache a cache for the spatial indexes of the shapefiles;
+   * may be NULL
+   * @param archive the path of the ZIP file #zdir was opened from;
+   * required for the cache
+   */
   void Load(OperationEnvironment &operation, NLineReader &reader,
-            const TCHAR *directory, struct zzip_dir *zdir = NULL);
+            const TCHAR *directory, struct zzip_dir *zdir = NULL,
+            FileCache *cache = NULL, const TCHAR *archive = NULL);
   void Reset();
 };
 
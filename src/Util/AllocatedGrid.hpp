@@ -129,6 +129,16 @@ public:
     array.ResizeDiscard(0);
   }
 
+  /**
+   * Exchange the contents of this grid with another one, without
+   * copying the elements.
+   */
+  void Swap(AllocatedGrid &other) {
+    array.Swap(other.array);
+    std::swap(width, other.width);
+    std::swap(height, other.height);
+  }
+
   void GrowDiscard(unsigned _width, unsigned _height) {
     array.GrowDiscard(_width * _height);
     width = _width;
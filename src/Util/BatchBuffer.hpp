@@ -82,6 +82,11 @@ public:
   void Clear() {
     tail = 0;
   }
+
+  void Swap(BatchBuffer<T,size> &other) {
+    std::swap(data, other.data);
+    std::swap(tail, other.tail);
+  }
 };
 
 #endif
@@ -0,0 +1,133 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_UTIL_STR_TREE_HPP
+#define XCSOAR_UTIL_STR_TREE_HPP
+
+#include <vector>
+#include <algorithm>
+#include <math.h>
+
+/**
+ * Bulk loads a static R-tree with the sort-tile-recursive (STR)
+ * algorithm: each level is sorted into vertical slices by the
+ * horizontal center, each slice by the vertical center, and runs of
+ * #NODE_SIZE entries are packed into one node of the next level.
+ * This is shared by all static R-trees, which differ only in their
+ * bounding box type.
+ *
+ * The nodes are stored level by level: the leaf nodes come first,
+ * and the last one is the root.  A node covers the entries
+ * [first, first + count) of the value array if it is a leaf node,
+ * and of the node array otherwise.
+ *
+ * @param Node the node type; it must be constructible from a value's
+ * bounding box and the index of its first child, and have a Merge()
+ * method and a "count" attribute
+ * @param CompareX orders bounding boxes by their horizontal center
+ * @param CompareY orders bounding boxes by their vertical center
+ */
+template<typename Node, typename CompareX, typename CompareY,
+         unsigned NODE_SIZE>
+class STRTreeBuilder {
+public:
+  /**
+   * Sort the values into STR order and build all nodes.
+   *
+   * @param begin a random access iterator to the values, which are
+   * reordered
+   * @param nodes the destination; it is cleared first
+   * @return the number of leaf nodes
+   */
+  template<typename I>
+  static unsigned Build(I begin, I end, std::vector<Node> &nodes) {
+    nodes.clear();
+
+    const unsigned n_values = end - begin;
+    if (n_values == 0)
+      return 0;
+
+    nodes.reserve(n_values / (NODE_SIZE - 1) + 2 * NODE_SIZE);
+
+    Pack(begin, end);
+    AddParents(begin, 0, n_values, nodes);
+    const unsigned n_leaves = nodes.size();
+
+    /* each level's parents are collected in a separate vector and
+       appended afterwards, because #nodes must not grow while it is
+       being read */
+    std::vector<Node> parents;
+    unsigned level_begin = 0;
+    while (nodes.size() - level_begin > 1) {
+      const unsigned level_end = nodes.size();
+      Pack(nodes.begin() + level_begin, nodes.begin() + level_end);
+
+      parents.clear();
+      AddParents(nodes.begin() + level_begin, level_begin,
+                 level_end - level_begin, parents);
+      nodes.insert(nodes.end(), parents.begin(), parents.end());
+
+      level_begin = level_end;
+    }
+
+    return n_leaves;
+  }
+
+private:
+  /**
+   * Sort the range into STR order.
+   */
+  template<typename I>
+  static void Pack(I begin, I end) {
+    const unsigned n = end - begin;
+    const unsigned n_parents = (n + NODE_SIZE - 1) / NODE_SIZE;
+    const unsigned n_slices = (unsigned)ceil(sqrt((double)n_parents));
+    const unsigned slice_size = n_slices * NODE_SIZE;
+
+    std::sort(begin, end, CompareX());
+
+    for (unsigned i = 0; i < n; i += slice_size)
+      std::sort(begin + i, begin + std::min(i + slice_size, n),
+                CompareY());
+  }
+
+  /**
+   * Append one node to #dest for every #NODE_SIZE entries of the
+   * specified range, which starts at the given index.  The range must
+   * not be part of #dest.
+   */
+  template<typename I>
+  static void AddParents(I begin, unsigned first, unsigned n,
+                         std::vector<Node> &dest) {
+    for (unsigned i = 0; i < n; ++i) {
+      if (i % NODE_SIZE == 0) {
+        dest.push_back(Node(begin[i], first + i));
+      } else {
+        dest.back().Merge(begin[i]);
+        ++dest.back().count;
+      }
+    }
+  }
+};
+
+#endif
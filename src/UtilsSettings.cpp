@@ -134,7 +134,7 @@ SettingsLeave(const UISettings &old_ui_settings)
 
   if (WaypointFileChanged || AirfieldFileChanged) {
     // re-load waypoints
-    WaypointGlue::LoadWaypoints(way_points, terrain, operation);
+    WaypointGlue::LoadWaypoints(way_points, terrain, file_cache, operation);
     WaypointDetails::ReadFileFromProfile(way_points, operation);
   }
 
@@ -164,7 +164,7 @@ SettingsLeave(const UISettings &old_ui_settings)
   if (TopographyFileChanged) {
     main_window.SetTopography(NULL);
     topography->Reset();
-    LoadConfiguredTopography(*topography, operation);
+    LoadConfiguredTopography(*topography, file_cache, operation);
     main_window.SetTopography(topography);
   }
 
@@ -178,7 +178,7 @@ SettingsLeave(const UISettings &old_ui_settings)
     airspace_database.clear();
     ReadAirspace(airspace_database, terrain,
                  CommonInterface::GetComputerSettings().pressure,
-                 operation);
+                 file_cache, operation);
   }
 
   if (DevicePortChanged)
@@ -0,0 +1,268 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Waypoint/WaypointCache.hpp"
+#include "Waypoint/Waypoints.hpp"
+#include "IO/BinaryCache.hpp"
+
+#include <algorithm>
+#include <vector>
+
+struct WaypointCacheHeader {
+  static const uint32_t MAGIC = 0x43505457;
+
+  /**
+   * Increment this when the format or the readers' output changes.
+   */
+  static const uint32_t VERSION = 1;
+
+  uint32_t magic, version;
+
+  /**
+   * The sizes of the types which are stored in their native layout;
+   * a mismatch means the file was written by a different build.
+   */
+  uint8_t tchar_size, fixed_size, geo_point_size, flags_size;
+
+  /**
+   * The length of the original path (in characters), which follows
+   * the header.
+   */
+  uint32_t path_length;
+
+  uint32_t n_waypoints;
+
+  uint64_t terrain_stamp;
+
+  void Init() {
+    magic = MAGIC;
+    version = VERSION;
+    tchar_size = sizeof(TCHAR);
+    fixed_size = sizeof(fixed);
+    geo_point_size = sizeof(GeoPoint);
+    flags_size = sizeof(Waypoint::Flags);
+  }
+
+  bool IsValid() const {
+    return magic == MAGIC && version == VERSION &&
+      tchar_size == sizeof(TCHAR) && fixed_size == sizeof(fixed) &&
+      geo_point_size == sizeof(GeoPoint) &&
+      flags_size == sizeof(Waypoint::Flags);
+  }
+};
+
+/**
+ * One waypoint.  It is followed by the name, comment and details, and
+ * then by the embedded and external file names, each one prefixed
+ * with its length as uint16_t.
+ */
+struct WaypointCacheRecord {
+  uint32_t original_id;
+
+  GeoPoint location;
+  fixed elevation;
+
+  Runway runway;
+  RadioFrequency radio_frequency;
+
+  uint8_t type;
+  Waypoint::Flags flags;
+  int8_t file_num;
+
+  uint16_t name_length, comment_length, details_length;
+  uint16_t n_files_embed, n_files_external;
+};
+
+static bool
+WriteFileList(FILE *file, const std::forward_list<tstring> &list)
+{
+  for (auto i = list.begin(), end = list.end(); i != end; ++i) {
+    const uint16_t length = i->length();
+    if (!WriteCacheData(file, &length, sizeof(length)) ||
+        !WriteCacheString(file, *i))
+      return false;
+  }
+
+  return true;
+}
+
+static bool
+SaveWaypoint(FILE *file, const Waypoint &wp)
+{
+  if (wp.name.length() > 0xffff || wp.comment.length() > 0xffff ||
+      wp.details.length() > 0xffff)
+    return false;
+
+  /* value-initialise to zero the padding bytes, too, so the file
+     contents are reproducible */
+  WaypointCacheRecord record = WaypointCacheRecord();
+  record.original_id = wp.original_id;
+  record.location = wp.location;
+  record.elevation = wp.elevation;
+  record.runway = wp.runway;
+  record.radio_frequency = wp.radio_frequency;
+  record.type = (uint8_t)wp.type;
+  record.flags = wp.flags;
+  record.file_num = wp.file_num;
+  record.name_length = wp.name.length();
+  record.comment_length = wp.comment.length();
+  record.details_length = wp.details.length();
+  record.n_files_embed = std::distance(wp.files_embed.begin(),
+                                       wp.files_embed.end());
+#ifdef ANDROID
+  record.n_files_external = std::distance(wp.files_external.begin(),
+                                          wp.files_external.end());
+#endif
+
+  return WriteCacheData(file, &record, sizeof(record)) &&
+    WriteCacheString(file, wp.name) && WriteCacheString(file, wp.comment) &&
+    WriteCacheString(file, wp.details) &&
+    WriteFileList(file, wp.files_embed)
+#ifdef ANDROID
+    && WriteFileList(file, wp.files_external)
+#endif
+    ;
+}
+
+static bool
+CompareId(const Waypoint *a, const Waypoint *b)
+{
+  return a->id < b->id;
+}
+
+bool
+WaypointCache::Save(FILE *file, const TCHAR *original_path,
+                    uint64_t terrain_stamp,
+                    const Waypoints &way_points, int file_num)
+{
+  /* the tree is not ordered; restore the order of the file to keep
+     the ids stable */
+  std::vector<const Waypoint *> list;
+  for (auto i = way_points.begin(), end = way_points.end(); i != end; ++i)
+    if (i->file_num == file_num)
+      list.push_back(&*i);
+
+  std::sort(list.begin(), list.end(), CompareId);
+
+  WaypointCacheHeader header;
+  header.Init();
+  header.path_length = _tcslen(original_path);
+  header.n_waypoints = list.size();
+  header.terrain_stamp = terrain_stamp;
+
+  if (!WriteCacheData(file, &header, sizeof(header)) ||
+      !WriteCacheData(file, original_path, header.path_length * sizeof(TCHAR)))
+    return false;
+
+  for (auto i = list.begin(), end = list.end(); i != end; ++i)
+    if (!SaveWaypoint(file, **i))
+      return false;
+
+  return true;
+}
+
+static bool
+ReadFileList(CacheReader &reader, std::forward_list<tstring> &list,
+             unsigned n)
+{
+  auto position = list.before_begin();
+  for (unsigned i = 0; i < n; ++i) {
+    uint16_t length;
+    tstring value;
+    if (!reader.Read(length) || !reader.ReadString(value, length))
+      return false;
+
+    position = list.insert_after(position, value);
+  }
+
+  return true;
+}
+
+static bool
+LoadWaypoint(CacheReader &reader, std::vector<Waypoint> &dest)
+{
+  WaypointCacheRecord record;
+  if (!reader.Read(record) ||
+      record.type > (uint8_t)Waypoint::Type::OBSTACLE)
+    return false;
+
+  dest.push_back(Waypoint(record.location));
+  Waypoint &wp = dest.back();
+  wp.original_id = record.original_id;
+  wp.elevation = record.elevation;
+  wp.runway = record.runway;
+  wp.radio_frequency = record.radio_frequency;
+  wp.type = (Waypoint::Type)record.type;
+  wp.flags = record.flags;
+  wp.file_num = record.file_num;
+
+  if (!reader.ReadString(wp.name, record.name_length) ||
+      !reader.ReadString(wp.comment, record.comment_length) ||
+      !reader.ReadString(wp.details, record.details_length) ||
+      !ReadFileList(reader, wp.files_embed, record.n_files_embed))
+    return false;
+
+#ifdef ANDROID
+  if (!ReadFileList(reader, wp.files_external, record.n_files_external))
+    return false;
+#else
+  /* skip the external files written by an Android build */
+  std::forward_list<tstring> files_external;
+  if (!ReadFileList(reader, files_external, record.n_files_external))
+    return false;
+#endif
+
+  return true;
+}
+
+bool
+WaypointCache::Load(FILE *file, const TCHAR *original_path,
+                    uint64_t terrain_stamp, Waypoints &way_points)
+{
+  CacheReader reader;
+  if (!reader.Load(file))
+    return false;
+
+  WaypointCacheHeader header;
+  tstring path;
+  if (!reader.Read(header) || !header.IsValid() ||
+      header.terrain_stamp != terrain_stamp ||
+      !reader.ReadString(path, header.path_length) ||
+      path != original_path)
+    return false;
+
+  std::vector<Waypoint> loaded;
+  loaded.reserve(header.n_waypoints);
+
+  for (unsigned i = 0; i < header.n_waypoints; ++i)
+    if (!LoadWaypoint(reader, loaded))
+      return false;
+
+  if (!reader.IsEnd())
+    return false;
+
+  for (auto i = loaded.begin(), end = loaded.end(); i != end; ++i)
+    way_points.Append(*i);
+
+  return true;
+}
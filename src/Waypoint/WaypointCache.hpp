@@ -0,0 +1,68 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WAYPOINT_CACHE_HPP
+#define XCSOAR_WAYPOINT_CACHE_HPP
+
+#include <stdio.h>
+#include <stdint.h>
+#include <tchar.h>
+
+class Waypoints;
+
+/**
+ * Stores the waypoints parsed from one waypoint file in a binary
+ * file, to avoid parsing the file and looking up missing elevations
+ * on every startup.  The format depends on the build (character and
+ * number types), and is meant to be used with #FileCache only.
+ *
+ * The search trees are not stored; they are rebuilt by
+ * Waypoints::Append() and Waypoints::Optimise() while loading.
+ */
+namespace WaypointCache {
+  /**
+   * Write all waypoints of the specified file to the cache file, in
+   * the order they were added.
+   *
+   * @param original_path the path of the waypoint file; a cache file
+   * with a different path is not loaded
+   * @param terrain_stamp identifies the terrain which was used to
+   * look up missing elevations (0 if none); a cache file with a
+   * different value is not loaded
+   * @return false on I/O error
+   */
+  bool Save(FILE *file, const TCHAR *original_path, uint64_t terrain_stamp,
+            const Waypoints &way_points, int file_num);
+
+  /**
+   * Read a file written by Save() and append its waypoints.  Nothing
+   * is appended if the file is malformed.
+   *
+   * @return false if the file is malformed or does not match the
+   * waypoint file or the terrain
+   */
+  bool Load(FILE *file, const TCHAR *original_path, uint64_t terrain_stamp,
+            Waypoints &way_points);
+}
+
+#endif
@@ -38,6 +38,11 @@ Copyright_License {
 #include "OS/PathName.hpp"
 #include "Waypoint/WaypointWriter.hpp"
 #include "Operation/Operation.hpp"
+#include "IO/FileCache.hpp"
+#include "OS/FileUtil.hpp"
+#include "Waypoint/WaypointCache.hpp"
+
+#include <stdio.h>
 
 #include <windef.h> /* for MAX_PATH */
 
@@ -188,9 +193,76 @@ WaypointGlue::SaveHome(const ComputerSettings &settings)
                settings.team_code.team_code_reference_waypoint);
 }
 
+/**
+ * Returns a value which identifies the terrain used for looking up
+ * missing waypoint elevations: derived from the modification time of
+ * its source file (the same lookup as in RasterTerrain::OpenTerrain()),
+ * or 0 without terrain.
+ */
+static uint64_t
+GetTerrainStamp(const RasterTerrain *terrain)
+{
+  if (terrain == NULL)
+    return 0;
+
+  TCHAR path[MAX_PATH];
+  if (!Profile::GetPath(szProfileTerrainFile, path) &&
+      !Profile::GetPath(szProfileMapFile, path))
+    return 1;
+
+  return File::GetLastModification(path) + 1;
+}
+
+/**
+ * Load the waypoints of an opened waypoint file, preferably from the
+ * cache.  A parsed file is written to the cache.
+ */
+static bool
+ParseWaypointFile(WaypointReader &reader, int num, const TCHAR *path,
+                  Waypoints &way_points, const RasterTerrain *terrain,
+                  FileCache *cache, OperationEnvironment &operation)
+{
+  const uint64_t terrain_stamp = GetTerrainStamp(terrain);
+
+  TCHAR cache_name[32];
+  _stprintf(cache_name, _T("waypoints%d"), num);
+
+  if (cache != NULL) {
+    FILE *file = cache->Load(cache_name, path);
+    if (file != NULL) {
+      const bool loaded =
+        WaypointCache::Load(file, path, terrain_stamp, way_points);
+      fclose(file);
+
+      if (loaded)
+        return true;
+
+      LogStartUp(_T("Waypoint cache %d is invalid"), num);
+    }
+  }
+
+  reader.SetTerrain(terrain);
+  if (!reader.Parse(way_points, operation))
+    return false;
+
+  if (cache != NULL) {
+    /* save the cache file */
+    FILE *file = cache->Save(cache_name, path);
+    if (file != NULL) {
+      if (WaypointCache::Save(file, path, terrain_stamp, way_points, num))
+        cache->Commit(cache_name, file);
+      else
+        cache->Cancel(cache_name, file);
+    }
+  }
+
+  return true;
+}
+
 bool
 WaypointGlue::LoadWaypointFile(int num, Waypoints &way_points,
                                const RasterTerrain *terrain,
+                               FileCache *cache,
                                OperationEnvironment &operation)
 {
   // Get waypoint filename
@@ -203,9 +275,8 @@ WaypointGlue::LoadWaypointFile(int num, Waypoints &way_points,
   // If waypoint file exists
   if (!reader.Error()) {
     // parse the file
-    reader.SetTerrain(terrain);
-
-    if (reader.Parse(way_points, operation))
+    if (ParseWaypointFile(reader, num, path, way_points, terrain, cache,
+                          operation))
       return true;
 
     LogStartUp(_T("Parse error in waypoint file %d"), num);
@@ -220,6 +291,7 @@ bool
 WaypointGlue::LoadMapFileWaypoints(int num, const TCHAR* key,
                                    Waypoints &way_points,
                                    const RasterTerrain *terrain,
+                                   FileCache *cache,
                                    OperationEnvironment &operation)
 {
   TCHAR path[MAX_PATH];
@@ -245,8 +317,8 @@ WaypointGlue::LoadMapFileWaypoints(int num, const TCHAR* key,
   // If waypoint file inside map file exists
   if (!reader.Error()) {
     // parse the file
-    reader.SetTerrain(terrain);
-    if (reader.Parse(way_points, operation))
+    if (ParseWaypointFile(reader, num, path, way_points, terrain, cache,
+                          operation))
       return true;
 
     LogStartUp(_T("Parse error in map waypoint file"));
@@ -260,6 +332,7 @@ WaypointGlue::LoadMapFileWaypoints(int num, const TCHAR* key,
 bool
 WaypointGlue::LoadWaypoints(Waypoints &way_points,
                             const RasterTerrain *terrain,
+                            FileCache *cache,
                             OperationEnvironment &operation)
 {
   LogStartUp(_T("ReadWaypoints"));
@@ -271,20 +344,20 @@ WaypointGlue::LoadWaypoints(Waypoints &way_points,
   way_points.Clear();
 
   // ### FIRST FILE ###
-  found |= LoadWaypointFile(1, way_points, terrain, operation);
+  found |= LoadWaypointFile(1, way_points, terrain, cache, operation);
 
   // ### SECOND FILE ###
-  found |= LoadWaypointFile(2, way_points, terrain, operation);
+  found |= LoadWaypointFile(2, way_points, terrain, cache, operation);
 
   // ### WATCHED WAYPOINT/THIRD FILE ###
-  found |= LoadWaypointFile(3, way_points, terrain, operation);
+  found |= LoadWaypointFile(3, way_points, terrain, cache, operation);
 
   // ### MAP/FOURTH FILE ###
 
   // If no waypoint file found yet
   if (!found)
     found = LoadMapFileWaypoints(0, szProfileMapFile, way_points, terrain,
-                                 operation);
+                                 cache, operation);
 
   // Optimise the waypoint list after attaching new waypoints
   way_points.Optimise();
@@ -29,6 +29,7 @@ Copyright_License {
 struct Waypoint;
 class Waypoints;
 class RasterTerrain;
+class FileCache;
 class OperationEnvironment;
 struct ComputerSettings;
 struct PlacesOfInterestSettings;
@@ -97,15 +98,19 @@ namespace WaypointGlue {
    * specified waypoint list
    * @param way_points The waypoint list to fill
    * @param terrain RasterTerrain (for automatic waypoint height)
+   * @param cache an optional cache for the parsed waypoint files
    */
   bool LoadWaypoints(Waypoints &way_points,
                      const RasterTerrain *terrain,
+                     FileCache *cache,
                      OperationEnvironment &operation);
   bool LoadWaypointFile(int num, Waypoints &way_points,
                         const RasterTerrain *terrain,
+                        FileCache *cache,
                         OperationEnvironment &operation);
   bool LoadMapFileWaypoints(int num, const TCHAR* key,
                             Waypoints &way_points, const RasterTerrain *terrain,
+                            FileCache *cache,
                             OperationEnvironment &operation);
   bool SaveWaypoints(const Waypoints &way_points);
   bool SaveWaypointFile(const Waypoints &way_points, int num);
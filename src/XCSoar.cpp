@@ -51,6 +51,7 @@ static const char *Usage = "\n"
   "  -fly            bypass startup-screen, use fly mode directly\n"
 #endif
   "  -profile=fname  load profile from file fname\n"
+  "  -trace-latency  write fix latencies to latency.trace on exit\n"
 #if !defined(_WIN32_WCE)
   "  -WIDTHxHEIGHT   use screen resolution WIDTH x HEIGHT\n"
   "  -portrait       use a 480x640 screen resolution\n"
@@ -1,7 +1,7 @@
 #include "jasper/jpc_rtc.h"
-#include "Terrain/RasterTileCache.hpp"
+#include "Terrain/JasperHandler.hpp"
 
-RasterTileCache *raster_tile_current = 0;
+JasperHandler *raster_tile_current = 0;
 
 extern "C" {
 
@@ -0,0 +1,153 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Feeds recorded NMEA files through the line splitter, the device
+ * driver and the generic NMEA parser, and measures how long that
+ * takes.  The files can be created from IGC files with IGC2NMEA.
+ */
+
+#include "NMEA/Info.hpp"
+#include "NMEA/Sentence.hpp"
+#include "Device/Port/NullPort.hpp"
+#include "Device/Port/LineHandler.hpp"
+#include "Device/Driver.hpp"
+#include "Device/Register.hpp"
+#include "Device/Parser.hpp"
+#include "Profile/DeviceConfig.hpp"
+#include "OS/PathName.hpp"
+#include "OS/Clock.hpp"
+
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * The size of the chunks passed to PortLineHandler, similar to what a
+ * serial port delivers per read.
+ */
+static const size_t CHUNK_SIZE = 64;
+
+class BenchmarkLineHandler : public PortLineHandler {
+  Device *device;
+  NMEAParser parser;
+
+public:
+  NMEAInfo data;
+  unsigned n_lines, n_parsed;
+
+  BenchmarkLineHandler(Device *_device)
+    :device(_device), n_lines(0), n_parsed(0) {
+    data.Reset();
+    data.clock = fixed_one;
+  }
+
+  void Feed(const char *p, size_t length) {
+    while (length > 0) {
+      const size_t nbytes = std::min(length, CHUNK_SIZE);
+      DataReceived(p, nbytes);
+      p += nbytes;
+      length -= nbytes;
+    }
+  }
+
+protected:
+  virtual void SentenceReceived(const NMEASentence &sentence) {
+    ++n_lines;
+
+    if ((device != NULL && device->ParseSentence(sentence, data)) ||
+        parser.ParseLine(sentence, data))
+      ++n_parsed;
+  }
+};
+
+static bool
+LoadFile(const char *path, std::vector<char> &buffer)
+{
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    fprintf(stderr, "Failed to open %s\n", path);
+    return false;
+  }
+
+  char chunk[4096];
+  size_t nbytes;
+  while ((nbytes = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    buffer.insert(buffer.end(), chunk, chunk + nbytes);
+
+  fclose(file);
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 3) {
+    fprintf(stderr, "Usage: %s DRIVER FILE.nmea ...\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  PathName driver_name(argv[1]);
+  const struct DeviceRegister *driver = FindDriverByName(driver_name);
+  if (driver == NULL) {
+    fprintf(stderr, "No such driver: %s\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+
+  std::vector<char> input;
+  for (int i = 2; i < argc; ++i)
+    if (!LoadFile(argv[i], input))
+      return EXIT_FAILURE;
+
+  if (input.empty()) {
+    fprintf(stderr, "No input\n");
+    return EXIT_FAILURE;
+  }
+
+  DeviceConfig config;
+  config.Clear();
+
+  NullPort port;
+  Device *device = driver->CreateOnPort != NULL
+    ? driver->CreateOnPort(config, port)
+    : NULL;
+
+  BenchmarkLineHandler handler(device);
+
+  /* repeat until at least 16 MB have been parsed */
+  const unsigned iterations = std::max(1u, unsigned((16u << 20) / input.size()));
+
+  const uint64_t start = MonotonicClockUS();
+  for (unsigned i = 0; i < iterations; ++i)
+    handler.Feed(&input.front(), input.size());
+  const uint64_t duration = std::max(MonotonicClockUS() - start, uint64_t(1));
+
+  printf("%u lines (%u parsed) in %lu ms\n",
+         handler.n_lines, handler.n_parsed, (unsigned long)(duration / 1000));
+  printf("%.1f MB/s, %.0f ns per line\n",
+         (double)input.size() * iterations / duration,
+         duration * 1000. / handler.n_lines);
+
+  delete device;
+
+  return EXIT_SUCCESS;
+}
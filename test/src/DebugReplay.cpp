@@ -53,13 +53,13 @@ DebugReplay::~DebugReplay()
 long
 DebugReplay::Size() const
 {
-  return reader->size();
+  return reader != NULL ? reader->size() : 0;
 }
 
 long
 DebugReplay::Tell() const
 {
-  return reader->tell();
+  return reader != NULL ? reader->tell() : 0;
 }
 
 void
@@ -72,6 +72,28 @@ DebugReplay::Compute()
                           calculated.flight);
 }
 
+void
+DebugReplay::CopyFromFix(const IGCFix &fix)
+{
+  basic.clock = basic.time = fixed(fix.time.GetSecondOfDay());
+  basic.time_available.Update(basic.clock);
+  basic.date_time_utc.year = 2011;
+  basic.date_time_utc.month = 6;
+  basic.date_time_utc.day = 5;
+  basic.date_time_utc.hour = fix.time.hour;
+  basic.date_time_utc.minute = fix.time.minute;
+  basic.date_time_utc.second = fix.time.second;
+  basic.date_available = true;
+  basic.alive.Update(basic.clock);
+  basic.location = fix.location;
+  basic.location_available.Update(basic.clock);
+  basic.gps_altitude = fix.gps_altitude;
+  basic.gps_altitude_available.Update(basic.clock);
+  basic.pressure_altitude = basic.baro_altitude = fix.pressure_altitude;
+  basic.pressure_altitude_available.Update(basic.clock);
+  basic.baro_altitude_available.Update(basic.clock);
+}
+
 class DebugReplayNMEA : public DebugReplay {
   Device *device;
 
@@ -126,9 +148,6 @@ public:
     :DebugReplay(reader) {}
 
   virtual bool Next();
-
-protected:
-  void CopyFromFix(const IGCFix &fix);
 };
 
 bool
@@ -153,28 +172,6 @@ DebugReplayIGC::Next()
   return false;
 }
 
-void
-DebugReplayIGC::CopyFromFix(const IGCFix &fix)
-{
-  basic.clock = basic.time = fixed(fix.time.GetSecondOfDay());
-  basic.time_available.Update(basic.clock);
-  basic.date_time_utc.year = 2011;
-  basic.date_time_utc.month = 6;
-  basic.date_time_utc.day = 5;
-  basic.date_time_utc.hour = fix.time.hour;
-  basic.date_time_utc.minute = fix.time.minute;
-  basic.date_time_utc.second = fix.time.second;
-  basic.date_available = true;
-  basic.alive.Update(basic.clock);
-  basic.location = fix.location;
-  basic.location_available.Update(basic.clock);
-  basic.gps_altitude = fix.gps_altitude;
-  basic.gps_altitude_available.Update(basic.clock);
-  basic.pressure_altitude = basic.baro_altitude = fix.pressure_altitude;
-  basic.pressure_altitude_available.Update(basic.clock);
-  basic.baro_altitude_available.Update(basic.clock);
-}
-
 DebugReplay *
 CreateDebugReplay(Args &args)
 {
@@ -32,12 +32,17 @@ Copyright_License {
 #include "Engine/GlideSolvers/GlidePolar.hpp"
 
 class NLineReader;
+struct IGCFix;
 class Device;
 struct DeviceRegister;
 class Args;
 
 class DebugReplay {
 protected:
+  /**
+   * The input file; may be NULL if the subclass obtains its data
+   * elsewhere.
+   */
   NLineReader *reader;
 
   GlidePolar glide_polar;
@@ -87,6 +92,11 @@ public:
 
 protected:
   void Compute();
+
+  /**
+   * Copy an IGC "B" record to #basic.
+   */
+  void CopyFromFix(const IGCFix &fix);
 };
 
 DebugReplay *
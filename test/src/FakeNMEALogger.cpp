@@ -24,6 +24,6 @@ Copyright_License {
 #include "Logger/NMEALogger.hpp"
 
 void
-NMEALogger::Log(const char *text)
+NMEALogger::Log(unsigned device, const char *text)
 {
 }
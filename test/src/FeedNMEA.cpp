@@ -26,8 +26,16 @@ Copyright_License {
  * NMEA data read from stdin to it.  It is useful to feed WINE with
  * it: symlink ~/.wine/dosdevices/com1 to /tmp/nmea, and configure
  * "COM1" in XCSoar.
+ *
+ * If a capture file written by the NMEA logger is specified instead,
+ * the lines are fed with their original timing, and each device gets
+ * its own pseudo-TTY: /tmp/nmea for the first one, /tmp/nmea1 for the
+ * second one and so on.
  */
 
+#include "Logger/NMEACapture.hpp"
+#include "IO/FileSource.hpp"
+
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdio.h>
@@ -35,6 +43,8 @@ Copyright_License {
 #include <errno.h>
 #include <stdlib.h>
 
+#include <algorithm>
+
 /** Create a pseudo TTY, and symlink it to /tmp/nmea. */
 static int
 open_virtual(const char *symlink_path)
@@ -61,9 +71,68 @@ open_virtual(const char *symlink_path)
   return fd;
 }
 
+static bool
+Write(int fd, const char *data, size_t length)
+{
+  ssize_t nbytes = write(fd, data, length);
+  if (nbytes < 0) {
+    perror("Failed to write to port\n");
+    return false;
+  }
+
+  return true;
+}
+
+static int
+FeedCapture(const char *path)
+{
+  FileSource file(path);
+  if (file.error()) {
+    fprintf(stderr, "Failed to open %s\n", path);
+    return EXIT_FAILURE;
+  }
+
+  int fds[NMEACapture::MAX_DEVICES];
+  std::fill(fds, fds + NMEACapture::MAX_DEVICES, -1);
+
+  NMEACapture::Reader reader(file);
+  NMEACapture::Record record;
+  unsigned time = 0;
+  while (reader.Read(record)) {
+    if (record.time > time) {
+      usleep((record.time - time) * 1000);
+      time = record.time;
+    }
+
+    int &fd = fds[record.device];
+    if (fd < 0) {
+      char symlink_path[32];
+      if (record.device == 0)
+        strcpy(symlink_path, "/tmp/nmea");
+      else
+        sprintf(symlink_path, "/tmp/nmea%u", record.device);
+
+      fd = open_virtual(symlink_path);
+    }
+
+    record.line[record.length] = '\n';
+    if (!Write(fd, record.line, record.length + 1))
+      return 2;
+  }
+
+  for (unsigned i = 0; i < NMEACapture::MAX_DEVICES; ++i)
+    if (fds[i] >= 0)
+      close(fds[i]);
+
+  return EXIT_SUCCESS;
+}
+
 int
 main(int argc, char **argv)
 {
+  if (argc == 2)
+    return FeedCapture(argv[1]);
+
   int fd = open_virtual("/tmp/nmea");
 
   char stamp[6] = "";
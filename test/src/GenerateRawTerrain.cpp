@@ -0,0 +1,94 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program decodes all terrain tiles of a map file and writes
+ * them to an uncompressed file which can be memory mapped by
+ * RasterTileCache::LoadRaw().  XCSoar looks for it next to the map
+ * file, with ".raw" appended to the map file name.
+ */
+
+#include "Terrain/RasterTileCache.hpp"
+#include "OS/PathName.hpp"
+#include "Compatibility/path.h"
+#include "Operation/Operation.hpp"
+
+#include <stdio.h>
+#include <tchar.h>
+
+int main(int argc, char **argv)
+{
+  if (argc != 2 && argc != 3) {
+    fprintf(stderr, "Usage: %s PATH [OUTPUT]\n", argv[0]);
+    return 1;
+  }
+
+  const char *map_path = argv[1];
+
+  char raw_path[4096];
+  if (argc == 3) {
+    strcpy(raw_path, argv[2]);
+  } else {
+    strcpy(raw_path, map_path);
+    strcat(raw_path, ".raw");
+  }
+
+  char jp2_path[4096];
+  strcpy(jp2_path, map_path);
+  strcat(jp2_path, DIR_SEPARATOR_S "terrain.jp2");
+
+  TCHAR j2w_path[4096];
+  _tcscpy(j2w_path, PathName(map_path));
+  _tcscat(j2w_path, _T(DIR_SEPARATOR_S) _T("terrain.j2w"));
+
+  NullOperationEnvironment operation;
+  RasterTileCache rtc;
+  if (!rtc.LoadOverview(jp2_path, j2w_path, operation)) {
+    fprintf(stderr, "LoadOverview failed\n");
+    return EXIT_FAILURE;
+  }
+
+  FILE *file = fopen(raw_path, "wb");
+  if (file == NULL) {
+    fprintf(stderr, "Failed to create %s\n", raw_path);
+    return EXIT_FAILURE;
+  }
+
+  bool success = rtc.SaveRaw(jp2_path, file);
+  if (fclose(file) != 0)
+    success = false;
+
+  if (!success) {
+    fprintf(stderr, "Failed to write %s\n", raw_path);
+    remove(raw_path);
+    return EXIT_FAILURE;
+  }
+
+  /* verify that the file we have just written can be used */
+  if (!rtc.LoadRaw(PathName(raw_path))) {
+    fprintf(stderr, "Failed to load %s\n", raw_path);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
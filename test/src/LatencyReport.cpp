@@ -0,0 +1,194 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Reads the file written by XCSoar's "-trace-latency" option, and
+ * prints latency histograms for each stage a GPS fix passes, from
+ * the port to the screen.
+ */
+
+#include "LatencyTrace.hpp"
+#include "OS/Args.hpp"
+#include "Util/Macros.hpp"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace LatencyTrace;
+
+/**
+ * The time of the first event of each stage of one fix [us]; zero
+ * if the stage was not recorded.
+ */
+struct FixTimes {
+  uint64_t times[N_STAGES];
+
+  FixTimes() {
+    std::fill(times, times + N_STAGES, 0);
+  }
+};
+
+typedef std::map<int, FixTimes> FixMap;
+
+static bool
+ParseStage(const char *name, Stage &stage_r)
+{
+  for (unsigned i = 0; i < N_STAGES; ++i) {
+    if (strcmp(name, GetStageName((Stage)i)) == 0) {
+      stage_r = (Stage)i;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static bool
+Load(const char *path, FixMap &fixes)
+{
+  FILE *file = fopen(path, "r");
+  if (file == NULL) {
+    fprintf(stderr, "Failed to open %s\n", path);
+    return false;
+  }
+
+  unsigned long long time;
+  char name[32];
+  int fix_time;
+  while (fscanf(file, "%llu %31s %d", &time, name, &fix_time) == 3) {
+    Stage stage;
+    if (!ParseStage(name, stage))
+      continue;
+
+    /* a fix may be drawn several times; the first one counts */
+    uint64_t &t = fixes[fix_time].times[stage];
+    if (t == 0 || time < t)
+      t = time;
+  }
+
+  fclose(file);
+  return true;
+}
+
+static void
+PrintHistogram(const char *label, std::vector<unsigned> &values)
+{
+  printf("%s\n", label);
+
+  if (values.empty()) {
+    printf("  no data\n\n");
+    return;
+  }
+
+  std::sort(values.begin(), values.end());
+
+  const unsigned n = values.size();
+  printf("  n=%u min=%.1f median=%.1f p95=%.1f max=%.1f ms\n",
+         n, values.front() / 1000., values[n / 2] / 1000.,
+         values[n * 95 / 100] / 1000., values.back() / 1000.);
+
+  /* upper bounds of the histogram buckets [ms] */
+  static const unsigned bounds[] = {
+    1, 2, 5, 10, 20, 50, 100, 200, 500, 1000,
+  };
+
+  unsigned counts[ARRAY_SIZE(bounds) + 1];
+  std::fill(counts, counts + ARRAY_SIZE(counts), 0);
+
+  for (auto i = values.begin(), end = values.end(); i != end; ++i) {
+    unsigned bucket = std::upper_bound(bounds, bounds + ARRAY_SIZE(bounds),
+                                       *i / 1000) - bounds;
+    ++counts[bucket];
+  }
+
+  for (unsigned i = 0; i < ARRAY_SIZE(counts); ++i) {
+    if (counts[i] == 0)
+      continue;
+
+    char range[32];
+    if (i < ARRAY_SIZE(bounds))
+      snprintf(range, sizeof(range), "< %u ms", bounds[i]);
+    else
+      snprintf(range, sizeof(range), ">= %u ms", bounds[i - 1]);
+
+    const unsigned width = (counts[i] * 50 + n - 1) / n;
+    printf("  %10s %6u ", range, counts[i]);
+    for (unsigned j = 0; j < width; ++j)
+      putchar('#');
+    putchar('\n');
+  }
+
+  putchar('\n');
+}
+
+/**
+ * Collect the latencies between two stages of all fixes which have
+ * both [us].
+ */
+static void
+CollectLatencies(const FixMap &fixes, Stage from, Stage to,
+                 std::vector<unsigned> &dest)
+{
+  dest.clear();
+
+  for (auto i = fixes.begin(), end = fixes.end(); i != end; ++i) {
+    const uint64_t a = i->second.times[from], b = i->second.times[to];
+    if (a != 0 && b >= a)
+      dest.push_back((unsigned)(b - a));
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  Args args(argc, argv, "FILE");
+  const char *path = args.ExpectNext();
+  args.ExpectEnd();
+
+  FixMap fixes;
+  if (!Load(path, fixes))
+    return EXIT_FAILURE;
+
+  printf("%u fixes\n\n", (unsigned)fixes.size());
+
+  std::vector<unsigned> latencies;
+  char label[64];
+
+  for (unsigned i = 1; i < N_STAGES; ++i) {
+    const Stage from = (Stage)(i - 1), to = (Stage)i;
+    snprintf(label, sizeof(label), "%s -> %s",
+             GetStageName(from), GetStageName(to));
+    CollectLatencies(fixes, from, to, latencies);
+    PrintHistogram(label, latencies);
+  }
+
+  snprintf(label, sizeof(label), "%s -> %s (total)",
+           GetStageName(RECEIVED), GetStageName(DRAWN));
+  CollectLatencies(fixes, RECEIVED, DRAWN, latencies);
+  PrintHistogram(label, latencies);
+
+  return EXIT_SUCCESS;
+}
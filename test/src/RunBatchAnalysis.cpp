@@ -0,0 +1,364 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * Analyse many IGC files at once, e.g. all flights of a competition
+ * day, and print one line of statistics and contest results per
+ * flight.  The flights are distributed over a pool of threads.
+ */
+
+#include "DebugReplay.hpp"
+#include "Replay/IGCParser.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Contest/ContestManager.hpp"
+#include "NMEA/Aircraft.hpp"
+#include "OS/Args.hpp"
+#include "OS/FileMapping.hpp"
+#include "OS/PathName.hpp"
+#include "Thread/ThreadPool.hpp"
+#include "Thread/Mutex.hpp"
+
+#include <vector>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct Flight {
+  const char *path;
+
+  /**
+   * The date from the "HFDTE" record; not plausible if there was
+   * none.
+   */
+  BrokenDate date;
+
+  std::vector<IGCFix> fixes;
+
+  bool loaded;
+
+  unsigned n_fixes;
+  fixed takeoff_time, flight_time;
+  fixed max_altitude;
+
+  /**
+   * OLC-Plus results: classic, FAI and plus.
+   */
+  ContestResult contest[3];
+};
+
+/**
+ * Map the IGC file into memory and parse all "B" records at once.
+ */
+static bool
+LoadFlight(Flight &flight)
+{
+  flight.date.Clear();
+
+  FileMapping mapping(PathName(flight.path));
+  if (mapping.error())
+    return false;
+
+  const char *p = (const char *)mapping.data();
+  const char *const end = (const char *)mapping.end();
+
+  char line[256];
+  while (p < end) {
+    const char *eol = (const char *)memchr(p, '\n', end - p);
+    if (eol == NULL)
+      eol = end;
+
+    size_t length = eol - p;
+    if (length > 0 && p[length - 1] == '\r')
+      --length;
+
+    if (length < sizeof(line) && (*p == 'B' || *p == 'H')) {
+      memcpy(line, p, length);
+      line[length] = 0;
+
+      IGCFix fix;
+      if (*p == 'B') {
+        if (IGCParseFix(line, fix))
+          flight.fixes.push_back(fix);
+      } else if (!flight.date.Plausible())
+        IGCParseDate(line, flight.date);
+    }
+
+    p = eol + 1;
+  }
+
+  return true;
+}
+
+/**
+ * Replays the fixes which were parsed by LoadFlight().
+ */
+class FixReplay : public DebugReplay {
+  const Flight &flight;
+  std::vector<IGCFix>::const_iterator i;
+
+public:
+  FixReplay(const Flight &_flight)
+    :DebugReplay(NULL), flight(_flight), i(flight.fixes.begin()) {}
+
+  virtual bool Next() {
+    if (i == flight.fixes.end())
+      return false;
+
+    last_basic = basic;
+    last_calculated = calculated;
+
+    CopyFromFix(*i++);
+    if (flight.date.Plausible()) {
+      basic.date_time_utc.year = flight.date.year;
+      basic.date_time_utc.month = flight.date.month;
+      basic.date_time_utc.day = flight.date.day;
+    }
+
+    Compute();
+    return true;
+  }
+};
+
+static void
+AnalyseFlight(Flight &flight)
+{
+  flight.loaded = LoadFlight(flight);
+  if (!flight.loaded)
+    return;
+
+  Trace full_trace(60, Trace::null_time, 512);
+  Trace sprint_trace(0, 9000, 128);
+  ContestManager contest(OLC_Plus, full_trace, sprint_trace);
+
+  flight.max_altitude = fixed_zero;
+
+  FixReplay replay(flight);
+  while (replay.Next()) {
+    const AircraftState state =
+      ToAircraftState(replay.Basic(), replay.Calculated());
+    full_trace.append(state);
+    sprint_trace.append(state);
+
+    if (replay.Basic().gps_altitude > flight.max_altitude)
+      flight.max_altitude = replay.Basic().gps_altitude;
+  }
+
+  contest.SolveExhaustive();
+
+  const FlyingState &flying = replay.Calculated().flight;
+  flight.takeoff_time = flying.takeoff_time;
+  flight.flight_time = flying.flight_time;
+  flight.n_fixes = flight.fixes.size();
+
+  for (unsigned i = 0; i < 3; ++i)
+    flight.contest[i] = contest.GetStats().GetResult(i);
+
+  /* free the memory early, there may be many flights */
+  std::vector<IGCFix>().swap(flight.fixes);
+}
+
+/**
+ * Each thread picks the next flight which has not been analysed yet,
+ * until all are done.  Unlike fixed bands, this keeps all threads
+ * busy even if the flights take very different amounts of time.
+ */
+class BatchJob : public ThreadPool::Job {
+  std::vector<Flight> &flights;
+
+  Mutex mutex;
+  unsigned next;
+
+public:
+  BatchJob(std::vector<Flight> &_flights)
+    :flights(_flights), next(0) {}
+
+  virtual void Run(unsigned begin, unsigned end) {
+    while (true) {
+      mutex.Lock();
+      const unsigned i = next++;
+      mutex.Unlock();
+
+      if (i >= flights.size())
+        return;
+
+      AnalyseFlight(flights[i]);
+    }
+  }
+};
+
+static void
+FormatTime(char *buffer, fixed time)
+{
+  if (negative(time)) {
+    *buffer = 0;
+    return;
+  }
+
+  const unsigned t = (unsigned)time;
+  sprintf(buffer, "%02u:%02u:%02u", t / 3600, t / 60 % 60, t % 60);
+}
+
+static void
+FormatDate(char *buffer, const BrokenDate &date)
+{
+  if (date.Plausible())
+    sprintf(buffer, "%04u-%02u-%02u", date.year, date.month, date.day);
+  else
+    *buffer = 0;
+}
+
+/**
+ * Print a string with the specified quote character, which is
+ * escaped by doubling it (CSV) or with a backslash (JSON).
+ */
+static void
+PrintQuoted(const char *value, bool json)
+{
+  putchar('"');
+  for (; *value != 0; ++value) {
+    if (*value == '"')
+      putchar(json ? '\\' : '"');
+    else if (json && *value == '\\')
+      putchar('\\');
+    putchar(*value);
+  }
+  putchar('"');
+}
+
+static void
+PrintCSV(const std::vector<Flight> &flights)
+{
+  puts("file,date,fixes,takeoff,flight_time,max_altitude,"
+       "classic_distance,classic_score,fai_distance,fai_score,plus_score");
+
+  for (auto i = flights.begin(), end = flights.end(); i != end; ++i) {
+    const Flight &flight = *i;
+
+    PrintQuoted(flight.path, false);
+    if (!flight.loaded) {
+      puts(",,,,,,,,,,");
+      continue;
+    }
+
+    char date[16], takeoff[16], flight_time[16];
+    FormatDate(date, flight.date);
+    FormatTime(takeoff, flight.takeoff_time);
+    FormatTime(flight_time, flight.flight_time);
+
+    printf(",%s,%u,%s,%s,%.0f,%.0f,%.2f,%.0f,%.2f,%.2f\n",
+           date, flight.n_fixes, takeoff, flight_time,
+           (double)flight.max_altitude,
+           (double)flight.contest[0].distance,
+           (double)flight.contest[0].score,
+           (double)flight.contest[1].distance,
+           (double)flight.contest[1].score,
+           (double)flight.contest[2].score);
+  }
+}
+
+static void
+PrintJSONContest(const char *name, const ContestResult &result)
+{
+  printf("\"%s\": {\"distance\": %.0f, \"score\": %.2f, \"speed\": %.2f}",
+         name, (double)result.distance, (double)result.score,
+         (double)result.speed);
+}
+
+static void
+PrintJSON(const std::vector<Flight> &flights)
+{
+  puts("[");
+
+  for (auto i = flights.begin(), end = flights.end(); i != end; ++i) {
+    const Flight &flight = *i;
+
+    printf("  {\"file\": ");
+    PrintQuoted(flight.path, true);
+
+    if (flight.loaded) {
+      char date[16], takeoff[16], flight_time[16];
+      FormatDate(date, flight.date);
+      FormatTime(takeoff, flight.takeoff_time);
+      FormatTime(flight_time, flight.flight_time);
+
+      printf(", \"date\": \"%s\", \"fixes\": %u, \"takeoff\": \"%s\", "
+             "\"flight_time\": \"%s\", \"max_altitude\": %.0f, ",
+             date, flight.n_fixes, takeoff, flight_time,
+             (double)flight.max_altitude);
+      PrintJSONContest("classic", flight.contest[0]);
+      printf(", ");
+      PrintJSONContest("fai", flight.contest[1]);
+      printf(", ");
+      PrintJSONContest("plus", flight.contest[2]);
+    } else
+      printf(", \"error\": \"failed to open\"");
+
+    puts(i + 1 != end ? "}," : "}");
+  }
+
+  puts("]");
+}
+
+int
+main(int argc, char **argv)
+{
+  Args args(argc, argv, "[--json] [--jobs=N] FILE.igc ...");
+
+  bool json = false;
+  unsigned n_threads = ThreadPool::GetDefaultWorkerCount() + 1;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != NULL && arg[0] == '-') {
+    args.GetNext();
+
+    if (strcmp(arg, "--json") == 0)
+      json = true;
+    else if (strncmp(arg, "--jobs=", 7) == 0) {
+      n_threads = atoi(arg + 7);
+      if (n_threads < 1)
+        args.UsageError();
+    } else
+      args.UsageError();
+  }
+
+  std::vector<Flight> flights;
+  do {
+    flights.push_back(Flight());
+    flights.back().path = args.ExpectNext();
+  } while (!args.IsEmpty());
+
+  BatchJob job(flights);
+  ThreadPool pool(n_threads - 1);
+  pool.Run(job, 0, pool.GetWorkerCount() + 1);
+
+  if (json)
+    PrintJSON(flights);
+  else
+    PrintCSV(flights);
+
+  for (auto i = flights.begin(), end = flights.end(); i != end; ++i)
+    if (!i->loaded)
+      fprintf(stderr, "Failed to open %s\n", i->path);
+
+  return EXIT_SUCCESS;
+}
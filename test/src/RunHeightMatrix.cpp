@@ -25,23 +25,57 @@ Copyright_License {
 #include "Terrain/HeightMatrix.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Screen/Layout.hpp"
+#include "Thread/ThreadPool.hpp"
 #include "OS/PathName.hpp"
+#include "OS/Clock.hpp"
 #include "Compatibility/path.h"
 #include "Operation/Operation.hpp"
+#include "Util/Macros.hpp"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <tchar.h>
 
 unsigned Layout::scale_1024 = 1024;
 
+static const unsigned resolutions[][2] = {
+  { 320, 240 },
+  { 640, 480 },
+  { 800, 480 },
+  { 1024, 768 },
+  { 1920, 1080 },
+};
+
+static const unsigned N_FRAMES = 20;
+
+/**
+ * Fill the matrix #N_FRAMES times like RasterRenderer does, and
+ * return the average duration of one frame in milliseconds.
+ */
+static double
+Benchmark(const RasterMap &map, const WindowProjection &projection,
+          ThreadPool *pool)
+{
+  HeightMatrix matrix;
+
+  const uint64_t start = MonotonicClockUS();
+  for (unsigned i = 0; i < N_FRAMES; ++i)
+    matrix.Fill(map, projection, 2, true, pool);
+
+  return (MonotonicClockUS() - start) / (1000. * N_FRAMES);
+}
+
 int main(int argc, char **argv)
 {
-  if (argc != 2) {
-    fprintf(stderr, "Usage: %s PATH\n", argv[0]);
+  if (argc < 2 || argc > 3) {
+    fprintf(stderr, "Usage: %s PATH [THREADS]\n", argv[0]);
     return 1;
   }
 
   const char *map_path = argv[1];
+  const unsigned n_threads = argc > 2
+    ? strtoul(argv[2], NULL, 10)
+    : ThreadPool::GetDefaultWorkerCount() + 1;
 
   TCHAR jp2_path[4096];
   _tcscpy(jp2_path, PathName(map_path));
@@ -62,16 +96,27 @@ int main(int argc, char **argv)
     map.SetViewCenter(map.GetMapCenter(), fixed(50000));
   } while (map.IsDirty());
 
-  fixed radius = fixed(50000);
-  WindowProjection projection;
-  projection.SetScreenSize(640, 480);
-  projection.SetScaleFromRadius(radius);
-  projection.SetGeoLocation(map.GetMapCenter());
-  projection.SetScreenOrigin(320, 240);
-  projection.UpdateScreenBounds();
+  ThreadPool pool(n_threads > 0 ? n_threads - 1 : 0);
 
-  HeightMatrix matrix;
-  matrix.Fill(map, projection, 1, false);
+  printf("resolution   1 thread  %u threads\n", n_threads);
+
+  for (unsigned i = 0; i < ARRAY_SIZE(resolutions); ++i) {
+    const unsigned width = resolutions[i][0], height = resolutions[i][1];
+
+    fixed radius = fixed(5000);
+    WindowProjection projection;
+    projection.SetScreenSize(width, height);
+    projection.SetScaleFromRadius(radius);
+    projection.SetGeoLocation(map.GetMapCenter());
+    projection.SetScreenOrigin(width / 2, height / 2);
+    projection.UpdateScreenBounds();
+
+    const double single = Benchmark(map, projection, NULL);
+    const double parallel = Benchmark(map, projection, &pool);
+
+    printf("%4ux%-4u  %7.2f ms  %7.2f ms\n",
+           width, height, single, parallel);
+  }
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,189 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Airspace/AirspaceCache.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "IO/FileLineReader.hpp"
+#include "Operation/Operation.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+static bool
+Equals(const AirspaceAltitude &a, const AirspaceAltitude &b)
+{
+  return a.type == b.type && a.altitude == b.altitude &&
+    a.flight_level == b.flight_level &&
+    a.altitude_above_terrain == b.altitude_above_terrain;
+}
+
+static bool
+Equals(const AbstractAirspace &a, const AbstractAirspace &b)
+{
+  if (a.shape != b.shape || a.GetType() != b.GetType() ||
+      _tcscmp(a.GetName(), b.GetName()) != 0 ||
+      a.GetRadioText() != b.GetRadioText() ||
+      !Equals(a.GetBase(), b.GetBase()) || !Equals(a.GetTop(), b.GetTop()) ||
+      !a.GetDays().equals(b.GetDays()))
+    return false;
+
+  if (a.shape == AbstractAirspace::Shape::CIRCLE &&
+      ((const AirspaceCircle &)a).GetRadius() !=
+      ((const AirspaceCircle &)b).GetRadius())
+    return false;
+
+  const SearchPointVector &pa = a.GetPoints(), &pb = b.GetPoints();
+  if (pa.size() != pb.size())
+    return false;
+
+  for (unsigned i = 0; i < pa.size(); ++i)
+    if (pa[i].get_location() != pb[i].get_location())
+      return false;
+
+  return true;
+}
+
+/**
+ * Copy the contents of a file to a new temporary file, optionally
+ * truncated.
+ */
+static FILE *
+CopyFile(FILE *src, long truncate)
+{
+  fseek(src, 0, SEEK_END);
+  const long size = ftell(src);
+  rewind(src);
+
+  std::vector<char> buffer(size);
+  if (fread(&buffer.front(), size, 1, src) != 1)
+    return NULL;
+
+  FILE *dest = tmpfile();
+  fwrite(&buffer.front(), size - truncate, 1, dest);
+  rewind(dest);
+  return dest;
+}
+
+static void
+TestCache(const TCHAR *path)
+{
+  Airspaces parsed;
+  FileLineReader reader(path, ConvertLineReader::AUTO);
+  AirspaceParser parser(parsed);
+  NullOperationEnvironment operation;
+  if (!ok1(!reader.error() && parser.Parse(reader, operation))) {
+    skip(5, 0, "Failed to parse input file");
+    return;
+  }
+
+  const std::deque<AbstractAirspace *> &original = parsed.GetPending();
+
+  FILE *file = tmpfile();
+  ok1(AirspaceCache::Save(file, path, original.begin(), original.end()));
+
+  /* load it back */
+  rewind(file);
+  Airspaces loaded;
+  ok1(AirspaceCache::Load(file, path, loaded));
+
+  const std::deque<AbstractAirspace *> &copy = loaded.GetPending();
+  bool equal = copy.size() == original.size() && !copy.empty();
+  for (unsigned i = 0; equal && i < copy.size(); ++i)
+    equal = Equals(*original[i], *copy[i]);
+  ok1(equal);
+
+  /* the cache belongs to a different file */
+  rewind(file);
+  Airspaces other;
+  ok1(!AirspaceCache::Load(file, _T("foo.txt"), other) && other.empty());
+
+  /* truncated cache file */
+  FILE *truncated = CopyFile(file, 3);
+  ok1(truncated != NULL &&
+      !AirspaceCache::Load(truncated, path, other) && other.empty());
+  if (truncated != NULL)
+    fclose(truncated);
+
+  fclose(file);
+}
+
+/**
+ * Check that the days of operation of TNP airspaces survive the
+ * cache, e.g. a weekend-only airspace must not become active on
+ * weekdays.
+ */
+static void
+TestDays()
+{
+  const TCHAR *path = _T("test/data/airspace/days.sua");
+
+  Airspaces parsed;
+  FileLineReader reader(path, ConvertLineReader::AUTO);
+  AirspaceParser parser(parsed);
+  NullOperationEnvironment operation;
+  if (!ok1(!reader.error() && parser.Parse(reader, operation))) {
+    skip(4, 0, "Failed to parse input file");
+    return;
+  }
+
+  const std::deque<AbstractAirspace *> &original = parsed.GetPending();
+
+  FILE *file = tmpfile();
+  AirspaceCache::Save(file, path, original.begin(), original.end());
+  rewind(file);
+
+  Airspaces loaded;
+  ok1(AirspaceCache::Load(file, path, loaded) &&
+      loaded.GetPending().size() == 3);
+  fclose(file);
+
+  AirspaceActivity weekend, weekdays, everyday;
+  weekend.set_weekend();
+  weekdays.set_weekdays();
+  everyday.set_all();
+
+  const std::deque<AbstractAirspace *> &copy = loaded.GetPending();
+  for (auto i = copy.begin(), end = copy.end(); i != end; ++i) {
+    const AbstractAirspace &airspace = **i;
+    if (_tcscmp(airspace.GetName(), _T("Weekend-Test")) == 0)
+      ok1(airspace.GetDays().equals(weekend));
+    else if (_tcscmp(airspace.GetName(), _T("Weekday-Test")) == 0)
+      ok1(airspace.GetDays().equals(weekdays));
+    else if (_tcscmp(airspace.GetName(), _T("Everyday-Test")) == 0)
+      ok1(airspace.GetDays().equals(everyday));
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(17);
+
+  TestCache(_T("test/data/airspace/openair.txt"));
+  TestCache(_T("test/data/airspace/tnp.sua"));
+  TestDays();
+
+  return exit_status();
+}
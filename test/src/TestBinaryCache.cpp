@@ -0,0 +1,128 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IO/BinaryCache.hpp"
+#include "TestUtil.hpp"
+
+#include <string.h>
+
+static FILE *
+CreateFile(const tstring &value, uint32_t number)
+{
+  FILE *file = tmpfile();
+  if (file == NULL)
+    return NULL;
+
+  const uint16_t length = value.length();
+  if (!WriteCacheData(file, &number, sizeof(number)) ||
+      !WriteCacheData(file, &length, sizeof(length)) ||
+      !WriteCacheString(file, value) ||
+      /* empty writes succeed */
+      !WriteCacheData(file, NULL, 0)) {
+    fclose(file);
+    return NULL;
+  }
+
+  rewind(file);
+  return file;
+}
+
+static void
+TestRoundTrip()
+{
+  FILE *file = CreateFile(_T("Benalla"), 42);
+  if (!ok1(file != NULL)) {
+    skip(6, 0, "Failed to create file");
+    return;
+  }
+
+  CacheReader reader;
+  ok1(reader.Load(file));
+
+  uint32_t number;
+  uint16_t length;
+  tstring value;
+  ok1(reader.Read(number) && number == 42);
+  ok1(reader.Read(length) && length == 7);
+  ok1(reader.ReadString(value, length) && value == _T("Benalla"));
+  ok1(reader.IsEnd());
+
+  /* reading beyond the end fails */
+  ok1(!reader.Read(number));
+
+  fclose(file);
+}
+
+static void
+TestPartial()
+{
+  FILE *file = CreateFile(_T("Benalla"), 42);
+  if (!ok1(file != NULL)) {
+    skip(4, 0, "Failed to create file");
+    return;
+  }
+
+  /* Load() reads from the current position */
+  fseek(file, sizeof(uint32_t), SEEK_SET);
+  CacheReader reader;
+  uint16_t length;
+  tstring value;
+  ok1(reader.Load(file));
+  ok1(reader.Read(length) && length == 7);
+
+  /* a string which is longer than the rest of the data */
+  ok1(!reader.ReadString(value, length + 1));
+  ok1(reader.ReadString(value, length) && reader.IsEnd());
+
+  fclose(file);
+}
+
+static void
+TestEmpty()
+{
+  FILE *file = tmpfile();
+  if (!ok1(file != NULL)) {
+    skip(3, 0, "Failed to create file");
+    return;
+  }
+
+  CacheReader reader;
+  uint8_t value;
+  tstring s;
+  ok1(reader.Load(file));
+  ok1(reader.IsEnd() && !reader.Read(value));
+  ok1(reader.ReadString(s, 0) && s.empty());
+
+  fclose(file);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(16);
+
+  TestRoundTrip();
+  TestPartial();
+  TestEmpty();
+
+  return exit_status();
+}
@@ -26,7 +26,7 @@
 
 int main(int argc, char **argv)
 {
-  plan_tests(15);
+  plan_tests(19);
 
   int count = FlarmNet::LoadFile(_T("test/data/flarmnet/data.fln"));
   ok1(count == 6);
@@ -74,6 +74,18 @@ int main(int argc, char **argv)
   ok1(foundDDA85C);
   ok1(foundDDA896);
 
+  /* the result is limited to the array size */
+  ok1(FlarmNet::FindRecordsByCallSign(_T("TH"), array, 1) == 1);
+
+  /* the first record is the one with the smallest id */
+  record = FlarmNet::FindFirstRecordByCallSign(_T("TH"));
+  ok1(record != NULL && _tcscmp(record->id, _T("DDA85C")) == 0);
+
+  ok1(FlarmNet::FindFirstRecordByCallSign(_T("XYZ")) == NULL);
+
+  id.Parse("123456", NULL);
+  ok1(FlarmNet::FindRecordById(id) == NULL);
+
   FlarmNet::Destroy();
 
   return exit_status();
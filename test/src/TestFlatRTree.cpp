@@ -0,0 +1,193 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Engine/Navigation/Flat/FlatRTree.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <stdlib.h>
+
+struct TestBox : public FlatBoundingBox {
+  unsigned id;
+
+  TestBox(const FlatGeoPoint &ll, const FlatGeoPoint &ur, unsigned _id)
+    :FlatBoundingBox(ll, ur), id(_id) {}
+
+  bool operator==(const TestBox &other) const {
+    return id == other.id;
+  }
+};
+
+/* a small node size gives a deeper tree */
+typedef FlatRTree<TestBox, 4> TestTree;
+
+static const unsigned N = 500;
+
+struct TestVisitor {
+  bool found[N];
+  unsigned count;
+
+  TestVisitor():count(0) {
+    std::fill(found, found + N, false);
+  }
+
+  void operator()(const TestBox &box) {
+    found[box.id] = true;
+    ++count;
+  }
+};
+
+struct OddPredicate {
+  bool operator()(const TestBox &box) const {
+    return box.id % 2 == 1;
+  }
+};
+
+static FlatGeoPoint
+RandomPoint(int range)
+{
+  return FlatGeoPoint(rand() % range, rand() % range);
+}
+
+static TestBox
+RandomBox(unsigned id)
+{
+  const FlatGeoPoint ll = RandomPoint(10000);
+
+  /* a few large boxes which overlap many others */
+  const int size = rand() % 20 == 0 ? 3000 : 1 + rand() % 200;
+  const FlatGeoPoint ur(ll.Longitude + rand() % size,
+                        ll.Latitude + rand() % size);
+  return TestBox(ll, ur, id);
+}
+
+static TestBox
+DummyBox(unsigned id)
+{
+  return TestBox(FlatGeoPoint(0, 0), FlatGeoPoint(0, 0), id);
+}
+
+/**
+ * Compare VisitOverlapping() with a linear search.
+ */
+static bool
+CheckOverlapping(const TestTree &tree, const FlatBoundingBox &query)
+{
+  TestVisitor visitor;
+  tree.VisitOverlapping(query, visitor);
+
+  unsigned count = 0;
+  for (auto i = tree.begin(), end = tree.end(); i != end; ++i) {
+    const bool overlaps = i->Overlaps(query);
+    if (overlaps != visitor.found[i->id])
+      return false;
+
+    if (overlaps)
+      ++count;
+  }
+
+  return count == visitor.count;
+}
+
+/**
+ * Compare FindNearestIf() with a linear search.
+ */
+static bool
+CheckNearest(const TestTree &tree, const FlatGeoPoint &location,
+             unsigned max_distance)
+{
+  unsigned best = max_distance + 1;
+  for (auto i = tree.begin(), end = tree.end(); i != end; ++i)
+    if (i->id % 2 == 1)
+      best = std::min(best, i->MinDistance(location));
+
+  const std::pair<TestTree::const_iterator, unsigned> found =
+    tree.FindNearestIf(location, max_distance, OddPredicate());
+  if (best > max_distance)
+    return found.first == tree.end();
+
+  return found.first != tree.end() && found.first->id % 2 == 1 &&
+    found.second == best && found.first->MinDistance(location) == best;
+}
+
+static bool
+CheckQueries(const TestTree &tree)
+{
+  for (unsigned i = 0; i < 200; ++i) {
+    const FlatGeoPoint location = RandomPoint(12000);
+    if (!CheckOverlapping(tree, FlatBoundingBox(location, rand() % 1000)))
+      return false;
+
+    if (!CheckNearest(tree, location, rand() % 2000))
+      return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(14);
+
+  TestTree tree;
+  ok1(tree.empty());
+  ok1(CheckQueries(tree));
+
+  for (unsigned i = 0; i < N; ++i)
+    tree.insert(RandomBox(i));
+
+  ok1(tree.size() == N);
+
+  // queries before Optimise() fall back to a linear scan
+  ok1(CheckQueries(tree));
+
+  tree.Optimise();
+  ok1(tree.size() == N);
+  ok1(CheckQueries(tree));
+
+  // remove every third box and rebuild
+  unsigned removed = 0;
+  for (unsigned i = 0; i < N; i += 3)
+    if (tree.Remove(DummyBox(i)))
+      ++removed;
+
+  ok1(removed == (N + 2) / 3);
+  ok1(!tree.Remove(DummyBox(0)));
+  ok1(tree.size() == N - removed);
+  ok1(CheckQueries(tree));
+
+  tree.Optimise();
+  ok1(CheckQueries(tree));
+
+  // a tree with a single value
+  TestTree single;
+  single.insert(TestBox(FlatGeoPoint(10, 10), FlatGeoPoint(20, 20), 1));
+  single.Optimise();
+  ok1(CheckQueries(single));
+  ok1(single.FindNearestIf(FlatGeoPoint(15, 15), 0,
+                           OddPredicate()).second == 0);
+
+  tree.clear();
+  ok1(tree.empty());
+
+  return exit_status();
+}
@@ -0,0 +1,141 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Logger/IGCFileWriter.hpp"
+#include "Logger/LoggerGRecord.hpp"
+#include "OS/FileUtil.hpp"
+#include "TestUtil.hpp"
+
+#include <string>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+
+static const char *const records[] = {
+  "B1122385103117N00742367EA004900048700000",
+  "B1122435103117N00742367EA004900048700000",
+  "B1122485103117N00742367EA004900048700000",
+};
+
+static const char prefix[] = "AXCSFOO\n";
+
+static std::string
+ReadFile(const char *path)
+{
+  std::string result;
+  FILE *file = fopen(path, "rb");
+  if (file == NULL)
+    return result;
+
+  char buffer[256];
+  size_t nbytes;
+  while ((nbytes = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    result.append(buffer, nbytes);
+
+  fclose(file);
+  return result;
+}
+
+static void
+GetDigest(GRecord &grecord, char *digest)
+{
+  grecord.FinalizeBuffer();
+  grecord.GetDigest(digest);
+}
+
+/**
+ * Limit the file size, so flushing the batch fails after writing
+ * part of it.
+ */
+static bool
+SetFileSizeLimit(rlim_t limit)
+{
+  struct rlimit rl;
+  if (getrlimit(RLIMIT_FSIZE, &rl) != 0)
+    return false;
+
+  rl.rlim_cur = limit;
+  return setrlimit(RLIMIT_FSIZE, &rl) == 0;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(7);
+
+  const char *path = "output/test/TestIGCFileWriter.igc";
+  File::Delete(path);
+
+  FILE *file = fopen(path, "wb");
+  if (file == NULL || fputs(prefix, file) < 0 || fclose(file) != 0) {
+    skip(7, 0, "Failed to create file");
+    return exit_status();
+  }
+
+  GRecord grecord, expected_grecord;
+  grecord.Initialize();
+  expected_grecord.Initialize();
+
+  std::string expected(prefix);
+  IGCFileWriter::Batch batch;
+  for (unsigned i = 0; i < 3; ++i) {
+    strcpy(batch.Append(), records[i]);
+    expected_grecord.AppendRecordToBuffer(records[i]);
+    expected.append(records[i]);
+    expected.push_back('\n');
+  }
+
+  {
+    IGCFileWriter writer(path, grecord);
+
+    /* exceeding the limit shall fail the write instead of killing
+       the process */
+    signal(SIGXFSZ, SIG_IGN);
+    /* the limit applies to redirected test output, too */
+    fflush(stdout);
+    const bool limited = SetFileSizeLimit(strlen(prefix) + 50);
+    const bool submitted = writer.Submit(batch, true);
+    const bool written = writer.Wait();
+    SetFileSizeLimit(RLIM_INFINITY);
+
+    ok1(limited);
+    ok1(submitted);
+    ok1(!written);
+
+    /* the retry truncates the partially written batch and writes all
+       of it again */
+    IGCFileWriter::Batch empty;
+    ok1(writer.Submit(empty));
+    ok1(writer.Wait());
+  }
+
+  ok1(ReadFile(path) == expected);
+
+  /* the failed attempt did not feed the G record */
+  char digest[GRecord::DIGEST_LENGTH];
+  char expected_digest[GRecord::DIGEST_LENGTH];
+  GetDigest(grecord, digest);
+  GetDigest(expected_grecord, expected_digest);
+  ok1(strcmp(digest, expected_digest) == 0);
+
+  return exit_status();
+}
@@ -0,0 +1,185 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thread/JobGraph.hpp"
+#include "Thread/Mutex.hpp"
+#include "OS/Sleep.h"
+#include "TestUtil.hpp"
+
+/**
+ * Records the order in which the jobs have started and finished.
+ */
+struct Log {
+  Mutex mutex;
+  unsigned sequence;
+
+  Log():sequence(0) {}
+
+  unsigned Next() {
+    ScopeLock protect(mutex);
+    return sequence++;
+  }
+};
+
+class TestJob : public JobGraph::Job {
+  Log &log;
+  unsigned sleep;
+
+public:
+  unsigned started, finished;
+
+  TestJob(Log &_log, unsigned _sleep)
+    :log(_log), sleep(_sleep), started(0), finished(0) {}
+
+  virtual void Run(OperationEnvironment &env) {
+    started = log.Next();
+
+    env.SetText(_T("Working"));
+    env.SetProgressRange(4);
+    for (unsigned i = 0; i < 4; ++i) {
+      Sleep(sleep / 4);
+      env.SetProgressPosition(i + 1);
+    }
+
+    finished = log.Next();
+  }
+};
+
+/**
+ * Reports a number of errors.
+ */
+class ErrorJob : public JobGraph::Job {
+  unsigned n_errors;
+
+public:
+  ErrorJob(unsigned _n_errors):n_errors(_n_errors) {}
+
+  virtual void Run(OperationEnvironment &env) {
+    for (unsigned i = 0; i < n_errors; ++i)
+      env.SetErrorMessage(_T("Error"));
+  }
+};
+
+class TestEnvironment : public NullOperationEnvironment {
+public:
+  unsigned range, max_position, n_texts, n_errors;
+
+  TestEnvironment():range(0), max_position(0), n_texts(0), n_errors(0) {}
+
+  virtual void SetErrorMessage(const TCHAR *text) {
+    ++n_errors;
+  }
+
+  virtual void SetText(const TCHAR *text) {
+    ++n_texts;
+  }
+
+  virtual void SetProgressRange(unsigned _range) {
+    range = _range;
+  }
+
+  virtual void SetProgressPosition(unsigned position) {
+    if (position > max_position)
+      max_position = position;
+  }
+};
+
+static void
+TestGraph(unsigned n_threads)
+{
+  /* a diamond with an independent job on the side:
+     a -> b, a -> c, b + c -> d; e */
+
+  Log log;
+  TestJob a(log, 40), b(log, 80), c(log, 20), d(log, 20), e(log, 100);
+
+  JobGraph graph;
+  const unsigned ia = graph.Add(_T("a"), a);
+  const unsigned ib = graph.Add(_T("b"), b, 2);
+  const unsigned ic = graph.Add(_T("c"), c);
+  const unsigned id = graph.Add(_T("d"), d);
+  graph.Add(_T("e"), e);
+
+  graph.AddDependency(ib, ia);
+  graph.AddDependency(ic, ia);
+  graph.AddDependency(id, ib);
+  graph.AddDependency(id, ic);
+
+  TestEnvironment env;
+  graph.Run(env, n_threads);
+
+  ok1(graph.GetJobCount() == 5);
+  ok1(b.started > a.finished && c.started > a.finished);
+  ok1(d.started > b.finished && d.started > c.finished);
+  ok1(log.sequence == 10);
+
+  if (n_threads == 0) {
+    /* the calling thread runs the jobs in order, and passes its own
+       environment */
+    ok1(e.started > d.finished);
+    ok1(env.n_texts == 5 && env.range == 4 && env.max_position == 4);
+  } else {
+    /* "e" runs in parallel with the others */
+    ok1(e.started < d.finished);
+    ok1(env.n_texts > 0 && env.range > 0 && env.max_position <= env.range);
+  }
+
+  ok1(graph.GetStartTime(id) >=
+      graph.GetStartTime(ib) + graph.GetDuration(ib));
+}
+
+static void
+TestErrors(unsigned n_threads)
+{
+  Log log;
+  TestJob a(log, 20);
+  ErrorJob b(1), c(JobGraph::MAX_ERRORS + 2);
+
+  JobGraph graph;
+  graph.Add(_T("a"), a);
+  graph.Add(_T("b"), b);
+  graph.Add(_T("c"), c);
+
+  TestEnvironment env;
+  graph.Run(env, n_threads);
+
+  if (n_threads == 0)
+    /* the calling thread passes its own environment */
+    ok1(env.n_errors == JobGraph::MAX_ERRORS + 3);
+  else
+    /* errors from worker threads are queued, up to MAX_ERRORS per
+       job, and delivered by Run() */
+    ok1(env.n_errors == 1 + JobGraph::MAX_ERRORS);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(16);
+
+  TestGraph(0);
+  TestGraph(3);
+  TestErrors(0);
+  TestErrors(2);
+
+  return exit_status();
+}
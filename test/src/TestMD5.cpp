@@ -0,0 +1,137 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Logger/MD5.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <string.h>
+
+static void
+TestKnown()
+{
+  MD5 md5;
+  char digest[MD5::DIGEST_LENGTH * 2 + 1];
+
+  md5.InitKey(0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476);
+  md5.Finalize();
+  md5.GetDigest(digest);
+  ok1(strcmp(digest, "d41d8cd98f00b204e9800998ecf8427e") == 0);
+
+  md5.InitKey(0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476);
+  md5.AppendString((const unsigned char *)"abc", 0);
+  md5.Finalize();
+  md5.GetDigest(digest);
+  ok1(strcmp(digest, "900150983cd24fb0d6963f7d28e17f72") == 0);
+
+  MD5x4 md5x4;
+  md5x4.InitDigest();
+  for (unsigned lane = 0; lane < MD5x4::LANES; ++lane)
+    md5x4.InitKey(lane, 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476);
+  md5x4.AppendString((const unsigned char *)"abc", 0);
+  md5x4.Finalize();
+
+  bool success = true;
+  for (unsigned lane = 0; lane < MD5x4::LANES; ++lane) {
+    md5x4.GetDigest(lane, digest);
+    if (strcmp(digest, "900150983cd24fb0d6963f7d28e17f72") != 0)
+      success = false;
+  }
+
+  ok1(success);
+}
+
+static const uint32_t keys[MD5x4::LANES][4] = {
+  { 0x1C80A301, 0x9EB30b89, 0x39CB2Afe, 0x0D0FEA76 },
+  { 0x48327203, 0x3948ebea, 0x9a9b9c9e, 0xb3bed89a },
+  { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 },
+  { 0xc8e899e8, 0x9321c28a, 0x438eba12, 0x8cbe0aee },
+};
+
+/**
+ * Compare the lanes of #MD5x4 with four #MD5 instances, with
+ * messages of all lengths around the block size.
+ */
+static void
+TestLanes(int skip_invalid_igc_chars)
+{
+  /* contains characters which are not valid in IGC files */
+  static const char line[] =
+    "B1234565123456N00123456EA0012300145*$,!\\^~\r\n";
+
+  bool success = true;
+  for (unsigned n = 0; n < 200; ++n) {
+    MD5 md5[MD5x4::LANES];
+    MD5x4 md5x4;
+    md5x4.InitDigest();
+    for (unsigned lane = 0; lane < MD5x4::LANES; ++lane) {
+      md5[lane].InitDigest();
+      md5[lane].InitKey(keys[lane][0], keys[lane][1],
+                        keys[lane][2], keys[lane][3]);
+      md5x4.InitKey(lane, keys[lane][0], keys[lane][1],
+                    keys[lane][2], keys[lane][3]);
+    }
+
+    /* feed n characters, in pieces of varying length */
+    char buffer[sizeof(line)];
+    for (unsigned i = 0, length = 1; i < n; i += length, ++length) {
+      if (length >= sizeof(line))
+        length = 1;
+
+      const unsigned chunk = std::min(length, n - i);
+      memcpy(buffer, line, chunk);
+      buffer[chunk] = 0;
+
+      for (unsigned lane = 0; lane < MD5x4::LANES; ++lane)
+        md5[lane].AppendString((const unsigned char *)buffer,
+                               skip_invalid_igc_chars);
+      md5x4.AppendString((const unsigned char *)buffer,
+                         skip_invalid_igc_chars);
+    }
+
+    md5x4.Finalize();
+    for (unsigned lane = 0; lane < MD5x4::LANES; ++lane) {
+      md5[lane].Finalize();
+
+      char expected[MD5::DIGEST_LENGTH * 2 + 1];
+      char digest[MD5::DIGEST_LENGTH * 2 + 1];
+      md5[lane].GetDigest(expected);
+      md5x4.GetDigest(lane, digest);
+      if (strcmp(digest, expected) != 0)
+        success = false;
+    }
+  }
+
+  ok1(success);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(5);
+
+  TestKnown();
+  TestLanes(0);
+  TestLanes(1);
+
+  return exit_status();
+}
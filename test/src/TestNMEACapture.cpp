@@ -0,0 +1,177 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Logger/NMEACapture.hpp"
+#include "Util/Macros.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <vector>
+#include <string.h>
+
+/**
+ * A #Source which reads from a memory buffer in small portions, to
+ * exercise the handling of incomplete records.  It works on a copy of
+ * the data, because #Source hands out writable ranges.
+ */
+class MemorySource : public Source<char> {
+  std::vector<char> data;
+  unsigned position, window;
+
+public:
+  MemorySource(const std::vector<uint8_t> &_data, unsigned _window)
+    :data(_data.begin(), _data.end()), position(0), window(_window) {}
+
+  virtual Range read() {
+    /* grow the window on each call, like a refilling buffer */
+    window += 7;
+    unsigned length = std::min((unsigned)data.size() - position, window);
+    return Range(&data[0] + position, length);
+  }
+
+  virtual void consume(unsigned n) {
+    position += n;
+    window = 1;
+  }
+};
+
+static const struct {
+  unsigned time, device;
+  const char *line;
+} lines[] = {
+  { 0, 0, "$GPRMC,120000,A,5112.0000,N,00708.0000,E,50.0,90.0,010112,,*2D" },
+  { 10, 0, "$GPGGA,120000,5112.0000,N,00708.0000,E,1,08,1.0,300.0,M,48.0,M,,*4A" },
+  { 15, 1, "$PFLAU,2,1,2,1,0,,0,,*63" },
+  { 1000, 0, "$GPRMC,120001,A,5112.0010,N,00708.0020,E,50.0,90.0,010112,,*2D" },
+  { 1010, 0, "$GPGGA,120001,5112.0010,N,00708.0020,E,1,08,1.0,301.0,M,48.0,M,,*4B" },
+  { 1015, 1, "$PFLAU,2,1,2,1,0,,0,,*63" },
+  { 1020, 2, "" },
+  { 1020, 2, "no commas" },
+  { 1020, 2, ",,," },
+  { 1500, 15, "$LXWP0,Y,119.4,1717.6,0.02,0.02,0.02,0.02,0.02,0.02,,000,107.2*5b" },
+  { 90000, 0, "$GPRMC,120130,A,5112.0010,N,00708.0020,E,50.0,90.0,010112,,*2E" },
+};
+
+static void
+Encode(std::vector<uint8_t> &data)
+{
+  data.assign(NMEACapture::MAGIC,
+              NMEACapture::MAGIC + sizeof(NMEACapture::MAGIC));
+
+  NMEACapture::Encoder encoder;
+  uint8_t buffer[NMEACapture::MAX_RECORD_SIZE];
+  for (unsigned i = 0; i < ARRAY_SIZE(lines); ++i) {
+    size_t length = encoder.Encode(buffer, lines[i].time, lines[i].device,
+                                   lines[i].line, strlen(lines[i].line));
+    data.insert(data.end(), buffer, buffer + length);
+  }
+}
+
+static void
+TestRoundTrip()
+{
+  std::vector<uint8_t> data;
+  Encode(data);
+
+  size_t total = 0;
+  for (unsigned i = 0; i < ARRAY_SIZE(lines); ++i)
+    total += strlen(lines[i].line) + 1;
+
+  /* repeated sentences share most of their fields */
+  ok1(data.size() < total);
+
+  MemorySource source(data, 1);
+  NMEACapture::Reader reader(source);
+  NMEACapture::Record record;
+
+  bool success = true;
+  for (unsigned i = 0; i < ARRAY_SIZE(lines); ++i) {
+    if (!reader.Read(record) ||
+        record.time != lines[i].time ||
+        record.device != lines[i].device ||
+        record.length != strlen(lines[i].line) ||
+        strcmp(record.line, lines[i].line) != 0)
+      success = false;
+  }
+
+  ok1(success);
+  ok1(!reader.Read(record));
+}
+
+static void
+TestLongLine()
+{
+  char line[NMEACapture::MAX_LINE_LENGTH * 2 + 1];
+  for (unsigned i = 0; i < sizeof(line) - 1; ++i)
+    line[i] = i % 3 == 0 ? ',' : 'a' + i % 26;
+  line[sizeof(line) - 1] = 0;
+
+  NMEACapture::Encoder encoder;
+  uint8_t buffer[NMEACapture::MAX_RECORD_SIZE];
+  size_t length = encoder.Encode(buffer, 0, 3, line, strlen(line));
+  ok1(length <= NMEACapture::MAX_RECORD_SIZE);
+
+  NMEACapture::Decoder decoder;
+  NMEACapture::Record record;
+  ok1(decoder.Decode(buffer, length, record) == (int)length);
+  ok1(record.length == NMEACapture::MAX_LINE_LENGTH);
+  ok1(memcmp(record.line, line, NMEACapture::MAX_LINE_LENGTH) == 0);
+
+  /* an incomplete record */
+  NMEACapture::Decoder decoder2;
+  ok1(decoder2.Decode(buffer, length - 1, record) == 0);
+}
+
+static void
+TestMalformed()
+{
+  std::vector<uint8_t> data;
+  Encode(data);
+
+  /* wrong magic */
+  data[0] = 'Y';
+  MemorySource source(data, 1);
+  NMEACapture::Reader reader(source);
+  NMEACapture::Record record;
+  ok1(!reader.Read(record));
+
+  /* truncated file */
+  Encode(data);
+  data.resize(data.size() - 3);
+  MemorySource source2(data, 1);
+  NMEACapture::Reader reader2(source2);
+  unsigned n = 0;
+  while (reader2.Read(record))
+    ++n;
+  ok1(n == ARRAY_SIZE(lines) - 1);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(10);
+
+  TestRoundTrip();
+  TestLongLine();
+  TestMalformed();
+
+  return exit_status();
+}
@@ -0,0 +1,149 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Logger/NMEACaptureWriter.hpp"
+#include "Logger/NMEACapture.hpp"
+#include "OS/FileUtil.hpp"
+#include "Util/Macros.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+
+/**
+ * A #Source which reads all of a memory buffer at once.
+ */
+class MemorySource : public Source<char> {
+  std::vector<char> data;
+  unsigned position;
+
+public:
+  MemorySource(const std::vector<char> &_data)
+    :data(_data), position(0) {}
+
+  virtual Range read() {
+    return Range(&data[0] + position, data.size() - position);
+  }
+
+  virtual void consume(unsigned n) {
+    position += n;
+  }
+};
+
+static const char *const lines[] = {
+  "$GPRMC,120000,A,5112.0000,N,00708.0000,E,50.0,90.0,010112,,*2D",
+  "$GPGGA,120000,5112.0000,N,00708.0000,E,1,08,1.0,300.0,M,48.0,M,,*4A",
+  "$GPRMC,120001,A,5112.0010,N,00708.0020,E,50.0,90.0,010112,,*2D",
+  "$GPGGA,120001,5112.0010,N,00708.0020,E,1,08,1.0,301.0,M,48.0,M,,*4B",
+  "$GPRMC,120002,A,5112.0020,N,00708.0040,E,50.0,90.0,010112,,*2D",
+  "$GPGGA,120002,5112.0020,N,00708.0040,E,1,08,1.0,302.0,M,48.0,M,,*48",
+};
+
+static bool
+ReadFile(const char *path, std::vector<char> &data)
+{
+  FILE *file = fopen(path, "rb");
+  if (file == NULL)
+    return false;
+
+  char buffer[256];
+  size_t nbytes;
+  while ((nbytes = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    data.insert(data.end(), buffer, buffer + nbytes);
+
+  fclose(file);
+  return true;
+}
+
+/**
+ * Limit the file size, so writing the buffer fails after writing
+ * part of it.
+ */
+static bool
+SetFileSizeLimit(rlim_t limit)
+{
+  struct rlimit rl;
+  if (getrlimit(RLIMIT_FSIZE, &rl) != 0)
+    return false;
+
+  rl.rlim_cur = limit;
+  return setrlimit(RLIMIT_FSIZE, &rl) == 0;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(6);
+
+  const char *path = "output/test/TestNMEACaptureWriter.ncap";
+  File::Delete(path);
+
+  {
+    NMEACaptureWriter writer(path);
+
+    /* exceeding the limit shall fail the write instead of killing
+       the process */
+    signal(SIGXFSZ, SIG_IGN);
+    /* the limit applies to redirected test output, too */
+    fflush(stdout);
+    const bool limited = SetFileSizeLimit(sizeof(NMEACapture::MAGIC) + 20);
+
+    for (unsigned i = 0; i < 4; ++i)
+      writer.Write(0, lines[i]);
+
+    /* this buffer fails in the background */
+    writer.Flush();
+
+    /* these records are delta compressed against the failed ones */
+    for (unsigned i = 4; i < ARRAY_SIZE(lines); ++i)
+      writer.Write(0, lines[i]);
+
+    const bool failed = !writer.Flush();
+    SetFileSizeLimit(RLIM_INFINITY);
+
+    ok1(limited);
+    ok1(failed);
+
+    /* the failed buffer is written again, before the new one */
+    ok1(writer.Flush());
+  }
+
+  std::vector<char> data;
+  ok1(ReadFile(path, data));
+
+  MemorySource source(data);
+  NMEACapture::Reader reader(source);
+  NMEACapture::Record record;
+
+  bool success = true;
+  for (unsigned i = 0; i < ARRAY_SIZE(lines); ++i)
+    if (!reader.Read(record) || record.device != 0 ||
+        strcmp(record.line, lines[i]) != 0)
+      success = false;
+
+  ok1(success);
+  ok1(!reader.Read(record));
+
+  return exit_status();
+}
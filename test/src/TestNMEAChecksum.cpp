@@ -0,0 +1,106 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "NMEA/Checksum.hpp"
+#include "TestUtil.hpp"
+
+#include <string.h>
+
+/**
+ * The straightforward byte-by-byte checksum, to compare the
+ * optimised implementation with.
+ */
+static unsigned char
+ReferenceChecksum(const char *p, unsigned length)
+{
+  unsigned char checksum = 0;
+  for (unsigned i = (length > 0 && (*p == '$' || *p == '!')); i < length; ++i)
+    checksum ^= p[i];
+  return checksum;
+}
+
+static void
+TestLengths()
+{
+  static const char line[] =
+    "$PFLAA,0,-1234,1234,220,2,DD8F12,180,,30,-1.4,1*";
+
+  /* all lengths and alignments, to cover the word loop and the
+     remaining bytes */
+  bool success = true;
+  for (unsigned start = 0; start < 8; ++start)
+    for (unsigned length = 0; start + length < sizeof(line); ++length)
+      if (NMEAChecksum(line + start, length) !=
+          ReferenceChecksum(line + start, length))
+        success = false;
+
+  ok1(success);
+
+  ok1(NMEAChecksum("$GPGGA,1,2,3") == NMEAChecksum("$GPGGA,1,2,3", 12));
+  ok1(NMEAChecksum("!GPGGA,1,2,3", 12) == NMEAChecksum("GPGGA,1,2,3", 11));
+  ok1(NMEAChecksum("", 0) == 0);
+}
+
+static void
+TestVerify()
+{
+  ok1(VerifyNMEAChecksum("$GPRMC,175956,A,4754.8316,N,01110.6332,E,031.8,278,030203*04"));
+  ok1(VerifyNMEAChecksum("$PGRMZ,166,m*0E"));
+  ok1(VerifyNMEAChecksum("$PGRMZ,166,m*0e"));
+  ok1(!VerifyNMEAChecksum("$PGRMZ,166,m*0F"));
+  ok1(!VerifyNMEAChecksum("$PGRMZ,167,m*0E"));
+  ok1(!VerifyNMEAChecksum("$PGRMZ,166,m"));
+  ok1(!VerifyNMEAChecksum("$PGRMZ,166,m*"));
+  ok1(!VerifyNMEAChecksum("$PGRMZ,166,m*0E0"));
+  ok1(!VerifyNMEAChecksum("$PGRMZ,166,m*0G"));
+  ok1(!VerifyNMEAChecksum("$PGRMZ,166,m*0E\r"));
+
+  /* a single digit is accepted */
+  ok1(VerifyNMEAChecksum("$GPRMC,175956,A,4754.8316,N,01110.6332,E,031.8,278,030203*4"));
+
+  /* anything else strtoul() accepts, as long as the value is
+     smaller than 0x100 */
+  ok1(VerifyNMEAChecksum("$PGRMZ,166,m*00E"));
+  ok1(VerifyNMEAChecksum("$PGRMZ,166,m*0x0E"));
+  ok1(VerifyNMEAChecksum("$PGRMZ,166,m* 0E"));
+  ok1(!VerifyNMEAChecksum("$PGRMZ,166,m*10E"));
+  ok1(!VerifyNMEAChecksum("$PGRMZ,166,m*-0E"));
+
+  /* the last asterisk separates the checksum */
+  ok1(VerifyNMEAChecksum("$PGRMZ,166,m*0E*51"));
+
+  char buffer[64];
+  strcpy(buffer, "$PFLAU,3,1,2,1,0,,0,,");
+  AppendNMEAChecksum(buffer);
+  ok1(VerifyNMEAChecksum(buffer));
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(22);
+
+  TestLengths();
+  TestVerify();
+
+  return exit_status();
+}
@@ -0,0 +1,124 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "NMEA/Sentence.hpp"
+#include "NMEA/InputLine.hpp"
+#include "TestUtil.hpp"
+
+#include <string>
+#include <vector>
+#include <string.h>
+
+struct CollectHandler : public NMEASentenceHandler {
+  std::vector<std::string> lines;
+  std::vector<bool> valid;
+
+  virtual void SentenceReceived(const NMEASentence &sentence) {
+    lines.push_back(std::string(sentence.line, sentence.length));
+    valid.push_back(sentence.checksum_valid);
+  }
+};
+
+static void
+TestSplit()
+{
+  char buffer[] = "$PGRMZ,166,m*0E\r\n\n$PGRMZ,166,m*0F \r\n$GPR";
+  const size_t length = strlen(buffer);
+
+  CollectHandler handler;
+  const size_t consumed = SplitNMEA(buffer, length, handler);
+
+  /* the incomplete line remains in the buffer */
+  ok1(consumed == length - 4);
+  ok1(handler.lines.size() == 3);
+  ok1(handler.lines[0] == "$PGRMZ,166,m*0E");
+  ok1(handler.valid[0]);
+  /* empty lines are passed to the handler, too */
+  ok1(handler.lines[1].empty());
+  ok1(handler.lines[2] == "$PGRMZ,166,m*0F");
+  ok1(!handler.valid[2]);
+}
+
+static void
+TestParse()
+{
+  NMEASentence sentence;
+  sentence.Parse("$PGRMZ,166,m*0E");
+  ok1(sentence.length == 15);
+  ok1(sentence.asterisk == 12);
+  ok1(sentence.checksum_valid);
+  ok1(sentence.n_separators == 2);
+  ok1(sentence.separators[0] == 6 && sentence.separators[1] == 10);
+
+  sentence.Parse("$PGRMZ,166,m");
+  ok1(sentence.asterisk == sentence.length);
+  ok1(!sentence.checksum_valid);
+
+  /* commas after the asterisk are not separators */
+  sentence.Parse("$A,1*2,3");
+  ok1(sentence.n_separators == 1);
+  ok1(sentence.asterisk == 4);
+}
+
+static void
+TestInputLine()
+{
+  NMEASentence sentence;
+  sentence.Parse("$PGRMZ,166,m*0E");
+
+  NMEAInputLine line(sentence);
+  ok1(line.read_compare("$PGRMZ"));
+  ok1(line.read(0) == 166);
+  ok1(line.read_first_char() == 'm');
+  ok1(line.read(-1) == -1);
+
+  /* more fields than separator slots: skip() falls back to memchr */
+  std::string s = "$X";
+  for (unsigned i = 1; i <= 60; ++i) {
+    char field[8];
+    snprintf(field, sizeof(field), ",%u", i);
+    s += field;
+  }
+
+  sentence.Parse(s.c_str());
+  ok1(sentence.n_separators == NMEASentence::MAX_SEPARATORS);
+
+  NMEAInputLine line2(sentence);
+  line2.skip(NMEASentence::MAX_SEPARATORS + 5);
+  ok1(line2.read(0) == 53);
+  line2.skip(5);
+  ok1(line2.read(0) == 59);
+  ok1(line2.read(0) == 60);
+  ok1(line2.read(-1) == -1);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(25);
+
+  TestSplit();
+  TestParse();
+  TestInputLine();
+
+  return exit_status();
+}
@@ -0,0 +1,151 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Engine/Navigation/ConvexHull/PolygonSlabs.hpp"
+#include "Engine/Navigation/ConvexHull/PolygonInterior.hpp"
+#include "Engine/Navigation/SearchPoint.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+
+static double
+RandomDouble()
+{
+  return (rand() % 10000) / 10000.;
+}
+
+static GeoPoint
+RandomLocation()
+{
+  return GeoPoint(Angle::Degrees(fixed(6.8 + 0.4 * RandomDouble())),
+                  Angle::Degrees(fixed(46.8 + 0.4 * RandomDouble())));
+}
+
+/**
+ * Generate a closed, jagged (non-convex) polygon around a center
+ * point.
+ */
+static std::vector<SearchPoint>
+MakePolygon(unsigned n)
+{
+  std::vector<SearchPoint> v;
+  for (unsigned i = 0; i < n; ++i) {
+    const double a = 2 * M_PI * i / n;
+    const double r = 0.05 + 0.1 * RandomDouble();
+    v.push_back(SearchPoint(GeoPoint(Angle::Degrees(fixed(7 + r * cos(a))),
+                                     Angle::Degrees(fixed(47 + r * sin(a))))));
+  }
+
+  v.push_back(v.front());
+  return v;
+}
+
+/**
+ * Compare the slab based PolygonInterior() with the full scan.
+ */
+static bool
+CheckInside(const std::vector<SearchPoint> &v, const PolygonSlabs &slabs)
+{
+  for (unsigned i = 0; i < 1000; ++i) {
+    const GeoPoint p = RandomLocation();
+    const auto range = slabs.Lookup(p.latitude);
+    if (PolygonInterior(p, v, range.first, range.second) !=
+        PolygonInterior(p, v))
+      return false;
+  }
+
+  /* also try the vertices, which lie exactly on slab boundaries */
+  for (auto i = v.begin(); i != v.end(); ++i) {
+    const GeoPoint &p = i->get_location();
+    const auto range = slabs.Lookup(p.latitude);
+    if (PolygonInterior(p, v, range.first, range.second) !=
+        PolygonInterior(p, v))
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * Check that Collect() returns every edge overlapping a latitude
+ * range exactly once.
+ */
+static bool
+CheckCollect(const std::vector<SearchPoint> &v, const PolygonSlabs &slabs)
+{
+  std::vector<unsigned> edges;
+
+  for (unsigned i = 0; i < 200; ++i) {
+    Angle a = RandomLocation().latitude, b = RandomLocation().latitude;
+    if (b < a)
+      std::swap(a, b);
+
+    slabs.Collect(a, b, edges);
+
+    std::vector<unsigned> sorted(edges);
+    std::sort(sorted.begin(), sorted.end());
+    if (std::unique(sorted.begin(), sorted.end()) != sorted.end())
+      return false;
+
+    for (unsigned j = 0; j + 1 < v.size(); ++j) {
+      const Angle c = v[j].get_location().latitude;
+      const Angle d = v[j + 1].get_location().latitude;
+      if (std::max(c, d) < a || std::min(c, d) > b)
+        continue;
+
+      if (!std::binary_search(sorted.begin(), sorted.end(), j))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(8);
+
+  PolygonSlabs slabs;
+  ok1(!slabs.IsDefined());
+
+  const std::vector<SearchPoint> small = MakePolygon(PolygonSlabs::MIN_EDGES);
+  slabs.Build(small);
+  ok1(slabs.IsDefined());
+  ok1(CheckInside(small, slabs));
+  ok1(CheckCollect(small, slabs));
+
+  const std::vector<SearchPoint> large = MakePolygon(3000);
+  slabs.Build(large);
+  ok1(CheckInside(large, slabs));
+  ok1(CheckCollect(large, slabs));
+
+  // outside of the polygon's latitude range
+  const auto range = slabs.Lookup(Angle::Degrees(fixed(40)));
+  ok1(range.first == range.second);
+
+  slabs.Clear();
+  ok1(!slabs.IsDefined());
+
+  return exit_status();
+}
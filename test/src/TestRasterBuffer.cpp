@@ -0,0 +1,89 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Terrain/RasterBuffer.hpp"
+#include "Terrain/RasterLocation.hpp"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+
+static const unsigned WIDTH = 37, HEIGHT = 23;
+static const unsigned N = 1000;
+
+/**
+ * Verify that the batch GetInterpolated() yields exactly the same
+ * results as the scalar version.
+ */
+static bool
+CompareInterpolated(const RasterBuffer &buffer)
+{
+  RasterLocation locations[N];
+  for (unsigned i = 0; i < N; ++i)
+    locations[i] = RasterLocation(rand() % (WIDTH << 8),
+                                  rand() % (HEIGHT << 8));
+
+  /* include the borders */
+  locations[0] = RasterLocation(0, 0);
+  locations[1] = RasterLocation((WIDTH << 8) - 1, (HEIGHT << 8) - 1);
+  locations[2] = RasterLocation((WIDTH << 8) - 1, 0);
+  locations[3] = RasterLocation(0, (HEIGHT << 8) - 1);
+
+  short batch[N];
+  buffer.GetInterpolated(locations, batch, N);
+
+  for (unsigned i = 0; i < N; ++i)
+    if (batch[i] != buffer.GetInterpolated(locations[i].x,
+                                           locations[i].y))
+      return false;
+
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(3);
+
+  RasterBuffer buffer(WIDTH, HEIGHT);
+  short *data = buffer.GetData();
+
+  /* smooth positive terrain */
+  for (unsigned i = 0; i < WIDTH * HEIGHT; ++i)
+    data[i] = 1000 + rand() % 3000;
+  ok1(CompareInterpolated(buffer));
+
+  /* extreme values, including negative heights */
+  for (unsigned i = 0; i < WIDTH * HEIGHT; ++i)
+    data[i] = (rand() % 0x10000) - 0x8000;
+  ok1(CompareInterpolated(buffer));
+
+  /* water and invalid heights */
+  for (unsigned i = 0; i < WIDTH * HEIGHT; ++i)
+    data[i] = rand() % 5 == 0
+      ? (rand() % 2 == 0
+         ? RasterBuffer::TERRAIN_INVALID
+         : RasterBuffer::TERRAIN_WATER_THRESHOLD)
+      : (short)(rand() % 4000);
+  ok1(CompareInterpolated(buffer));
+
+  return exit_status();
+}
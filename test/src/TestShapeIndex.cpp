@@ -0,0 +1,196 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Topography/ShapeIndex.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <stdlib.h>
+
+static const unsigned N = 2000;
+
+static ShapeIndex::Rectangle boxes[N];
+
+/* every tenth shape is a null shape, which is not indexed */
+static bool
+IsNullShape(unsigned i)
+{
+  return i % 10 == 3;
+}
+
+static double
+RandomDegrees(double min, double max)
+{
+  return min + (max - min) * rand() / RAND_MAX;
+}
+
+static ShapeIndex::Rectangle
+RandomRectangle(double max_size)
+{
+  const double west = RandomDegrees(5, 15), south = RandomDegrees(45, 50);
+  return ShapeIndex::Rectangle::FromDegrees(west, south,
+                                            west + RandomDegrees(0, max_size),
+                                            south + RandomDegrees(0, max_size));
+}
+
+static void
+Fill(ShapeIndex &index)
+{
+  index.Clear(N);
+
+  for (unsigned i = 0; i < N; ++i) {
+    /* a few large shapes which overlap many others */
+    boxes[i] = RandomRectangle(i % 50 == 0 ? 3 : 0.05);
+    if (!IsNullShape(i))
+      index.Add(i, boxes[i]);
+  }
+
+  index.Build();
+}
+
+static void
+BruteForce(const ShapeIndex::Rectangle &rectangle, std::vector<unsigned> &dest)
+{
+  dest.clear();
+  for (unsigned i = 0; i < N; ++i)
+    if (!IsNullShape(i) && boxes[i].Overlaps(rectangle))
+      dest.push_back(i);
+}
+
+/**
+ * Run random queries and compare the results with a linear scan.
+ */
+static bool
+CheckQueries(const ShapeIndex &index)
+{
+  std::vector<unsigned> result, expected;
+  for (unsigned i = 0; i < 100; ++i) {
+    const ShapeIndex::Rectangle rectangle = RandomRectangle(1);
+    index.Query(rectangle, result);
+    BruteForce(rectangle, expected);
+    if (result != expected)
+      return false;
+  }
+
+  return true;
+}
+
+static void
+TestFromDegrees()
+{
+  const ShapeIndex::Rectangle r =
+    ShapeIndex::Rectangle::FromDegrees(-7.1, 50.3, 8.25, 51);
+
+  /* rounded outwards */
+  ok1(r.west <= -7.1 * ShapeIndex::UNITS_PER_DEGREE &&
+      r.west > -7.1 * ShapeIndex::UNITS_PER_DEGREE - 1);
+  ok1(r.south <= 50.3 * ShapeIndex::UNITS_PER_DEGREE &&
+      r.south > 50.3 * ShapeIndex::UNITS_PER_DEGREE - 1);
+  ok1(r.east == (int32_t)(8.25 * ShapeIndex::UNITS_PER_DEGREE));
+  ok1(r.north == 51 * ShapeIndex::UNITS_PER_DEGREE);
+}
+
+static void
+TestEmpty()
+{
+  ShapeIndex index;
+  index.Clear(10);
+  index.Build();
+
+  std::vector<unsigned> result(1, 42);
+  index.Query(ShapeIndex::Rectangle::FromDegrees(-180, -90, 180, 90), result);
+  ok1(result.empty());
+}
+
+static void
+TestQuery()
+{
+  ShapeIndex index;
+  Fill(index);
+  ok1(index.size() == N - N / 10);
+  ok1(CheckQueries(index));
+
+  /* touching counts as overlapping */
+  std::vector<unsigned> result;
+  ShapeIndex::Rectangle point;
+  point.west = point.east = boxes[5].east;
+  point.south = point.north = boxes[5].north;
+  index.Query(point, result);
+  ok1(std::find(result.begin(), result.end(), 5u) != result.end());
+
+  /* everything */
+  index.Query(ShapeIndex::Rectangle::FromDegrees(-180, -90, 180, 90), result);
+  ok1(result.size() == index.size());
+}
+
+static void
+TestCache()
+{
+  ShapeIndex index;
+  Fill(index);
+
+  FILE *file = tmpfile();
+  ok1(file != NULL);
+  ok1(index.Save(file));
+
+  ShapeIndex loaded;
+  rewind(file);
+  ok1(loaded.Load(file, N));
+  ok1(loaded.size() == index.size());
+  ok1(CheckQueries(loaded));
+
+  /* the shapefile has changed */
+  rewind(file);
+  ok1(!loaded.Load(file, N + 1));
+  ok1(loaded.size() == 0);
+
+  /* a truncated file */
+  fseek(file, 0, SEEK_END);
+  std::vector<char> buffer(ftell(file) / 2);
+  rewind(file);
+  ok1(fread(&buffer.front(), buffer.size(), 1, file) == 1);
+  fclose(file);
+
+  file = tmpfile();
+  fwrite(&buffer.front(), buffer.size(), 1, file);
+  rewind(file);
+  ok1(!loaded.Load(file, N));
+  fclose(file);
+
+  file = tmpfile();
+  fwrite("XXXX", 4, 1, file);
+  rewind(file);
+  ok1(!loaded.Load(file, N));
+  fclose(file);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(19);
+
+  TestFromDegrees();
+  TestEmpty();
+  TestQuery();
+  TestCache();
+
+  return exit_status();
+}
@@ -0,0 +1,181 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Replay/TimeWarpFeeder.hpp"
+#include "OS/Clock.hpp"
+#include "OS/Sleep.h"
+#include "TestUtil.hpp"
+
+/**
+ * Simulates the CalculationThread, which needs a fixed time to
+ * process each fix.
+ */
+class FakeConsumer : public TimeWarpFeeder::Handler {
+  unsigned remaining;
+
+  /**
+   * The time needed to process one fix [ms]; 0 means the consumer
+   * never processes a fix.
+   */
+  unsigned process_ms;
+
+  unsigned fed_time;
+
+public:
+  unsigned fed, processed;
+
+  /**
+   * Has a fix been fed before the previous one was processed?
+   */
+  bool overrun;
+
+  /**
+   * The shortest interval between two fixes [ms].
+   */
+  unsigned min_interval;
+
+  FakeConsumer(unsigned n, unsigned _process_ms)
+    :remaining(n), process_ms(_process_ms), fed_time(0),
+     fed(0), processed(0), overrun(false), min_interval(1000000) {}
+
+  virtual bool FeedFix(bool &_fed) {
+    if (remaining == 0)
+      return false;
+
+    const unsigned now = MonotonicClockMS();
+    if (fed > 0) {
+      if (processed < fed)
+        overrun = true;
+
+      if (now - fed_time < min_interval)
+        min_interval = now - fed_time;
+    }
+
+    --remaining;
+    ++fed;
+    fed_time = now;
+    _fed = true;
+    return true;
+  }
+
+  virtual bool WaitFixProcessed(unsigned timeout_ms) {
+    if (process_ms == 0) {
+      Sleep(timeout_ms);
+      return false;
+    }
+
+    const unsigned elapsed = MonotonicClockMS() - fed_time;
+    const unsigned left = elapsed < process_ms ? process_ms - elapsed : 0;
+    if (left > timeout_ms) {
+      Sleep(timeout_ms);
+      return false;
+    }
+
+    Sleep(left);
+    processed = fed;
+    return true;
+  }
+};
+
+static unsigned
+TimedUpdate(TimeWarpFeeder &feeder, FakeConsumer &consumer, bool &result)
+{
+  const unsigned start = MonotonicClockMS();
+  result = feeder.Update(consumer);
+  return MonotonicClockMS() - start;
+}
+
+static void
+TestFast()
+{
+  TimeWarpFeeder feeder(1000, 1000);
+  FakeConsumer consumer(20, 1);
+
+  bool result;
+  TimedUpdate(feeder, consumer, result);
+  ok1(!result);
+  ok1(feeder.GetFixCount() == 20);
+  ok1(consumer.processed == 20);
+  ok1(!consumer.overrun);
+}
+
+static void
+TestSlow()
+{
+  /* each fix takes longer than the budget: Update() must return in
+     time, and continue waiting in the next call */
+  TimeWarpFeeder feeder(50, 1000);
+  FakeConsumer consumer(3, 120);
+
+  bool result;
+  unsigned max_duration = 0, n_calls = 0;
+  do {
+    const unsigned duration = TimedUpdate(feeder, consumer, result);
+    if (duration > max_duration)
+      max_duration = duration;
+    ++n_calls;
+  } while (result && n_calls < 100);
+
+  ok1(!result);
+  ok1(max_duration < 50 + 40);
+  ok1(n_calls >= 6);
+  ok1(feeder.GetFixCount() == 3);
+  ok1(!consumer.overrun);
+  ok1(consumer.min_interval >= 120);
+}
+
+static void
+TestStuck()
+{
+  /* the consumer never processes a fix: the next one is fed after
+     the timeout */
+  TimeWarpFeeder feeder(50, 200);
+  FakeConsumer consumer(3, 0);
+
+  bool result;
+  unsigned max_duration = 0, n_calls = 0;
+  do {
+    const unsigned duration = TimedUpdate(feeder, consumer, result);
+    if (duration > max_duration)
+      max_duration = duration;
+    ++n_calls;
+  } while (result && n_calls < 100);
+
+  ok1(!result);
+  ok1(max_duration < 50 + 40);
+  ok1(feeder.GetFixCount() == 3);
+  ok1(consumer.min_interval >= 200);
+
+  feeder.Reset();
+  ok1(feeder.GetFixCount() == 0);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(15);
+
+  TestFast();
+  TestSlow();
+  TestStuck();
+
+  return exit_status();
+}
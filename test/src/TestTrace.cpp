@@ -26,6 +26,7 @@
 #include "Engine/Trace/Vector.hpp"
 #include "Engine/Task/TaskStats/CommonStats.hpp"
 #include "Engine/Navigation/Aircraft.hpp"
+#include "OS/Clock.hpp"
 #include "Printing.hpp"
 #include "TestUtil.hpp"
 
@@ -72,6 +73,7 @@ TestTrace(const char *filename, unsigned ntrace, bool output=false)
 
   char *line;
   int i = 0;
+  uint64_t duration = 0;
   for (; (line = reader.read()) != NULL; i++) {
     if (output && (i % 500 == 0)) {
       putchar('.');
@@ -82,13 +84,17 @@ TestTrace(const char *filename, unsigned ntrace, bool output=false)
     if (!IGCParseFix(line, fix))
       continue;
 
+    const uint64_t start = MonotonicClockUS();
     OnAdvance(trace,
                fix.location, fixed(30), Angle::Zero(),
                fix.gps_altitude, fix.pressure_altitude,
                fixed(fix.time.GetSecondOfDay()));
+    duration += MonotonicClockUS() - start;
   }
   putchar('\n');
   printf("# samples %d\n", i);
+  printf("# time %u ms, %.2f us per sample\n",
+         (unsigned)(duration / 1000), i > 0 ? (double)duration / i : 0.);
   return true;
 }
 
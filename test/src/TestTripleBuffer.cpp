@@ -0,0 +1,58 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thread/TripleBuffer.hpp"
+#include "TestUtil.hpp"
+
+int main(int argc, char **argv)
+{
+  plan_tests(12);
+
+  TripleBuffer<unsigned> buffer;
+  ok1(!buffer.Consume());
+
+  buffer.Publish(1);
+  ok1(buffer.Consume());
+  ok1(buffer.GetFront() == 1);
+
+  /* nothing new was published */
+  ok1(!buffer.Consume());
+  ok1(buffer.GetFront() == 1);
+
+  /* the consumer only sees the most recent snapshot */
+  buffer.Publish(2);
+  buffer.Publish(3);
+  buffer.Publish(4);
+  ok1(buffer.Consume());
+  ok1(buffer.GetFront() == 4);
+  ok1(!buffer.Consume());
+
+  /* publishing does not disturb the consumer's buffer */
+  buffer.GetBack() = 5;
+  ok1(buffer.GetFront() == 4);
+  buffer.Publish();
+  ok1(buffer.GetFront() == 4);
+  ok1(buffer.Consume());
+  ok1(buffer.GetFront() == 5);
+
+  return exit_status();
+}
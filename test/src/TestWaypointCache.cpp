@@ -0,0 +1,121 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Waypoint/WaypointCache.hpp"
+#include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/Waypoints.hpp"
+#include "Operation/Operation.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <vector>
+
+static bool
+Equals(const Waypoint &a, const Waypoint &b)
+{
+  return a.original_id == b.original_id && a.location == b.location &&
+    a.elevation == b.elevation && a.type == b.type &&
+    a.flags.turn_point == b.flags.turn_point &&
+    a.flags.home == b.flags.home &&
+    a.flags.start_point == b.flags.start_point &&
+    a.flags.finish_point == b.flags.finish_point &&
+    a.file_num == b.file_num &&
+    a.runway.IsDirectionDefined() == b.runway.IsDirectionDefined() &&
+    (!a.runway.IsDirectionDefined() ||
+     a.runway.GetDirectionDegrees() == b.runway.GetDirectionDegrees()) &&
+    a.runway.IsLengthDefined() == b.runway.IsLengthDefined() &&
+    (!a.runway.IsLengthDefined() ||
+     a.runway.GetLength() == b.runway.GetLength()) &&
+    a.radio_frequency.IsDefined() == b.radio_frequency.IsDefined() &&
+    (!a.radio_frequency.IsDefined() ||
+     a.radio_frequency.GetKiloHertz() == b.radio_frequency.GetKiloHertz()) &&
+    a.name == b.name && a.comment == b.comment && a.details == b.details &&
+    a.files_embed == b.files_embed;
+}
+
+static bool
+CompareId(const Waypoint *a, const Waypoint *b)
+{
+  return a->id < b->id;
+}
+
+static std::vector<const Waypoint *>
+GetSorted(const Waypoints &way_points)
+{
+  std::vector<const Waypoint *> list;
+  for (auto i = way_points.begin(), end = way_points.end(); i != end; ++i)
+    list.push_back(&*i);
+
+  std::sort(list.begin(), list.end(), CompareId);
+  return list;
+}
+
+static void
+TestCache(const TCHAR *path)
+{
+  Waypoints parsed;
+  WaypointReader reader(path, 1);
+  NullOperationEnvironment operation;
+  if (!ok1(!reader.Error() && reader.Parse(parsed, operation))) {
+    skip(5, 0, "Failed to parse input file");
+    return;
+  }
+
+  FILE *file = tmpfile();
+  ok1(WaypointCache::Save(file, path, 42, parsed, 1));
+
+  /* load it back */
+  rewind(file);
+  Waypoints loaded;
+  ok1(WaypointCache::Load(file, path, 42, loaded));
+  loaded.Optimise();
+
+  const std::vector<const Waypoint *> a = GetSorted(parsed),
+    b = GetSorted(loaded);
+  bool equal = a.size() == b.size() && !a.empty();
+  for (unsigned i = 0; equal && i < a.size(); ++i)
+    equal = a[i]->id == b[i]->id && Equals(*a[i], *b[i]);
+  ok1(equal);
+
+  /* a different file or terrain */
+  rewind(file);
+  Waypoints other;
+  ok1(!WaypointCache::Load(file, _T("foo.cup"), 42, other) &&
+      other.IsEmpty());
+
+  rewind(file);
+  ok1(!WaypointCache::Load(file, path, 0, other) && other.IsEmpty());
+
+  fclose(file);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(18);
+
+  TestCache(_T("test/data/waypoints.cup"));
+  TestCache(_T("test/data/waypoints.dat"));
+  TestCache(_T("test/data/waypoints_ozi.wpt"));
+
+  return exit_status();
+}
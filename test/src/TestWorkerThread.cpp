@@ -0,0 +1,87 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2012 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thread/WorkerThread.hpp"
+#include "OS/Clock.hpp"
+#include "OS/Sleep.h"
+#include "TestUtil.hpp"
+
+#include <atomic>
+
+class CountingThread : public WorkerThread {
+public:
+  std::atomic<unsigned> n_ticks;
+
+  CountingThread(unsigned period_min)
+    :WorkerThread(period_min), n_ticks(0) {}
+
+protected:
+  virtual void Tick() {
+    ++n_ticks;
+  }
+};
+
+/**
+ * Trigger the thread continuously for the specified duration, and
+ * return the number of Tick() calls.
+ */
+static unsigned
+CountTicks(CountingThread &thread, unsigned duration)
+{
+  /* let the previous iteration finish */
+  Sleep(150);
+
+  const unsigned before = thread.n_ticks;
+  const unsigned start = MonotonicClockMS();
+  while (MonotonicClockMS() - start < duration) {
+    thread.Trigger();
+    Sleep(1);
+  }
+
+  return thread.n_ticks - before;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(4);
+
+  CountingThread thread(100);
+  ok1(thread.Start());
+
+  /* rate limited to one Tick() per 100 ms */
+  const unsigned throttled = CountTicks(thread, 500);
+  ok1(throttled >= 3 && throttled <= 7);
+
+  /* as fast as it gets triggered */
+  thread.SetThrottle(false);
+  const unsigned unthrottled = CountTicks(thread, 500);
+  ok1(unthrottled > 50);
+
+  thread.SetThrottle(true);
+  const unsigned throttled_again = CountTicks(thread, 500);
+  ok1(throttled_again <= 7);
+
+  thread.BeginStop();
+  thread.Join();
+
+  return exit_status();
+}
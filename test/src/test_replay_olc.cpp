@@ -6,6 +6,7 @@
 #include "Engine/Contest/ContestManager.hpp"
 #include "ComputerSettings.hpp"
 #include "OS/PathName.hpp"
+#include "OS/Clock.hpp"
 
 #include <fstream>
 
@@ -185,6 +186,8 @@ test_replay(const Contests olc_type,
                                  trace_computer.GetSprint());
   contest_manager.SetHandicap(settings_computer.task.contest_handicap);
 
+  uint64_t trace_duration = 0, contest_duration = 0;
+
   while (sim.Update()) {
     if (sim.state.time>time_last) {
 
@@ -192,9 +195,14 @@ test_replay(const Contests olc_type,
 
       flying_computer.Compute(glide_polar.GetVTakeoff(), sim.state, sim.state);
 
+      const uint64_t start = MonotonicClockUS();
       trace_computer.Update(settings_computer, sim.state);
 
+      const uint64_t trace_done = MonotonicClockUS();
       contest_manager.UpdateIdle();
+
+      trace_duration += trace_done - start;
+      contest_duration += MonotonicClockUS() - trace_done;
   
       state_last = sim.state;
 
@@ -211,7 +219,13 @@ test_replay(const Contests olc_type,
   };
   sim.Stop();
 
+  const uint64_t start = MonotonicClockUS();
   contest_manager.SolveExhaustive();
+  const uint64_t solve_duration = MonotonicClockUS() - start;
+
+  std::cout << "# time: trace " << trace_duration / 1000
+            << " ms, contest " << contest_duration / 1000
+            << " ms, final solve " << solve_duration / 1000 << " ms\n";
 
   if (verbose) {
     distance_counts();